@@ -1,6 +1,7 @@
 #include <rtgui/rtgui.h>
 #include <rtgui/rtgui_system.h>
 #include <rtgui/rtgui_application.h>
+#include <rtgui/driver.h>
 
 #include <rtgui/widgets/window.h>
 #include <rtgui/widgets/notebook.h>
@@ -291,6 +291,9 @@ void  zcfree (voidpf opaque, voidpf ptr)
 
 #ifndef MY_ZCALLOC /* Any system without a special alloc function */
 
+/* declare the allocator, an implicit one truncates pointer on 64 bits host */
+#include <rtthread.h>
+
 #ifdef RT_USING_RTGUI
 extern voidp  rtgui_malloc OF((uInt size));
 extern voidp  rtgui_calloc OF((uInt items, uInt size));
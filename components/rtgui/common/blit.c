@@ -1,10 +1,32 @@
 #include <rtgui/rtgui.h>
+#include <rtgui/color.h>
 #include <rtgui/blit.h>
 
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+#if defined(__ARM_NEON__) || defined(__ARM_NEON)
+#include <arm_neon.h>
+#endif
+
+/*
+ * The converters in byte per pixel, the line is the bytes of source line.
+ * 1 byte is RRRGGGBB, 2 bytes is RRRRRGGGGGGBBBBB, 3 bytes is R, G, B and
+ * 4 bytes is R, G, B, A in memory, except 3 to 2 takes B, G, R of bitmap.
+ */
+
 /* 2 bpp to 1 bpp */
 static void rtgui_blit_line_2_1(rt_uint8_t* dst_ptr, rt_uint8_t* src_ptr, int line)
 {
-	return;
+	rt_uint16_t* src;
+
+	src = (rt_uint16_t*)src_ptr;
+	line = line / 2;
+	while (line-- > 0)
+	{
+		*dst_ptr++ = ((*src >> 8) & 0xe0) | ((*src >> 6) & 0x1c) | ((*src >> 3) & 0x03);
+		src ++;
+	}
 }
 
 /* 3 bpp to 1 bpp */
@@ -13,9 +35,9 @@ static void rtgui_blit_line_3_1(rt_uint8_t* dst_ptr, rt_uint8_t* src_ptr, int li
 	line = line / 3;
 	while (line)
 	{
-		*dst_ptr = (rt_uint8_t)(((*src_ptr & 0x00E00000)>>16)|
-			((*(src_ptr + 1) & 0x0000E000)>>11) |
-			((*(src_ptr + 2) & 0x000000C0)>>6));
+		*dst_ptr = (rt_uint8_t)((*src_ptr & 0xe0) |
+			((*(src_ptr + 1) & 0xe0) >> 3) |
+			(*(src_ptr + 2) >> 6));
 
 		src_ptr += 3;
 		dst_ptr ++;
@@ -30,9 +52,10 @@ static void rtgui_blit_line_4_1(rt_uint8_t* dst_ptr, rt_uint8_t* src_ptr, int li
 	struct _color {rt_uint8_t r, g, b, a;} *c;
 
 	c = (struct _color*)src_ptr;
+	line = line / 4;
 	while (line-- > 0)
 	{
-		*dst_ptr = (c->r & 0xe0) | (c->g & 0xc0) >> 3 | (c->b & 0xe0) >> 5 ;
+		*dst_ptr = (c->r & 0xe0) | (c->g & 0xe0) >> 3 | c->b >> 6;
 
 		c ++;
 		dst_ptr ++;
@@ -42,7 +65,14 @@ static void rtgui_blit_line_4_1(rt_uint8_t* dst_ptr, rt_uint8_t* src_ptr, int li
 /* 1 bpp to 2 bpp */
 static void rtgui_blit_line_1_2(rt_uint8_t* dst_ptr, rt_uint8_t* src_ptr, int line)
 {
-	return;
+	rt_uint16_t* dst;
+
+	dst = (rt_uint16_t*)dst_ptr;
+	while (line-- > 0)
+	{
+		*dst++ = ((*src_ptr & 0xe0) << 8) | ((*src_ptr & 0x1c) << 6) | ((*src_ptr & 0x03) << 3);
+		src_ptr ++;
+	}
 }
 
 /* 3 bpp to 2 bpp */
@@ -54,9 +84,9 @@ static void rtgui_blit_line_3_2(rt_uint8_t* dst_ptr, rt_uint8_t* src_ptr, int li
 	line = line / 3;
 	while (line)
 	{
-		*dst = (((*(src_ptr + 2) << 8) & 0x0000F800) | 
-			((*(src_ptr + 1) << 3) & 0x000007E0)     | 
-			((*src_ptr >> 3) & 0x0000001F)); 
+		*dst = (((*(src_ptr + 2) << 8) & 0x0000F800) |
+			((*(src_ptr + 1) << 3) & 0x000007E0)     |
+			((*src_ptr >> 3) & 0x0000001F));
 
 		src_ptr += 3;
 		dst ++;
@@ -85,161 +115,32 @@ static void rtgui_blit_line_4_2(rt_uint8_t* dst_ptr, rt_uint8_t* src_ptr, int li
 	}
 }
 
+/* 1 bpp to 3 bpp */
 static void rtgui_blit_line_1_3(rt_uint8_t* dst_ptr, rt_uint8_t* src_ptr, int line)
 {
-	return;
+	while (line-- > 0)
+	{
+		*dst_ptr++ = *src_ptr & 0xe0;
+		*dst_ptr++ = (*src_ptr << 3) & 0xe0;
+		*dst_ptr++ = (*src_ptr << 6) & 0xc0;
+		src_ptr ++;
+	}
 }
 
-#define HI	1
-#define LO	0
-
-/* Special optimized blit for RGB 5-6-5 --> RGBA 8-8-8-8 */
-static const rt_uint32_t RGB565_RGBA8888_LUT[512] =
-{
-	0x000000ff, 0x00000000, 0x000008ff, 0x00200000,
-	0x000010ff, 0x00400000, 0x000018ff, 0x00610000,
-	0x000020ff, 0x00810000, 0x000029ff, 0x00a10000,
-	0x000031ff, 0x00c20000, 0x000039ff, 0x00e20000,
-	0x000041ff, 0x08000000, 0x00004aff, 0x08200000,
-	0x000052ff, 0x08400000, 0x00005aff, 0x08610000,
-	0x000062ff, 0x08810000, 0x00006aff, 0x08a10000,
-	0x000073ff, 0x08c20000, 0x00007bff, 0x08e20000,
-	0x000083ff, 0x10000000, 0x00008bff, 0x10200000,
-	0x000094ff, 0x10400000, 0x00009cff, 0x10610000,
-	0x0000a4ff, 0x10810000, 0x0000acff, 0x10a10000,
-	0x0000b4ff, 0x10c20000, 0x0000bdff, 0x10e20000,
-	0x0000c5ff, 0x18000000, 0x0000cdff, 0x18200000,
-	0x0000d5ff, 0x18400000, 0x0000deff, 0x18610000,
-	0x0000e6ff, 0x18810000, 0x0000eeff, 0x18a10000,
-	0x0000f6ff, 0x18c20000, 0x0000ffff, 0x18e20000,
-	0x000400ff, 0x20000000, 0x000408ff, 0x20200000,
-	0x000410ff, 0x20400000, 0x000418ff, 0x20610000,
-	0x000420ff, 0x20810000, 0x000429ff, 0x20a10000,
-	0x000431ff, 0x20c20000, 0x000439ff, 0x20e20000,
-	0x000441ff, 0x29000000, 0x00044aff, 0x29200000,
-	0x000452ff, 0x29400000, 0x00045aff, 0x29610000,
-	0x000462ff, 0x29810000, 0x00046aff, 0x29a10000,
-	0x000473ff, 0x29c20000, 0x00047bff, 0x29e20000,
-	0x000483ff, 0x31000000, 0x00048bff, 0x31200000,
-	0x000494ff, 0x31400000, 0x00049cff, 0x31610000,
-	0x0004a4ff, 0x31810000, 0x0004acff, 0x31a10000,
-	0x0004b4ff, 0x31c20000, 0x0004bdff, 0x31e20000,
-	0x0004c5ff, 0x39000000, 0x0004cdff, 0x39200000,
-	0x0004d5ff, 0x39400000, 0x0004deff, 0x39610000,
-	0x0004e6ff, 0x39810000, 0x0004eeff, 0x39a10000,
-	0x0004f6ff, 0x39c20000, 0x0004ffff, 0x39e20000,
-	0x000800ff, 0x41000000, 0x000808ff, 0x41200000,
-	0x000810ff, 0x41400000, 0x000818ff, 0x41610000,
-	0x000820ff, 0x41810000, 0x000829ff, 0x41a10000,
-	0x000831ff, 0x41c20000, 0x000839ff, 0x41e20000,
-	0x000841ff, 0x4a000000, 0x00084aff, 0x4a200000,
-	0x000852ff, 0x4a400000, 0x00085aff, 0x4a610000,
-	0x000862ff, 0x4a810000, 0x00086aff, 0x4aa10000,
-	0x000873ff, 0x4ac20000, 0x00087bff, 0x4ae20000,
-	0x000883ff, 0x52000000, 0x00088bff, 0x52200000,
-	0x000894ff, 0x52400000, 0x00089cff, 0x52610000,
-	0x0008a4ff, 0x52810000, 0x0008acff, 0x52a10000,
-	0x0008b4ff, 0x52c20000, 0x0008bdff, 0x52e20000,
-	0x0008c5ff, 0x5a000000, 0x0008cdff, 0x5a200000,
-	0x0008d5ff, 0x5a400000, 0x0008deff, 0x5a610000,
-	0x0008e6ff, 0x5a810000, 0x0008eeff, 0x5aa10000,
-	0x0008f6ff, 0x5ac20000, 0x0008ffff, 0x5ae20000,
-	0x000c00ff, 0x62000000, 0x000c08ff, 0x62200000,
-	0x000c10ff, 0x62400000, 0x000c18ff, 0x62610000,
-	0x000c20ff, 0x62810000, 0x000c29ff, 0x62a10000,
-	0x000c31ff, 0x62c20000, 0x000c39ff, 0x62e20000,
-	0x000c41ff, 0x6a000000, 0x000c4aff, 0x6a200000,
-	0x000c52ff, 0x6a400000, 0x000c5aff, 0x6a610000,
-	0x000c62ff, 0x6a810000, 0x000c6aff, 0x6aa10000,
-	0x000c73ff, 0x6ac20000, 0x000c7bff, 0x6ae20000,
-	0x000c83ff, 0x73000000, 0x000c8bff, 0x73200000,
-	0x000c94ff, 0x73400000, 0x000c9cff, 0x73610000,
-	0x000ca4ff, 0x73810000, 0x000cacff, 0x73a10000,
-	0x000cb4ff, 0x73c20000, 0x000cbdff, 0x73e20000,
-	0x000cc5ff, 0x7b000000, 0x000ccdff, 0x7b200000,
-	0x000cd5ff, 0x7b400000, 0x000cdeff, 0x7b610000,
-	0x000ce6ff, 0x7b810000, 0x000ceeff, 0x7ba10000,
-	0x000cf6ff, 0x7bc20000, 0x000cffff, 0x7be20000,
-	0x001000ff, 0x83000000, 0x001008ff, 0x83200000,
-	0x001010ff, 0x83400000, 0x001018ff, 0x83610000,
-	0x001020ff, 0x83810000, 0x001029ff, 0x83a10000,
-	0x001031ff, 0x83c20000, 0x001039ff, 0x83e20000,
-	0x001041ff, 0x8b000000, 0x00104aff, 0x8b200000,
-	0x001052ff, 0x8b400000, 0x00105aff, 0x8b610000,
-	0x001062ff, 0x8b810000, 0x00106aff, 0x8ba10000,
-	0x001073ff, 0x8bc20000, 0x00107bff, 0x8be20000,
-	0x001083ff, 0x94000000, 0x00108bff, 0x94200000,
-	0x001094ff, 0x94400000, 0x00109cff, 0x94610000,
-	0x0010a4ff, 0x94810000, 0x0010acff, 0x94a10000,
-	0x0010b4ff, 0x94c20000, 0x0010bdff, 0x94e20000,
-	0x0010c5ff, 0x9c000000, 0x0010cdff, 0x9c200000,
-	0x0010d5ff, 0x9c400000, 0x0010deff, 0x9c610000,
-	0x0010e6ff, 0x9c810000, 0x0010eeff, 0x9ca10000,
-	0x0010f6ff, 0x9cc20000, 0x0010ffff, 0x9ce20000,
-	0x001400ff, 0xa4000000, 0x001408ff, 0xa4200000,
-	0x001410ff, 0xa4400000, 0x001418ff, 0xa4610000,
-	0x001420ff, 0xa4810000, 0x001429ff, 0xa4a10000,
-	0x001431ff, 0xa4c20000, 0x001439ff, 0xa4e20000,
-	0x001441ff, 0xac000000, 0x00144aff, 0xac200000,
-	0x001452ff, 0xac400000, 0x00145aff, 0xac610000,
-	0x001462ff, 0xac810000, 0x00146aff, 0xaca10000,
-	0x001473ff, 0xacc20000, 0x00147bff, 0xace20000,
-	0x001483ff, 0xb4000000, 0x00148bff, 0xb4200000,
-	0x001494ff, 0xb4400000, 0x00149cff, 0xb4610000,
-	0x0014a4ff, 0xb4810000, 0x0014acff, 0xb4a10000,
-	0x0014b4ff, 0xb4c20000, 0x0014bdff, 0xb4e20000,
-	0x0014c5ff, 0xbd000000, 0x0014cdff, 0xbd200000,
-	0x0014d5ff, 0xbd400000, 0x0014deff, 0xbd610000,
-	0x0014e6ff, 0xbd810000, 0x0014eeff, 0xbda10000,
-	0x0014f6ff, 0xbdc20000, 0x0014ffff, 0xbde20000,
-	0x001800ff, 0xc5000000, 0x001808ff, 0xc5200000,
-	0x001810ff, 0xc5400000, 0x001818ff, 0xc5610000,
-	0x001820ff, 0xc5810000, 0x001829ff, 0xc5a10000,
-	0x001831ff, 0xc5c20000, 0x001839ff, 0xc5e20000,
-	0x001841ff, 0xcd000000, 0x00184aff, 0xcd200000,
-	0x001852ff, 0xcd400000, 0x00185aff, 0xcd610000,
-	0x001862ff, 0xcd810000, 0x00186aff, 0xcda10000,
-	0x001873ff, 0xcdc20000, 0x00187bff, 0xcde20000,
-	0x001883ff, 0xd5000000, 0x00188bff, 0xd5200000,
-	0x001894ff, 0xd5400000, 0x00189cff, 0xd5610000,
-	0x0018a4ff, 0xd5810000, 0x0018acff, 0xd5a10000,
-	0x0018b4ff, 0xd5c20000, 0x0018bdff, 0xd5e20000,
-	0x0018c5ff, 0xde000000, 0x0018cdff, 0xde200000,
-	0x0018d5ff, 0xde400000, 0x0018deff, 0xde610000,
-	0x0018e6ff, 0xde810000, 0x0018eeff, 0xdea10000,
-	0x0018f6ff, 0xdec20000, 0x0018ffff, 0xdee20000,
-	0x001c00ff, 0xe6000000, 0x001c08ff, 0xe6200000,
-	0x001c10ff, 0xe6400000, 0x001c18ff, 0xe6610000,
-	0x001c20ff, 0xe6810000, 0x001c29ff, 0xe6a10000,
-	0x001c31ff, 0xe6c20000, 0x001c39ff, 0xe6e20000,
-	0x001c41ff, 0xee000000, 0x001c4aff, 0xee200000,
-	0x001c52ff, 0xee400000, 0x001c5aff, 0xee610000,
-	0x001c62ff, 0xee810000, 0x001c6aff, 0xeea10000,
-	0x001c73ff, 0xeec20000, 0x001c7bff, 0xeee20000,
-	0x001c83ff, 0xf6000000, 0x001c8bff, 0xf6200000,
-	0x001c94ff, 0xf6400000, 0x001c9cff, 0xf6610000,
-	0x001ca4ff, 0xf6810000, 0x001cacff, 0xf6a10000,
-	0x001cb4ff, 0xf6c20000, 0x001cbdff, 0xf6e20000,
-	0x001cc5ff, 0xff000000, 0x001ccdff, 0xff200000,
-	0x001cd5ff, 0xff400000, 0x001cdeff, 0xff610000,
-	0x001ce6ff, 0xff810000, 0x001ceeff, 0xffa10000,
-	0x001cf6ff, 0xffc20000, 0x001cffff, 0xffe20000,
-};
-
+/* 2 bpp to 3 bpp */
 static void rtgui_blit_line_2_3(rt_uint8_t* dst_ptr, rt_uint8_t* src_ptr, int line)
 {
 	rt_uint16_t *src;
-	rt_uint32_t *dst;
+	rtgui_color_t color;
 
 	src = (rt_uint16_t*)src_ptr;
-	dst = (rt_uint32_t*)dst_ptr;
-
 	line = line / 2;
-	while (line)
+	while (line-- > 0)
 	{
-		*dst++ = RGB565_RGBA8888_LUT[src[LO]*2] + RGB565_RGBA8888_LUT[src[HI]*2+1];
-		line--;
-		src ++;
+		color = rtgui_color_from_565p(*src++);
+		*dst_ptr++ = RTGUI_RGB_R(color);
+		*dst_ptr++ = RTGUI_RGB_G(color);
+		*dst_ptr++ = RTGUI_RGB_B(color);
 	}
 }
 
@@ -262,18 +163,36 @@ static void rtgui_blit_line_4_3(rt_uint8_t* dst_ptr, rt_uint8_t* src_ptr, int li
 	}
 }
 
+/* 1 bpp to 4 bpp */
 static void rtgui_blit_line_1_4(rt_uint8_t* dst_ptr, rt_uint8_t* src_ptr, int line)
 {
+	while (line-- > 0)
+	{
+		*dst_ptr++ = *src_ptr & 0xe0;
+		*dst_ptr++ = (*src_ptr << 3) & 0xe0;
+		*dst_ptr++ = (*src_ptr << 6) & 0xc0;
+		*dst_ptr++ = 0;
+		src_ptr ++;
+	}
 }
 
+/* 2 bpp to 4 bpp */
 static void rtgui_blit_line_2_4(rt_uint8_t* dst_ptr, rt_uint8_t* src_ptr, int line)
 {
+	rt_uint16_t *src;
+	rtgui_color_t *dst;
+
+	src = (rt_uint16_t*)src_ptr;
+	dst = (rtgui_color_t*)dst_ptr;
+	line = line / 2;
+	while (line-- > 0)
+		*dst++ = rtgui_color_from_565p(*src++);
 }
 
 /* convert 3bpp to 4bpp */
 static void rtgui_blit_line_3_4(rt_uint8_t* dst_ptr, rt_uint8_t* src_ptr, int line)
 {
-	line = line / 4;
+	line = line / 3;
 	while (line)
 	{
 		*dst_ptr++ = *src_ptr++;
@@ -284,18 +203,18 @@ static void rtgui_blit_line_3_4(rt_uint8_t* dst_ptr, rt_uint8_t* src_ptr, int li
 	}
 }
 
-static const rtgui_blit_line_func _blit_table[5][5] = 
+static const rtgui_blit_line_func _blit_table[5][5] =
 {
 	/* 0_0, 1_0, 2_0, 3_0, 4_0 */
-	{RT_NULL, RT_NULL, RT_NULL, RT_NULL, RT_NULL }, 
+	{RT_NULL, RT_NULL, RT_NULL, RT_NULL, RT_NULL },
 	/* 0_1, 1_1, 2_1, 3_1, 4_1 */
-	{RT_NULL, rtgui_blit_line_direct, rtgui_blit_line_2_1, rtgui_blit_line_3_1, rtgui_blit_line_4_1 }, 
+	{RT_NULL, rtgui_blit_line_direct, rtgui_blit_line_2_1, rtgui_blit_line_3_1, rtgui_blit_line_4_1 },
 	/* 0_2, 1_2, 2_2, 3_2, 4_2 */
-	{RT_NULL, rtgui_blit_line_1_2, rtgui_blit_line_direct, rtgui_blit_line_3_2, rtgui_blit_line_4_2 }, 
+	{RT_NULL, rtgui_blit_line_1_2, rtgui_blit_line_direct, rtgui_blit_line_3_2, rtgui_blit_line_4_2 },
 	/* 0_3, 1_3, 2_3, 3_3, 4_3 */
-	{RT_NULL, rtgui_blit_line_1_3, rtgui_blit_line_2_3, rtgui_blit_line_direct, rtgui_blit_line_4_3 }, 
+	{RT_NULL, rtgui_blit_line_1_3, rtgui_blit_line_2_3, rtgui_blit_line_direct, rtgui_blit_line_4_3 },
 	/* 0_4, 1_4, 2_4, 3_4, 4_4 */
-	{RT_NULL, rtgui_blit_line_1_4, rtgui_blit_line_2_4, rtgui_blit_line_3_4, rtgui_blit_line_direct }, 
+	{RT_NULL, rtgui_blit_line_1_4, rtgui_blit_line_2_4, rtgui_blit_line_3_4, rtgui_blit_line_direct },
 };
 
 rtgui_blit_line_func rtgui_blit_line_get(int dst_bpp, int src_bpp)
@@ -305,3 +224,1110 @@ rtgui_blit_line_func rtgui_blit_line_get(int dst_bpp, int src_bpp)
 
 	return _blit_table[dst_bpp][src_bpp];
 }
+
+/*
+ * The converters between pixel formats, the line is the count of pixels. The
+ * lines are in the layout of the raw line of framebuffer: MONO has one bit
+ * per pixel and the left one is the least significant bit, GRAY4 and GRAY16
+ * are packed and the left one is in the most significant bits, RGB565 and
+ * RGB565P are in rtgui_color_to_565 and rtgui_color_to_565p, RGB888 is
+ * R, G, B in memory and ARGB888 is rtgui_color_t. The colors converted from
+ * the other formats are opaque, their alpha byte is 0.
+ */
+#define BLIT_KEY(c)		(RTGUI_RGB_A(c) == 255)
+#define BLIT_OPAQUE(c)	((c) & 0x00ffffff)
+
+static void _blit_argb_to_mono(rt_uint8_t *dst, rt_uint8_t *src, int line)
+{
+	rtgui_color_t *c = (rtgui_color_t*)src;
+	rt_uint8_t value;
+	int bit;
+
+	while (line > 0)
+	{
+		/* white is cleared as the mono framebuffer does */
+		value = 0;
+		for (bit = 0; bit < 8 && line > 0; bit ++, line --, c ++)
+		{
+			if (BLIT_OPAQUE(*c) != 0x00ffffff) value |= 1 << bit;
+		}
+		*dst++ = value;
+	}
+}
+
+static void _blit_mono_to_argb(rt_uint8_t *dst, rt_uint8_t *src, int line)
+{
+	rtgui_color_t *c = (rtgui_color_t*)dst;
+	int bit;
+
+	for (bit = 0; line > 0; line --, c ++)
+	{
+		*c = (*src & (1 << bit))? 0x00000000 : 0x00ffffff;
+		if (++bit == 8)
+		{
+			bit = 0;
+			src ++;
+		}
+	}
+}
+
+rt_inline void _blit_argb_to_gray(rt_uint8_t *dst, rt_uint8_t *src, int line, int bpp)
+{
+	rtgui_color_t *c = (rtgui_color_t*)src;
+	rt_uint8_t value;
+	int shift;
+
+	while (line > 0)
+	{
+		value = 0;
+		for (shift = 8 - bpp; shift >= 0 && line > 0; shift -= bpp, line --, c ++)
+			value |= (rtgui_color_to_gray(*c) >> (8 - bpp)) << shift;
+		*dst++ = value;
+	}
+}
+
+rt_inline void _blit_gray_to_argb(rt_uint8_t *dst, rt_uint8_t *src, int line, int bpp)
+{
+	rtgui_color_t *c = (rtgui_color_t*)dst;
+	int shift, mask;
+
+	mask = (1 << bpp) - 1;
+	for (shift = 8 - bpp; line > 0; line --, c ++)
+	{
+		*c = BLIT_OPAQUE(rtgui_color_from_gray(((*src >> shift) & mask) * 255 / mask));
+		shift -= bpp;
+		if (shift < 0)
+		{
+			shift = 8 - bpp;
+			src ++;
+		}
+	}
+}
+
+static void _blit_argb_to_gray4(rt_uint8_t *dst, rt_uint8_t *src, int line)
+{
+	_blit_argb_to_gray(dst, src, line, 2);
+}
+
+static void _blit_gray4_to_argb(rt_uint8_t *dst, rt_uint8_t *src, int line)
+{
+	_blit_gray_to_argb(dst, src, line, 2);
+}
+
+static void _blit_argb_to_gray16(rt_uint8_t *dst, rt_uint8_t *src, int line)
+{
+	_blit_argb_to_gray(dst, src, line, 4);
+}
+
+static void _blit_gray16_to_argb(rt_uint8_t *dst, rt_uint8_t *src, int line)
+{
+	_blit_gray_to_argb(dst, src, line, 4);
+}
+
+static void _blit_argb_to_565(rt_uint8_t *dst, rt_uint8_t *src, int line)
+{
+	rtgui_color_t *c = (rtgui_color_t*)src;
+	rt_uint16_t *ptr = (rt_uint16_t*)dst;
+
+	while (line-- > 0) *ptr++ = rtgui_color_to_565(*c++);
+}
+
+static void _blit_565_to_argb(rt_uint8_t *dst, rt_uint8_t *src, int line)
+{
+	rtgui_color_t *c = (rtgui_color_t*)dst;
+	rt_uint16_t *ptr = (rt_uint16_t*)src;
+
+	while (line-- > 0) *c++ = rtgui_color_from_565(*ptr++);
+}
+
+static void _blit_argb_to_565p(rt_uint8_t *dst, rt_uint8_t *src, int line)
+{
+	rtgui_color_t *c = (rtgui_color_t*)src;
+	rt_uint16_t *ptr = (rt_uint16_t*)dst;
+
+	while (line-- > 0) *ptr++ = rtgui_color_to_565p(*c++);
+}
+
+static void _blit_565p_to_argb(rt_uint8_t *dst, rt_uint8_t *src, int line)
+{
+	rtgui_color_t *c = (rtgui_color_t*)dst;
+	rt_uint16_t *ptr = (rt_uint16_t*)src;
+
+	while (line-- > 0) *c++ = rtgui_color_from_565p(*ptr++);
+}
+
+static void _blit_argb_to_888(rt_uint8_t *dst, rt_uint8_t *src, int line)
+{
+	for (; line > 0; line --, src += 4, dst += 3)
+	{
+		dst[0] = src[0];
+		dst[1] = src[1];
+		dst[2] = src[2];
+	}
+}
+
+static void _blit_888_to_argb(rt_uint8_t *dst, rt_uint8_t *src, int line)
+{
+	rtgui_color_t *c = (rtgui_color_t*)dst;
+
+	for (; line > 0; line --, src += 3)
+		*c++ = src[0] | (src[1] << 8) | (src[2] << 16);
+}
+
+/* the 16 bits formats swap red and blue */
+static void _blit_565_swap(rt_uint8_t *dst, rt_uint8_t *src, int line)
+{
+	rt_uint16_t *s = (rt_uint16_t*)src, *d = (rt_uint16_t*)dst;
+
+	for (; line > 0; line --, s ++)
+		*d++ = (*s >> 11) | (*s & 0x07e0) | (*s << 11);
+}
+
+static void _blit_888_to_565(rt_uint8_t *dst, rt_uint8_t *src, int line)
+{
+	rt_uint16_t *ptr = (rt_uint16_t*)dst;
+
+	for (; line > 0; line --, src += 3)
+		*ptr++ = ((src[2] & 0xf8) << 8) | ((src[1] & 0xfc) << 3) | (src[0] >> 3);
+}
+
+static void _blit_888_to_565p(rt_uint8_t *dst, rt_uint8_t *src, int line)
+{
+	rt_uint16_t *ptr = (rt_uint16_t*)dst;
+
+	for (; line > 0; line --, src += 3)
+		*ptr++ = ((src[0] & 0xf8) << 8) | ((src[1] & 0xfc) << 3) | (src[2] >> 3);
+}
+
+static void _blit_565_to_888(rt_uint8_t *dst, rt_uint8_t *src, int line)
+{
+	rtgui_color_t color;
+	rt_uint16_t *ptr = (rt_uint16_t*)src;
+
+	for (; line > 0; line --, dst += 3)
+	{
+		color = rtgui_color_from_565(*ptr++);
+		dst[0] = RTGUI_RGB_R(color);
+		dst[1] = RTGUI_RGB_G(color);
+		dst[2] = RTGUI_RGB_B(color);
+	}
+}
+
+static void _blit_565p_to_888(rt_uint8_t *dst, rt_uint8_t *src, int line)
+{
+	rtgui_color_t color;
+	rt_uint16_t *ptr = (rt_uint16_t*)src;
+
+	for (; line > 0; line --, dst += 3)
+	{
+		color = rtgui_color_from_565p(*ptr++);
+		dst[0] = RTGUI_RGB_R(color);
+		dst[1] = RTGUI_RGB_G(color);
+		dst[2] = RTGUI_RGB_B(color);
+	}
+}
+
+/* the same format is copied in bytes */
+#define BLIT_COPY(name, bpp)	\
+static void _blit_copy_##name(rt_uint8_t *dst, rt_uint8_t *src, int line) \
+{ \
+	rt_memcpy(dst, src, (line * (bpp) + 7) / 8); \
+}
+
+BLIT_COPY(mono, 1)
+BLIT_COPY(gray4, 2)
+BLIT_COPY(gray16, 4)
+BLIT_COPY(565, 16)
+BLIT_COPY(888, 24)
+BLIT_COPY(argb, 32)
+
+/*
+ * The others are converted through ARGB in pieces on stack, the piece is
+ * a multiple of 8 pixels, so the packed formats keep in byte boundary.
+ */
+#define BLIT_PIECE		64
+
+static void _blit_via_argb(rt_uint8_t *dst, int dst_bpp, rtgui_blit_line_func encode,
+	rt_uint8_t *src, int src_bpp, rtgui_blit_line_func decode, int line)
+{
+	rtgui_color_t piece[BLIT_PIECE];
+	int count;
+
+	for (; line > 0; line -= count)
+	{
+		count = line > BLIT_PIECE? BLIT_PIECE : line;
+		decode((rt_uint8_t*)piece, src, count);
+		encode(dst, (rt_uint8_t*)piece, count);
+
+		src += count * src_bpp / 8;
+		dst += count * dst_bpp / 8;
+	}
+}
+
+#define BLIT_VIA_ARGB(dst_name, dst_bpp, src_name, src_bpp)	\
+static void _blit_##src_name##_to_##dst_name(rt_uint8_t *dst, rt_uint8_t *src, int line) \
+{ \
+	_blit_via_argb(dst, dst_bpp, _blit_argb_to_##dst_name, \
+		src, src_bpp, _blit_##src_name##_to_argb, line); \
+}
+
+BLIT_VIA_ARGB(mono, 1, gray4, 2)
+BLIT_VIA_ARGB(mono, 1, gray16, 4)
+BLIT_VIA_ARGB(mono, 1, 565, 16)
+BLIT_VIA_ARGB(mono, 1, 565p, 16)
+BLIT_VIA_ARGB(mono, 1, 888, 24)
+BLIT_VIA_ARGB(gray4, 2, mono, 1)
+BLIT_VIA_ARGB(gray4, 2, gray16, 4)
+BLIT_VIA_ARGB(gray4, 2, 565, 16)
+BLIT_VIA_ARGB(gray4, 2, 565p, 16)
+BLIT_VIA_ARGB(gray4, 2, 888, 24)
+BLIT_VIA_ARGB(gray16, 4, mono, 1)
+BLIT_VIA_ARGB(gray16, 4, gray4, 2)
+BLIT_VIA_ARGB(gray16, 4, 565, 16)
+BLIT_VIA_ARGB(gray16, 4, 565p, 16)
+BLIT_VIA_ARGB(gray16, 4, 888, 24)
+BLIT_VIA_ARGB(565, 16, mono, 1)
+BLIT_VIA_ARGB(565, 16, gray4, 2)
+BLIT_VIA_ARGB(565, 16, gray16, 4)
+BLIT_VIA_ARGB(565p, 16, mono, 1)
+BLIT_VIA_ARGB(565p, 16, gray4, 2)
+BLIT_VIA_ARGB(565p, 16, gray16, 4)
+BLIT_VIA_ARGB(888, 24, mono, 1)
+BLIT_VIA_ARGB(888, 24, gray4, 2)
+BLIT_VIA_ARGB(888, 24, gray16, 4)
+
+/*
+ * The converters with alpha key skip the transparent pixels of ARGB888 source,
+ * whose alpha byte is 255 as the images decode, and keep the destination.
+ */
+static void _blit_argb_to_mono_key(rt_uint8_t *dst, rt_uint8_t *src, int line)
+{
+	rtgui_color_t *c = (rtgui_color_t*)src;
+	int bit;
+
+	for (bit = 0; line > 0; line --, c ++)
+	{
+		if (!BLIT_KEY(*c))
+		{
+			if (BLIT_OPAQUE(*c) != 0x00ffffff) *dst |= 1 << bit;
+			else *dst &= ~(1 << bit);
+		}
+		if (++bit == 8)
+		{
+			bit = 0;
+			dst ++;
+		}
+	}
+}
+
+rt_inline void _blit_argb_to_gray_key(rt_uint8_t *dst, rt_uint8_t *src, int line, int bpp)
+{
+	rtgui_color_t *c = (rtgui_color_t*)src;
+	int shift, mask;
+
+	mask = (1 << bpp) - 1;
+	for (shift = 8 - bpp; line > 0; line --, c ++)
+	{
+		if (!BLIT_KEY(*c))
+			*dst = (*dst & ~(mask << shift)) | ((rtgui_color_to_gray(*c) >> (8 - bpp)) << shift);
+		shift -= bpp;
+		if (shift < 0)
+		{
+			shift = 8 - bpp;
+			dst ++;
+		}
+	}
+}
+
+static void _blit_argb_to_gray4_key(rt_uint8_t *dst, rt_uint8_t *src, int line)
+{
+	_blit_argb_to_gray_key(dst, src, line, 2);
+}
+
+static void _blit_argb_to_gray16_key(rt_uint8_t *dst, rt_uint8_t *src, int line)
+{
+	_blit_argb_to_gray_key(dst, src, line, 4);
+}
+
+static void _blit_argb_to_565_key(rt_uint8_t *dst, rt_uint8_t *src, int line)
+{
+	rtgui_color_t *c = (rtgui_color_t*)src;
+	rt_uint16_t *ptr = (rt_uint16_t*)dst;
+
+	for (; line > 0; line --, c ++, ptr ++)
+	{
+		if (!BLIT_KEY(*c)) *ptr = rtgui_color_to_565(*c);
+	}
+}
+
+static void _blit_argb_to_565p_key(rt_uint8_t *dst, rt_uint8_t *src, int line)
+{
+	rtgui_color_t *c = (rtgui_color_t*)src;
+	rt_uint16_t *ptr = (rt_uint16_t*)dst;
+
+	for (; line > 0; line --, c ++, ptr ++)
+	{
+		if (!BLIT_KEY(*c)) *ptr = rtgui_color_to_565p(*c);
+	}
+}
+
+static void _blit_argb_to_888_key(rt_uint8_t *dst, rt_uint8_t *src, int line)
+{
+	for (; line > 0; line --, src += 4, dst += 3)
+	{
+		if (BLIT_KEY(*(rtgui_color_t*)src)) continue;
+
+		dst[0] = src[0];
+		dst[1] = src[1];
+		dst[2] = src[2];
+	}
+}
+
+static void _blit_argb_to_argb_key(rt_uint8_t *dst, rt_uint8_t *src, int line)
+{
+	rtgui_color_t *c = (rtgui_color_t*)src;
+	rtgui_color_t *ptr = (rtgui_color_t*)dst;
+
+	for (; line > 0; line --, c ++, ptr ++)
+	{
+		if (!BLIT_KEY(*c)) *ptr = *c;
+	}
+}
+
+/*
+ * The blenders composite the ARGB888 source on the raw line of destination in
+ * place, the alpha byte of source is the opacity. The channels are blended in
+ * 8 bits and x / 255 is rounded exactly by ((x + 128) + ((x + 128) >> 8)) >> 8.
+ * The channels of RGB565 are expanded to 8 bits by replicating the high bits,
+ * so an untouched pixel keeps its value.
+ */
+#define BLEND_SKIP(c, mode)	((mode) != RTGUI_BLENDMODE_MOD && RTGUI_RGB_A(c) == 0)
+
+rt_inline rt_uint32_t _blend_div255(rt_uint32_t x)
+{
+	x += 128;
+	return (x + (x >> 8)) >> 8;
+}
+
+rt_inline rt_uint32_t _blend_channel(rt_uint32_t s, rt_uint32_t d, rt_uint32_t a, int mode)
+{
+	switch (mode)
+	{
+	case RTGUI_BLENDMODE_BLEND:
+		return _blend_div255(s * a + d * (255 - a));
+	case RTGUI_BLENDMODE_ADD:
+		d += _blend_div255(s * a);
+		return d > 255? 255 : d;
+	default:
+		return _blend_div255(s * d);
+	}
+}
+
+rt_inline rtgui_color_t _blend_color(rtgui_color_t s, rtgui_color_t d, int mode)
+{
+	rt_uint32_t a, da;
+
+	a = RTGUI_RGB_A(s);
+	if (mode == RTGUI_BLENDMODE_BLEND && a == 255) return s;
+
+	da = RTGUI_RGB_A(d);
+	if (mode == RTGUI_BLENDMODE_BLEND) da = a + _blend_div255(da * (255 - a));
+
+	return RTGUI_ARGB(da, _blend_channel(RTGUI_RGB_R(s), RTGUI_RGB_R(d), a, mode),
+		_blend_channel(RTGUI_RGB_G(s), RTGUI_RGB_G(d), a, mode),
+		_blend_channel(RTGUI_RGB_B(s), RTGUI_RGB_B(d), a, mode));
+}
+
+/* expand the 565 pixel, red is in the low bits */
+rt_inline rtgui_color_t _blend_from_565(rt_uint16_t pixel, rt_bool_t swap)
+{
+	rt_uint32_t r, g, b;
+
+	r = pixel & 0x1f;
+	g = (pixel >> 5) & 0x3f;
+	b = pixel >> 11;
+	if (swap)
+	{
+		/* RGB565P, red is in the high bits */
+		r = b;
+		b = pixel & 0x1f;
+	}
+
+	return RTGUI_ARGB(0, (r << 3) | (r >> 2), (g << 2) | (g >> 4), (b << 3) | (b >> 2));
+}
+
+rt_inline void _blend_565(rt_uint8_t *dst, rt_uint8_t *src, int line, int mode, rt_bool_t swap)
+{
+	rtgui_color_t *c = (rtgui_color_t*)src;
+	rt_uint16_t *ptr = (rt_uint16_t*)dst;
+	rtgui_color_t color;
+
+	for (; line > 0; line --, c ++, ptr ++)
+	{
+		if (BLEND_SKIP(*c, mode)) continue;
+
+		color = _blend_color(*c, _blend_from_565(*ptr, swap), mode);
+		*ptr = swap? rtgui_color_to_565p(color) : rtgui_color_to_565(color);
+	}
+}
+
+rt_inline void _blend_888(rt_uint8_t *dst, rt_uint8_t *src, int line, int mode)
+{
+	rtgui_color_t color;
+
+	for (; line > 0; line --, src += 4, dst += 3)
+	{
+		color = *(rtgui_color_t*)src;
+		if (BLEND_SKIP(color, mode)) continue;
+
+		color = _blend_color(color, RTGUI_ARGB(0, dst[0], dst[1], dst[2]), mode);
+		dst[0] = RTGUI_RGB_R(color);
+		dst[1] = RTGUI_RGB_G(color);
+		dst[2] = RTGUI_RGB_B(color);
+	}
+}
+
+rt_inline void _blend_argb(rt_uint8_t *dst, rt_uint8_t *src, int line, int mode)
+{
+	rtgui_color_t *c = (rtgui_color_t*)src;
+	rtgui_color_t *ptr = (rtgui_color_t*)dst;
+
+	for (; line > 0; line --, c ++, ptr ++)
+	{
+		if (BLEND_SKIP(*c, mode)) continue;
+
+		*ptr = _blend_color(*c, *ptr, mode);
+	}
+}
+
+#define BLEND_LINE(mode_name, mode)	\
+static void _blend_565_##mode_name(rt_uint8_t *dst, rt_uint8_t *src, int line) \
+{ \
+	_blend_565(dst, src, line, mode, RT_FALSE); \
+} \
+static void _blend_565p_##mode_name(rt_uint8_t *dst, rt_uint8_t *src, int line) \
+{ \
+	_blend_565(dst, src, line, mode, RT_TRUE); \
+} \
+static void _blend_888_##mode_name(rt_uint8_t *dst, rt_uint8_t *src, int line) \
+{ \
+	_blend_888(dst, src, line, mode); \
+} \
+static void _blend_argb_##mode_name(rt_uint8_t *dst, rt_uint8_t *src, int line) \
+{ \
+	_blend_argb(dst, src, line, mode); \
+}
+
+BLEND_LINE(blend,	RTGUI_BLENDMODE_BLEND)
+BLEND_LINE(add,		RTGUI_BLENDMODE_ADD)
+BLEND_LINE(mod,		RTGUI_BLENDMODE_MOD)
+
+#if defined(__SSE2__)
+/*
+ * The SSE2 converters take 8 pixels in each loop and finish the tail by the
+ * C converters. The green of 565 is expanded as g * 4047 / 1024 like
+ * rtgui_color_from_565, it's (g << 10) * 4047 >> 16 >> 4 in 16 bits.
+ */
+rt_inline __m128i _sse2_pack_565(__m128i c, rt_bool_t swap)
+{
+	__m128i r, g, b;
+
+	g = _mm_and_si128(_mm_srli_epi32(c, 5), _mm_set1_epi32(0x07e0));
+	if (swap)
+	{
+		/* RGB565P, red is in the high bits */
+		r = _mm_and_si128(_mm_slli_epi32(c, 8), _mm_set1_epi32(0xf800));
+		b = _mm_and_si128(_mm_srli_epi32(c, 19), _mm_set1_epi32(0x001f));
+	}
+	else
+	{
+		r = _mm_and_si128(_mm_srli_epi32(c, 3), _mm_set1_epi32(0x001f));
+		b = _mm_and_si128(_mm_srli_epi32(c, 8), _mm_set1_epi32(0xf800));
+	}
+	c = _mm_or_si128(_mm_or_si128(r, g), b);
+
+	/* sign extend to keep the 16 bits in the saturated pack */
+	return _mm_srai_epi32(_mm_slli_epi32(c, 16), 16);
+}
+
+rt_inline void _sse2_argb_to_565(rt_uint8_t *dst, rt_uint8_t *src, int line, rt_bool_t swap, rt_bool_t key)
+{
+	__m128i c0, c1, pixel, mask;
+
+	for (; line >= 8; line -= 8, src += 32, dst += 16)
+	{
+		c0 = _mm_loadu_si128((__m128i*)src);
+		c1 = _mm_loadu_si128((__m128i*)(src + 16));
+		pixel = _mm_packs_epi32(_sse2_pack_565(c0, swap), _sse2_pack_565(c1, swap));
+		if (key)
+		{
+			c0 = _mm_cmpeq_epi32(_mm_srli_epi32(c0, 24), _mm_set1_epi32(0xff));
+			c1 = _mm_cmpeq_epi32(_mm_srli_epi32(c1, 24), _mm_set1_epi32(0xff));
+			mask = _mm_packs_epi32(c0, c1);
+			pixel = _mm_or_si128(_mm_and_si128(mask, _mm_loadu_si128((__m128i*)dst)),
+				_mm_andnot_si128(mask, pixel));
+		}
+		_mm_storeu_si128((__m128i*)dst, pixel);
+	}
+
+	if (swap)
+	{
+		if (key) _blit_argb_to_565p_key(dst, src, line);
+		else _blit_argb_to_565p(dst, src, line);
+	}
+	else
+	{
+		if (key) _blit_argb_to_565_key(dst, src, line);
+		else _blit_argb_to_565(dst, src, line);
+	}
+}
+
+rt_inline void _sse2_565_to_argb(rt_uint8_t *dst, rt_uint8_t *src, int line, rt_bool_t swap)
+{
+	__m128i pixel, r, g, b, rg;
+
+	for (; line >= 8; line -= 8, src += 16, dst += 32)
+	{
+		pixel = _mm_loadu_si128((__m128i*)src);
+		if (swap)
+		{
+			r = _mm_and_si128(_mm_srli_epi16(pixel, 8), _mm_set1_epi16(0xf8));
+			b = _mm_and_si128(_mm_slli_epi16(pixel, 3), _mm_set1_epi16(0xf8));
+		}
+		else
+		{
+			r = _mm_and_si128(_mm_slli_epi16(pixel, 3), _mm_set1_epi16(0xf8));
+			b = _mm_and_si128(_mm_srli_epi16(pixel, 8), _mm_set1_epi16(0xf8));
+		}
+		g = _mm_and_si128(_mm_slli_epi16(pixel, 5), _mm_set1_epi16((short)0xfc00));
+		g = _mm_srli_epi16(_mm_mulhi_epu16(g, _mm_set1_epi16(4047)), 4);
+
+		rg = _mm_or_si128(r, _mm_slli_epi16(g, 8));
+		_mm_storeu_si128((__m128i*)dst, _mm_unpacklo_epi16(rg, b));
+		_mm_storeu_si128((__m128i*)(dst + 16), _mm_unpackhi_epi16(rg, b));
+	}
+
+	if (swap) _blit_565p_to_argb(dst, src, line);
+	else _blit_565_to_argb(dst, src, line);
+}
+
+static void _blit_argb_to_565_sse2(rt_uint8_t *dst, rt_uint8_t *src, int line)
+{
+	_sse2_argb_to_565(dst, src, line, RT_FALSE, RT_FALSE);
+}
+
+static void _blit_argb_to_565p_sse2(rt_uint8_t *dst, rt_uint8_t *src, int line)
+{
+	_sse2_argb_to_565(dst, src, line, RT_TRUE, RT_FALSE);
+}
+
+static void _blit_argb_to_565_key_sse2(rt_uint8_t *dst, rt_uint8_t *src, int line)
+{
+	_sse2_argb_to_565(dst, src, line, RT_FALSE, RT_TRUE);
+}
+
+static void _blit_argb_to_565p_key_sse2(rt_uint8_t *dst, rt_uint8_t *src, int line)
+{
+	_sse2_argb_to_565(dst, src, line, RT_TRUE, RT_TRUE);
+}
+
+static void _blit_565_to_argb_sse2(rt_uint8_t *dst, rt_uint8_t *src, int line)
+{
+	_sse2_565_to_argb(dst, src, line, RT_FALSE);
+}
+
+static void _blit_565p_to_argb_sse2(rt_uint8_t *dst, rt_uint8_t *src, int line)
+{
+	_sse2_565_to_argb(dst, src, line, RT_TRUE);
+}
+
+static void _blit_argb_to_argb_key_sse2(rt_uint8_t *dst, rt_uint8_t *src, int line)
+{
+	__m128i c, mask;
+
+	for (; line >= 4; line -= 4, src += 16, dst += 16)
+	{
+		c = _mm_loadu_si128((__m128i*)src);
+		mask = _mm_cmpeq_epi32(_mm_srli_epi32(c, 24), _mm_set1_epi32(0xff));
+		_mm_storeu_si128((__m128i*)dst, _mm_or_si128(_mm_and_si128(mask,
+			_mm_loadu_si128((__m128i*)dst)), _mm_andnot_si128(mask, c)));
+	}
+
+	_blit_argb_to_argb_key(dst, src, line);
+}
+
+/*
+ * The SSE2 blenders work on the channels in 16 bits lanes, x / 255 is rounded
+ * like _blend_div255. The products are 255 * 255 at most, which fit in the
+ * unsigned lanes.
+ */
+rt_inline __m128i _sse2_div255(__m128i x)
+{
+	x = _mm_add_epi16(x, _mm_set1_epi16(128));
+	return _mm_srli_epi16(_mm_add_epi16(x, _mm_srli_epi16(x, 8)), 8);
+}
+
+rt_inline __m128i _sse2_blend(__m128i s, __m128i d, __m128i a, __m128i ia)
+{
+	return _sse2_div255(_mm_add_epi16(_mm_mullo_epi16(s, a), _mm_mullo_epi16(d, ia)));
+}
+
+/* take a channel of 8 ARGB pixels in 16 bits lanes */
+rt_inline __m128i _sse2_channel(__m128i c0, __m128i c1, int shift)
+{
+	__m128i mask = _mm_set1_epi32(0xff);
+
+	return _mm_packs_epi32(_mm_and_si128(_mm_srli_epi32(c0, shift), mask),
+		_mm_and_si128(_mm_srli_epi32(c1, shift), mask));
+}
+
+rt_inline void _sse2_blend_565(rt_uint8_t *dst, rt_uint8_t *src, int line, rt_bool_t swap)
+{
+	__m128i c0, c1, a, ia, pixel, r, g, b, low, high;
+
+	for (; line >= 8; line -= 8, src += 32, dst += 16)
+	{
+		c0 = _mm_loadu_si128((__m128i*)src);
+		c1 = _mm_loadu_si128((__m128i*)(src + 16));
+		a = _sse2_channel(c0, c1, 24);
+		/* all of pixels are transparent */
+		if (_mm_movemask_epi8(_mm_cmpeq_epi16(a, _mm_setzero_si128())) == 0xffff) continue;
+		ia = _mm_sub_epi16(_mm_set1_epi16(255), a);
+
+		pixel = _mm_loadu_si128((__m128i*)dst);
+		low = _mm_and_si128(pixel, _mm_set1_epi16(0x1f));
+		high = _mm_srli_epi16(pixel, 11);
+		g = _mm_and_si128(_mm_srli_epi16(pixel, 5), _mm_set1_epi16(0x3f));
+		low = _mm_or_si128(_mm_slli_epi16(low, 3), _mm_srli_epi16(low, 2));
+		high = _mm_or_si128(_mm_slli_epi16(high, 3), _mm_srli_epi16(high, 2));
+		g = _mm_or_si128(_mm_slli_epi16(g, 2), _mm_srli_epi16(g, 4));
+
+		r = _sse2_blend(_sse2_channel(c0, c1, 0), swap? high : low, a, ia);
+		g = _sse2_blend(_sse2_channel(c0, c1, 8), g, a, ia);
+		b = _sse2_blend(_sse2_channel(c0, c1, 16), swap? low : high, a, ia);
+
+		pixel = _mm_slli_epi16(_mm_srli_epi16(g, 2), 5);
+		if (swap)
+		{
+			pixel = _mm_or_si128(pixel, _mm_slli_epi16(_mm_srli_epi16(r, 3), 11));
+			pixel = _mm_or_si128(pixel, _mm_srli_epi16(b, 3));
+		}
+		else
+		{
+			pixel = _mm_or_si128(pixel, _mm_slli_epi16(_mm_srli_epi16(b, 3), 11));
+			pixel = _mm_or_si128(pixel, _mm_srli_epi16(r, 3));
+		}
+		_mm_storeu_si128((__m128i*)dst, pixel);
+	}
+
+	_blend_565(dst, src, line, RTGUI_BLENDMODE_BLEND, swap);
+}
+
+static void _blend_565_blend_sse2(rt_uint8_t *dst, rt_uint8_t *src, int line)
+{
+	_sse2_blend_565(dst, src, line, RT_FALSE);
+}
+
+static void _blend_565p_blend_sse2(rt_uint8_t *dst, rt_uint8_t *src, int line)
+{
+	_sse2_blend_565(dst, src, line, RT_TRUE);
+}
+
+/* the alpha of source is taken as 255 in its lane, which gives alpha + dstA * (1 - alpha) */
+static void _blend_argb_blend_sse2(rt_uint8_t *dst, rt_uint8_t *src, int line)
+{
+	__m128i c, s, d, a, ia, zero, low, high;
+
+	zero = _mm_setzero_si128();
+	for (; line >= 4; line -= 4, src += 16, dst += 16)
+	{
+		c = _mm_loadu_si128((__m128i*)src);
+		d = _mm_loadu_si128((__m128i*)dst);
+		s = _mm_or_si128(c, _mm_set1_epi32(0xff000000));
+
+		a = _mm_unpacklo_epi8(c, zero);
+		a = _mm_shufflehi_epi16(_mm_shufflelo_epi16(a, 0xff), 0xff);
+		ia = _mm_sub_epi16(_mm_set1_epi16(255), a);
+		low = _sse2_blend(_mm_unpacklo_epi8(s, zero), _mm_unpacklo_epi8(d, zero), a, ia);
+
+		a = _mm_unpackhi_epi8(c, zero);
+		a = _mm_shufflehi_epi16(_mm_shufflelo_epi16(a, 0xff), 0xff);
+		ia = _mm_sub_epi16(_mm_set1_epi16(255), a);
+		high = _sse2_blend(_mm_unpackhi_epi8(s, zero), _mm_unpackhi_epi8(d, zero), a, ia);
+
+		_mm_storeu_si128((__m128i*)dst, _mm_packus_epi16(low, high));
+	}
+
+	_blend_argb(dst, src, line, RTGUI_BLENDMODE_BLEND);
+}
+#endif
+
+#if defined(__ARM_NEON__) || defined(__ARM_NEON)
+/*
+ * The NEON converters take 8 pixels in each loop and finish the tail by the
+ * C converters, the ARGB pixels are de-interleaved to the planes of R, G, B, A.
+ */
+rt_inline uint16x8_t _neon_pack_565(uint8x8x4_t c, rt_bool_t swap)
+{
+	uint16x8_t pixel;
+
+	/* insert the high bits of each plane from the top */
+	pixel = vshll_n_u8(swap? c.val[0] : c.val[2], 8);
+	pixel = vsriq_n_u16(pixel, vshll_n_u8(c.val[1], 8), 5);
+	pixel = vsriq_n_u16(pixel, vshll_n_u8(swap? c.val[2] : c.val[0], 8), 11);
+
+	return pixel;
+}
+
+rt_inline void _neon_argb_to_565(rt_uint8_t *dst, rt_uint8_t *src, int line, rt_bool_t swap, rt_bool_t key)
+{
+	uint8x8x4_t c;
+	uint16x8_t pixel, mask;
+
+	for (; line >= 8; line -= 8, src += 32, dst += 16)
+	{
+		c = vld4_u8(src);
+		pixel = _neon_pack_565(c, swap);
+		if (key)
+		{
+			/* sign extend the byte mask to 16 bits */
+			mask = vreinterpretq_u16_s16(vmovl_s8(vreinterpret_s8_u8(vceq_u8(c.val[3], vdup_n_u8(0xff)))));
+			pixel = vbslq_u16(mask, vld1q_u16((rt_uint16_t*)dst), pixel);
+		}
+		vst1q_u16((rt_uint16_t*)dst, pixel);
+	}
+
+	if (swap)
+	{
+		if (key) _blit_argb_to_565p_key(dst, src, line);
+		else _blit_argb_to_565p(dst, src, line);
+	}
+	else
+	{
+		if (key) _blit_argb_to_565_key(dst, src, line);
+		else _blit_argb_to_565(dst, src, line);
+	}
+}
+
+rt_inline void _neon_565_to_argb(rt_uint8_t *dst, rt_uint8_t *src, int line, rt_bool_t swap)
+{
+	uint16x8_t pixel, g;
+	uint8x8_t high, low;
+	uint8x8x4_t c;
+
+	c.val[3] = vdup_n_u8(0);
+	for (; line >= 8; line -= 8, src += 16, dst += 32)
+	{
+		pixel = vld1q_u16((rt_uint16_t*)src);
+		high = vand_u8(vshrn_n_u16(pixel, 8), vdup_n_u8(0xf8));
+		low = vmovn_u16(vshlq_n_u16(pixel, 3));
+		g = vandq_u16(vshrq_n_u16(pixel, 5), vdupq_n_u16(0x3f));
+		c.val[1] = vmovn_u16(vcombine_u16(vshrn_n_u32(vmull_n_u16(vget_low_u16(g), 4047), 10),
+			vshrn_n_u32(vmull_n_u16(vget_high_u16(g), 4047), 10)));
+		c.val[0] = swap? high : low;
+		c.val[2] = swap? low : high;
+		vst4_u8(dst, c);
+	}
+
+	if (swap) _blit_565p_to_argb(dst, src, line);
+	else _blit_565_to_argb(dst, src, line);
+}
+
+static void _blit_argb_to_565_neon(rt_uint8_t *dst, rt_uint8_t *src, int line)
+{
+	_neon_argb_to_565(dst, src, line, RT_FALSE, RT_FALSE);
+}
+
+static void _blit_argb_to_565p_neon(rt_uint8_t *dst, rt_uint8_t *src, int line)
+{
+	_neon_argb_to_565(dst, src, line, RT_TRUE, RT_FALSE);
+}
+
+static void _blit_argb_to_565_key_neon(rt_uint8_t *dst, rt_uint8_t *src, int line)
+{
+	_neon_argb_to_565(dst, src, line, RT_FALSE, RT_TRUE);
+}
+
+static void _blit_argb_to_565p_key_neon(rt_uint8_t *dst, rt_uint8_t *src, int line)
+{
+	_neon_argb_to_565(dst, src, line, RT_TRUE, RT_TRUE);
+}
+
+static void _blit_565_to_argb_neon(rt_uint8_t *dst, rt_uint8_t *src, int line)
+{
+	_neon_565_to_argb(dst, src, line, RT_FALSE);
+}
+
+static void _blit_565p_to_argb_neon(rt_uint8_t *dst, rt_uint8_t *src, int line)
+{
+	_neon_565_to_argb(dst, src, line, RT_TRUE);
+}
+
+static void _blit_argb_to_888_neon(rt_uint8_t *dst, rt_uint8_t *src, int line)
+{
+	uint8x8x4_t c;
+	uint8x8x3_t pixel;
+
+	for (; line >= 8; line -= 8, src += 32, dst += 24)
+	{
+		c = vld4_u8(src);
+		pixel.val[0] = c.val[0];
+		pixel.val[1] = c.val[1];
+		pixel.val[2] = c.val[2];
+		vst3_u8(dst, pixel);
+	}
+
+	_blit_argb_to_888(dst, src, line);
+}
+
+static void _blit_888_to_argb_neon(rt_uint8_t *dst, rt_uint8_t *src, int line)
+{
+	uint8x8x3_t pixel;
+	uint8x8x4_t c;
+
+	c.val[3] = vdup_n_u8(0);
+	for (; line >= 8; line -= 8, src += 24, dst += 32)
+	{
+		pixel = vld3_u8(src);
+		c.val[0] = pixel.val[0];
+		c.val[1] = pixel.val[1];
+		c.val[2] = pixel.val[2];
+		vst4_u8(dst, c);
+	}
+
+	_blit_888_to_argb(dst, src, line);
+}
+
+static void _blit_argb_to_argb_key_neon(rt_uint8_t *dst, rt_uint8_t *src, int line)
+{
+	uint32x4_t c, mask;
+
+	for (; line >= 4; line -= 4, src += 16, dst += 16)
+	{
+		c = vld1q_u32((rt_uint32_t*)src);
+		mask = vceqq_u32(vshrq_n_u32(c, 24), vdupq_n_u32(0xff));
+		vst1q_u32((rt_uint32_t*)dst, vbslq_u32(mask, vld1q_u32((rt_uint32_t*)dst), c));
+	}
+
+	_blit_argb_to_argb_key(dst, src, line);
+}
+
+/*
+ * The NEON blenders round x / 255 like _blend_div255: vrsraq_n_u16 gives
+ * x + ((x + 128) >> 8) and vrshrn_n_u16 adds 128 before the shift.
+ */
+rt_inline uint8x8_t _neon_blend(uint8x8_t s, uint8x8_t d, uint8x8_t a, uint8x8_t ia)
+{
+	uint16x8_t x;
+
+	x = vmlal_u8(vmull_u8(s, a), d, ia);
+	return vrshrn_n_u16(vrsraq_n_u16(x, x, 8), 8);
+}
+
+/* expand the channel of 5 or 6 bits to 8 bits, the shifts must be constant */
+#define NEON_EXPAND(c, bits)	vorr_u8(vshl_n_u8(c, 8 - (bits)), vshr_n_u8(c, 2 * (bits) - 8))
+
+rt_inline void _neon_blend_565(rt_uint8_t *dst, rt_uint8_t *src, int line, rt_bool_t swap)
+{
+	uint8x8x4_t c, d;
+	uint16x8_t pixel;
+	uint8x8_t ia, low, high;
+
+	for (; line >= 8; line -= 8, src += 32, dst += 16)
+	{
+		c = vld4_u8(src);
+		ia = vmvn_u8(c.val[3]);
+
+		pixel = vld1q_u16((rt_uint16_t*)dst);
+		low = NEON_EXPAND(vand_u8(vmovn_u16(pixel), vdup_n_u8(0x1f)), 5);
+		high = NEON_EXPAND(vshrn_n_u16(pixel, 11), 5);
+		d.val[1] = NEON_EXPAND(vand_u8(vshrn_n_u16(pixel, 5), vdup_n_u8(0x3f)), 6);
+		d.val[0] = swap? high : low;
+		d.val[2] = swap? low : high;
+
+		c.val[0] = _neon_blend(c.val[0], d.val[0], c.val[3], ia);
+		c.val[1] = _neon_blend(c.val[1], d.val[1], c.val[3], ia);
+		c.val[2] = _neon_blend(c.val[2], d.val[2], c.val[3], ia);
+		vst1q_u16((rt_uint16_t*)dst, _neon_pack_565(c, swap));
+	}
+
+	_blend_565(dst, src, line, RTGUI_BLENDMODE_BLEND, swap);
+}
+
+static void _blend_565_blend_neon(rt_uint8_t *dst, rt_uint8_t *src, int line)
+{
+	_neon_blend_565(dst, src, line, RT_FALSE);
+}
+
+static void _blend_565p_blend_neon(rt_uint8_t *dst, rt_uint8_t *src, int line)
+{
+	_neon_blend_565(dst, src, line, RT_TRUE);
+}
+
+static void _blend_argb_blend_neon(rt_uint8_t *dst, rt_uint8_t *src, int line)
+{
+	uint8x8x4_t c, d;
+	uint8x8_t ia;
+
+	for (; line >= 8; line -= 8, src += 32, dst += 32)
+	{
+		c = vld4_u8(src);
+		d = vld4_u8(dst);
+		ia = vmvn_u8(c.val[3]);
+
+		d.val[0] = _neon_blend(c.val[0], d.val[0], c.val[3], ia);
+		d.val[1] = _neon_blend(c.val[1], d.val[1], c.val[3], ia);
+		d.val[2] = _neon_blend(c.val[2], d.val[2], c.val[3], ia);
+		/* alpha + dstA * (1 - alpha) */
+		d.val[3] = _neon_blend(vdup_n_u8(0xff), d.val[3], c.val[3], ia);
+		vst4_u8(dst, d);
+	}
+
+	_blend_argb(dst, src, line, RTGUI_BLENDMODE_BLEND);
+}
+#endif
+
+/* the converters of the vector unit, which replace the C converters */
+static const struct
+{
+	rtgui_blit_line_func func, vector;
+} _blit_vector[] =
+{
+#if defined(__SSE2__)
+	{_blit_argb_to_565,			_blit_argb_to_565_sse2},
+	{_blit_argb_to_565p,		_blit_argb_to_565p_sse2},
+	{_blit_argb_to_565_key,		_blit_argb_to_565_key_sse2},
+	{_blit_argb_to_565p_key,	_blit_argb_to_565p_key_sse2},
+	{_blit_565_to_argb,			_blit_565_to_argb_sse2},
+	{_blit_565p_to_argb,		_blit_565p_to_argb_sse2},
+	{_blit_argb_to_argb_key,	_blit_argb_to_argb_key_sse2},
+	{_blend_565_blend,			_blend_565_blend_sse2},
+	{_blend_565p_blend,			_blend_565p_blend_sse2},
+	{_blend_argb_blend,			_blend_argb_blend_sse2},
+#elif defined(__ARM_NEON__) || defined(__ARM_NEON)
+	{_blit_argb_to_565,			_blit_argb_to_565_neon},
+	{_blit_argb_to_565p,		_blit_argb_to_565p_neon},
+	{_blit_argb_to_565_key,		_blit_argb_to_565_key_neon},
+	{_blit_argb_to_565p_key,	_blit_argb_to_565p_key_neon},
+	{_blit_565_to_argb,			_blit_565_to_argb_neon},
+	{_blit_565p_to_argb,		_blit_565p_to_argb_neon},
+	{_blit_argb_to_888,			_blit_argb_to_888_neon},
+	{_blit_888_to_argb,			_blit_888_to_argb_neon},
+	{_blit_argb_to_argb_key,	_blit_argb_to_argb_key_neon},
+	{_blend_565_blend,			_blend_565_blend_neon},
+	{_blend_565p_blend,			_blend_565p_blend_neon},
+	{_blend_argb_blend,			_blend_argb_blend_neon},
+#endif
+	{RT_NULL, RT_NULL},
+};
+
+/* the index of pixel format in the tables, -1 if it's not supported */
+static int _blit_format_index(int pixel_format)
+{
+	switch (pixel_format)
+	{
+	case RTGRAPHIC_PIXEL_FORMAT_MONO:		return 0;
+	case RTGRAPHIC_PIXEL_FORMAT_GRAY4:		return 1;
+	case RTGRAPHIC_PIXEL_FORMAT_GRAY16:		return 2;
+	case RTGRAPHIC_PIXEL_FORMAT_RGB565:		return 3;
+	case RTGRAPHIC_PIXEL_FORMAT_RGB565P:	return 4;
+	case RTGRAPHIC_PIXEL_FORMAT_RGB888:		return 5;
+	case RTGRAPHIC_PIXEL_FORMAT_ARGB888:	return 6;
+	}
+
+	return -1;
+}
+
+static const rtgui_blit_line_func _blit_format_table[7][7] =
+{
+	/* to MONO from MONO, GRAY4, GRAY16, RGB565, RGB565P, RGB888, ARGB888 */
+	{_blit_copy_mono, _blit_gray4_to_mono, _blit_gray16_to_mono, _blit_565_to_mono,
+	 _blit_565p_to_mono, _blit_888_to_mono, _blit_argb_to_mono},
+	/* to GRAY4 */
+	{_blit_mono_to_gray4, _blit_copy_gray4, _blit_gray16_to_gray4, _blit_565_to_gray4,
+	 _blit_565p_to_gray4, _blit_888_to_gray4, _blit_argb_to_gray4},
+	/* to GRAY16 */
+	{_blit_mono_to_gray16, _blit_gray4_to_gray16, _blit_copy_gray16, _blit_565_to_gray16,
+	 _blit_565p_to_gray16, _blit_888_to_gray16, _blit_argb_to_gray16},
+	/* to RGB565 */
+	{_blit_mono_to_565, _blit_gray4_to_565, _blit_gray16_to_565, _blit_copy_565,
+	 _blit_565_swap, _blit_888_to_565, _blit_argb_to_565},
+	/* to RGB565P */
+	{_blit_mono_to_565p, _blit_gray4_to_565p, _blit_gray16_to_565p, _blit_565_swap,
+	 _blit_copy_565, _blit_888_to_565p, _blit_argb_to_565p},
+	/* to RGB888 */
+	{_blit_mono_to_888, _blit_gray4_to_888, _blit_gray16_to_888, _blit_565_to_888,
+	 _blit_565p_to_888, _blit_copy_888, _blit_argb_to_888},
+	/* to ARGB888 */
+	{_blit_mono_to_argb, _blit_gray4_to_argb, _blit_gray16_to_argb, _blit_565_to_argb,
+	 _blit_565p_to_argb, _blit_888_to_argb, _blit_copy_argb},
+};
+
+/* from ARGB888 with alpha key */
+static const rtgui_blit_line_func _blit_key_table[7] =
+{
+	_blit_argb_to_mono_key, _blit_argb_to_gray4_key, _blit_argb_to_gray16_key, _blit_argb_to_565_key,
+	_blit_argb_to_565p_key, _blit_argb_to_888_key, _blit_argb_to_argb_key,
+};
+
+static rtgui_blit_line_func _blit_select(rtgui_blit_line_func func)
+{
+	int index;
+
+	for (index = 0; _blit_vector[index].func != RT_NULL; index ++)
+	{
+		if (_blit_vector[index].func == func) return _blit_vector[index].vector;
+	}
+
+	return func;
+}
+
+rtgui_blit_line_func rtgui_blit_line_get_format(int dst_format, int src_format)
+{
+	int dst, src;
+
+	dst = _blit_format_index(dst_format);
+	src = _blit_format_index(src_format);
+	if (dst < 0 || src < 0) return RT_NULL;
+
+	return _blit_select(_blit_format_table[dst][src]);
+}
+
+rtgui_blit_line_func rtgui_blit_line_get_format_key(int dst_format, int src_format)
+{
+	int dst;
+
+	/* only ARGB888 has alpha */
+	if (src_format != RTGRAPHIC_PIXEL_FORMAT_ARGB888)
+		return rtgui_blit_line_get_format(dst_format, src_format);
+
+	dst = _blit_format_index(dst_format);
+	if (dst < 0) return RT_NULL;
+
+	return _blit_select(_blit_key_table[dst]);
+}
+
+/* the blenders on RGB565, RGB565P, RGB888 and ARGB888 in BLEND, ADD and MOD */
+static const rtgui_blit_line_func _blend_table[4][3] =
+{
+	{_blend_565_blend,	_blend_565_add,		_blend_565_mod},
+	{_blend_565p_blend,	_blend_565p_add,	_blend_565p_mod},
+	{_blend_888_blend,	_blend_888_add,		_blend_888_mod},
+	{_blend_argb_blend,	_blend_argb_add,	_blend_argb_mod},
+};
+
+rtgui_blit_line_func rtgui_blend_line_get(int dst_format, int mode)
+{
+	int dst;
+
+	/* no blending, it's a conversion */
+	if (mode == RTGUI_BLENDMODE_NONE)
+		return rtgui_blit_line_get_format(dst_format, RTGRAPHIC_PIXEL_FORMAT_ARGB888);
+	if (mode > RTGUI_BLENDMODE_MOD) return RT_NULL;
+
+	/* the mono and gray formats have no blender */
+	dst = _blit_format_index(dst_format);
+	if (dst < 3) return RT_NULL;
+
+	return _blit_select(_blend_table[dst - 3][mode - 1]);
+}
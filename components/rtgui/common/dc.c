@@ -26,6 +26,10 @@
 #define M_PI    3.14159265358979323846
 #endif
 
+/* the spans and points gathered on stack before drawn */
+#define DC_SPAN_MAX		32
+#define DC_MONO_BIT(line, x)	(((line)[(x) >> 3] >> (7 - ((x) & 0x07))) & 0x01)
+
 static int _int_compare(const void *a, const void *b)
 {
 	return (*(const int *) a) - (*(const int *) b);
@@ -286,22 +290,94 @@ void rtgui_dc_draw_text (struct rtgui_dc* dc, const char* text, struct rtgui_rec
 	rtgui_font_draw(font, dc, text, len, &text_rect);
 }
 
+/* draw the spans in the background color of gc */
+static void _dc_draw_background_spans(struct rtgui_dc* dc, struct rtgui_span* spans, int count)
+{
+	rtgui_gc_t *gc;
+	rtgui_color_t foreground;
+
+	gc = rtgui_dc_get_gc(dc);
+	foreground = gc->foreground;
+	gc->foreground = gc->background;
+	rtgui_dc_draw_spans(dc, spans, count);
+	gc->foreground = foreground;
+}
+
+void rtgui_dc_draw_mono_bits(struct rtgui_dc* dc, int x, int y, int w, int h, int pitch,
+	const rt_uint8_t* data, rt_bool_t background)
+{
+	struct rtgui_span fg[DC_SPAN_MAX], bg[DC_SPAN_MAX];
+	int fg_count, bg_count;
+	int i, start, end, bit;
+
+	fg_count = bg_count = 0;
+	for (i = 0; i < h; i ++, data += pitch)
+	{
+		/* gather the runs of same bit in line */
+		for (start = 0; start < w; start = end)
+		{
+			bit = DC_MONO_BIT(data, start);
+			for (end = start + 1; end < w && DC_MONO_BIT(data, end) == bit; end ++) ;
+
+			if (bit != 0)
+			{
+				fg[fg_count].x1 = x + start;
+				fg[fg_count].x2 = x + end;
+				fg[fg_count].y  = y + i;
+				if (++ fg_count == DC_SPAN_MAX)
+				{
+					rtgui_dc_draw_spans(dc, fg, fg_count);
+					fg_count = 0;
+				}
+			}
+			else if (background == RT_TRUE)
+			{
+				bg[bg_count].x1 = x + start;
+				bg[bg_count].x2 = x + end;
+				bg[bg_count].y  = y + i;
+				if (++ bg_count == DC_SPAN_MAX)
+				{
+					_dc_draw_background_spans(dc, bg, bg_count);
+					bg_count = 0;
+				}
+			}
+		}
+	}
+
+	if (fg_count > 0) rtgui_dc_draw_spans(dc, fg, fg_count);
+	if (bg_count > 0) _dc_draw_background_spans(dc, bg, bg_count);
+}
+
+void rtgui_dc_draw_color_line(struct rtgui_dc* dc, int x, int y, const rtgui_color_t* colors, int count)
+{
+	struct rtgui_point points[DC_SPAN_MAX];
+	rtgui_color_t line[DC_SPAN_MAX];
+	int index, n;
+
+	for (index = 0, n = 0; index < count; index ++)
+	{
+		if ((colors[index] >> 24) == 255) continue;
+
+		points[n].x = x + index;
+		points[n].y = y;
+		line[n] = colors[index];
+		if (++ n == DC_SPAN_MAX)
+		{
+			rtgui_dc_draw_color_points(dc, points, line, n);
+			n = 0;
+		}
+	}
+
+	if (n > 0) rtgui_dc_draw_color_points(dc, points, line, n);
+}
+
 /*
  * draw a monochrome color bitmap data
  */
 void rtgui_dc_draw_mono_bmp(struct rtgui_dc* dc, int x, int y, int w, int h, const rt_uint8_t* data)
 {
-	int i, j, k;
-
-	/* get word bytes */
-	w = (w + 7)/8;
-
-	/* draw mono bitmap data */
-	for (i = 0; i < h; i ++)
-		for (j = 0; j < w; j++)
-			for (k = 0; k < 8; k++)
-				if ( ((data[i*w + j] >> (7-k)) & 0x01) != 0)
-					rtgui_dc_draw_point(dc, x + 8*j + k, y + i);
+	/* the lines are in word bytes */
+	rtgui_dc_draw_mono_bits(dc, x, y, (w + 7)/8 * 8, h, (w + 7)/8, data, RT_FALSE);
 }
 
 void rtgui_dc_draw_byte(struct rtgui_dc*dc, int x, int y, int h, const rt_uint8_t* data)
@@ -17,14 +17,19 @@
 #include <rtgui/dc_hw.h>
 #include <rtgui/color.h>
 #include <rtgui/rtgui_system.h>
+#include <rtgui/rtgui_application.h>
 
 #define hw_driver				(rtgui_graphic_driver_get_default())
+#define _int_swap(x, y)			do {x ^= y; y ^= x; x ^= y;} while (0)
 
-#define RTGUI_BLENDMODE_NONE	0x00
-#define RTGUI_BLENDMODE_BLEND	0x01
-#define RTGUI_BLENDMODE_ADD		0x02
-#define RTGUI_BLENDMODE_MOD		0x03
+/* the pixels blended on stack when the driver has no blend_hline */
+#define BLEND_PIECE				64
 
+/*
+ * The pixels of buffer dc are in the raw line of its pixel format, which is
+ * the layout of blit.h, so the line of the same format is copied directly.
+ * The packed pixels (mono and gray) don't cross the bytes.
+ */
 struct rtgui_dc_buffer
 {
 	struct rtgui_dc parent;
@@ -35,11 +40,19 @@ struct rtgui_dc_buffer
 	/* pixel format */
 	rt_uint8_t pixel_format;
 	rt_uint8_t blend_mode;
+	rt_uint8_t bits_per_pixel;
+
+	/* the pixels of color key are skipped by blit, in RGB for RGB888 and ARGB888 */
+	rt_uint8_t key_enable;
+	rt_uint32_t key_pixel;
 
 	/* width and height */
 	rt_uint16_t width, height;
 	rt_uint16_t pitch;
 
+	/* map the color to the pixel of buffer */
+	rt_uint32_t (*map_color)(rtgui_color_t c);
+
 	/* blit info */
 	rtgui_region_t clip;
 
@@ -47,6 +60,10 @@ struct rtgui_dc_buffer
 	rt_uint8_t* pixel;
 };
 
+#define BUFFER_PIXEL(dc, x, y)	((dc)->pixel + (y) * (dc)->pitch + (x) * (dc)->bits_per_pixel / 8)
+#define BUFFER_MASK(dc)			((1 << (dc)->bits_per_pixel) - 1)
+#define BUFFER_LINE_SIZE(bpp, count)	(((count) * (bpp) + 7) / 8)
+
 static rt_bool_t rtgui_dc_buffer_fini(struct rtgui_dc* dc);
 static void rtgui_dc_buffer_draw_point(struct rtgui_dc* dc, int x, int y);
 static void rtgui_dc_buffer_draw_color_point(struct rtgui_dc* dc, int x, int y, rtgui_color_t color);
@@ -56,6 +73,10 @@ static void rtgui_dc_buffer_fill_rect (struct rtgui_dc* dc, struct rtgui_rect* r
 static void rtgui_dc_buffer_blit_line(struct rtgui_dc* self, int x1, int x2, int y, rt_uint8_t* line_data);
 static void rtgui_dc_buffer_blit(struct rtgui_dc* self, struct rtgui_point* dc_point,
 	struct rtgui_dc* dest, rtgui_rect_t* rect);
+static void rtgui_dc_buffer_draw_points(struct rtgui_dc* dc, struct rtgui_point* points, int count);
+static void rtgui_dc_buffer_draw_color_points(struct rtgui_dc* dc, struct rtgui_point* points,
+	rtgui_color_t* colors, int count);
+static void rtgui_dc_buffer_draw_spans(struct rtgui_dc* dc, struct rtgui_span* spans, int count);
 
 static void rtgui_dc_buffer_set_gc (struct rtgui_dc* dc, rtgui_gc_t *gc);
 static rtgui_gc_t* rtgui_dc_buffer_get_gc(struct rtgui_dc* dc);
@@ -73,6 +94,10 @@ const static struct rtgui_dc_engine dc_buffer_engine =
 	rtgui_dc_buffer_blit_line,
 	rtgui_dc_buffer_blit,
 
+	rtgui_dc_buffer_draw_points,
+	rtgui_dc_buffer_draw_color_points,
+	rtgui_dc_buffer_draw_spans,
+
 	rtgui_dc_buffer_set_gc,
 	rtgui_dc_buffer_get_gc,
 
@@ -82,25 +107,107 @@ const static struct rtgui_dc_engine dc_buffer_engine =
 	rtgui_dc_buffer_fini,
 };
 
+/* the colors are mapped as the converters from ARGB888 in blit.h do */
+static rt_uint32_t _dc_buffer_map_mono(rtgui_color_t c)
+{
+	/* white is cleared */
+	return (c & 0x00ffffff) != 0x00ffffff;
+}
+
+static rt_uint32_t _dc_buffer_map_gray4(rtgui_color_t c)
+{
+	return rtgui_color_to_gray(c) >> 6;
+}
+
+static rt_uint32_t _dc_buffer_map_gray16(rtgui_color_t c)
+{
+	return rtgui_color_to_gray(c) >> 4;
+}
+
+static rt_uint32_t _dc_buffer_map_565(rtgui_color_t c)
+{
+	return rtgui_color_to_565(c);
+}
+
+static rt_uint32_t _dc_buffer_map_565p(rtgui_color_t c)
+{
+	return rtgui_color_to_565p(c);
+}
+
+static rt_uint32_t _dc_buffer_map_argb(rtgui_color_t c)
+{
+	return c;
+}
+
+static const struct
+{
+	rt_uint8_t pixel_format;
+	rt_uint8_t bits_per_pixel;
+	rt_uint32_t (*map_color)(rtgui_color_t c);
+} _dc_buffer_formats[] =
+{
+	{RTGRAPHIC_PIXEL_FORMAT_MONO,		1,	_dc_buffer_map_mono},
+	{RTGRAPHIC_PIXEL_FORMAT_GRAY4,		2,	_dc_buffer_map_gray4},
+	{RTGRAPHIC_PIXEL_FORMAT_GRAY16,		4,	_dc_buffer_map_gray16},
+	{RTGRAPHIC_PIXEL_FORMAT_RGB565,		16,	_dc_buffer_map_565},
+	{RTGRAPHIC_PIXEL_FORMAT_RGB565P,	16,	_dc_buffer_map_565p},
+	{RTGRAPHIC_PIXEL_FORMAT_RGB888,		24,	_dc_buffer_map_argb},
+	{RTGRAPHIC_PIXEL_FORMAT_ARGB888,	32,	_dc_buffer_map_argb},
+};
+
 struct rtgui_dc* rtgui_dc_buffer_create(int w, int h)
+{
+	rt_uint8_t pixel_format;
+
+	/* in the pixel format of driver, or ARGB888 if the buffer doesn't support it */
+	pixel_format = RTGRAPHIC_PIXEL_FORMAT_ARGB888;
+	if (hw_driver != RT_NULL && rtgui_blit_line_get_format(hw_driver->pixel_format,
+		RTGRAPHIC_PIXEL_FORMAT_ARGB888) != RT_NULL)
+		pixel_format = hw_driver->pixel_format;
+
+	return rtgui_dc_buffer_create_pixformat(pixel_format, w, h);
+}
+
+struct rtgui_dc* rtgui_dc_buffer_create_pixformat(rt_uint8_t pixel_format, int w, int h)
 {
 	struct rtgui_dc_buffer* dc;
+	int index;
+
+	for (index = 0; index < sizeof(_dc_buffer_formats)/sizeof(_dc_buffer_formats[0]); index ++)
+	{
+		if (_dc_buffer_formats[index].pixel_format == pixel_format) break;
+	}
+	if (index == sizeof(_dc_buffer_formats)/sizeof(_dc_buffer_formats[0])) return RT_NULL;
 
 	dc = (struct rtgui_dc_buffer*)rtgui_malloc(sizeof(struct rtgui_dc_buffer));
+	if (dc == RT_NULL) return RT_NULL;
 	dc->parent.type   = RTGUI_DC_BUFFER;
 	dc->parent.engine = &dc_buffer_engine;
 	dc->gc.foreground = default_foreground;
 	dc->gc.background = default_background;
 	dc->gc.font = rtgui_font_default();
 	dc->gc.textalign = RTGUI_ALIGN_LEFT | RTGUI_ALIGN_TOP;
+	dc->gc.map_color = RT_NULL;
+	dc->blend_mode = RTGUI_BLENDMODE_NONE;
+	dc->key_enable = RT_FALSE;
+	dc->key_pixel  = 0;
+
+	dc->pixel_format	= pixel_format;
+	dc->bits_per_pixel	= _dc_buffer_formats[index].bits_per_pixel;
+	dc->map_color		= _dc_buffer_formats[index].map_color;
 
 	dc->width	= w;
 	dc->height	= h;
-	dc->pitch	= w * sizeof(rtgui_color_t);
+	dc->pitch	= BUFFER_LINE_SIZE(dc->bits_per_pixel, w);
 
 	rtgui_region_init(&(dc->clip));
 
 	dc->pixel = rtgui_malloc(h * dc->pitch);
+	if (dc->pixel == RT_NULL)
+	{
+		rtgui_free(dc);
+		return RT_NULL;
+	}
 	rt_memset(dc->pixel, 0, h * dc->pitch);
 
 	return &(dc->parent);
@@ -115,6 +222,39 @@ rt_uint8_t* rtgui_dc_buffer_get_pixel(struct rtgui_dc* dc)
 	return dc_buffer->pixel;
 }
 
+rt_uint8_t rtgui_dc_buffer_get_pixel_format(struct rtgui_dc* dc)
+{
+	RT_ASSERT(dc != RT_NULL && dc->type == RTGUI_DC_BUFFER);
+
+	return ((struct rtgui_dc_buffer*)dc)->pixel_format;
+}
+
+void rtgui_dc_buffer_set_blend_mode(struct rtgui_dc* dc, rt_uint8_t mode)
+{
+	struct rtgui_dc_buffer* dc_buffer;
+
+	RT_ASSERT(dc != RT_NULL && dc->type == RTGUI_DC_BUFFER);
+	RT_ASSERT(mode <= RTGUI_BLENDMODE_MOD);
+
+	dc_buffer = (struct rtgui_dc_buffer*)dc;
+	/* only the pixels of ARGB888 have the opacity */
+	RT_ASSERT(mode == RTGUI_BLENDMODE_NONE || dc_buffer->pixel_format == RTGRAPHIC_PIXEL_FORMAT_ARGB888);
+	dc_buffer->blend_mode = mode;
+}
+
+void rtgui_dc_buffer_set_color_key(struct rtgui_dc* dc, rt_bool_t enable, rtgui_color_t key)
+{
+	struct rtgui_dc_buffer* dc_buffer;
+
+	RT_ASSERT(dc != RT_NULL && dc->type == RTGUI_DC_BUFFER);
+
+	dc_buffer = (struct rtgui_dc_buffer*)dc;
+	dc_buffer->key_enable = enable;
+	dc_buffer->key_pixel  = dc_buffer->map_color(key);
+	/* the alpha isn't compared */
+	if (dc_buffer->bits_per_pixel >= 24) dc_buffer->key_pixel &= 0x00ffffff;
+}
+
 static rt_bool_t rtgui_dc_buffer_fini(struct rtgui_dc* dc)
 {
 	struct rtgui_dc_buffer* buffer = (struct rtgui_dc_buffer*)dc;
@@ -127,191 +267,770 @@ static rt_bool_t rtgui_dc_buffer_fini(struct rtgui_dc* dc)
 	return RT_TRUE;
 }
 
+/* get the pixel of foreground or background, they are mapped again when the color is changed */
+rt_inline void _dc_buffer_check_map(struct rtgui_dc_buffer* dc)
+{
+	if (dc->gc.map_color != dc->map_color)
+	{
+		dc->gc.map_color = dc->map_color;
+		dc->gc.fc_pixel = dc->map_color(dc->gc.fc_mapped = dc->gc.foreground);
+		dc->gc.bc_pixel = dc->map_color(dc->gc.bc_mapped = dc->gc.background);
+	}
+}
+
+rt_inline rt_uint32_t _dc_buffer_fc_pixel(struct rtgui_dc_buffer* dc)
+{
+	_dc_buffer_check_map(dc);
+	if (dc->gc.fc_mapped != dc->gc.foreground)
+		dc->gc.fc_pixel = dc->map_color(dc->gc.fc_mapped = dc->gc.foreground);
+
+	return dc->gc.fc_pixel;
+}
+
+rt_inline rt_uint32_t _dc_buffer_bc_pixel(struct rtgui_dc_buffer* dc)
+{
+	_dc_buffer_check_map(dc);
+	if (dc->gc.bc_mapped != dc->gc.background)
+		dc->gc.bc_pixel = dc->map_color(dc->gc.bc_mapped = dc->gc.background);
+
+	return dc->gc.bc_pixel;
+}
+
+/* the shift of a packed pixel in byte, the left pixel of mono is in the least significant bit */
+rt_inline int _dc_buffer_shift(struct rtgui_dc_buffer* dc, int x)
+{
+	if (dc->pixel_format == RTGRAPHIC_PIXEL_FORMAT_MONO) return x & 0x07;
+
+	return 8 - dc->bits_per_pixel - ((x * dc->bits_per_pixel) & 0x07);
+}
+
+/* get and set the packed pixel x of a raw line */
+rt_inline rt_uint32_t _dc_buffer_get_packed(struct rtgui_dc_buffer* dc, rt_uint8_t* line, int x)
+{
+	return (line[x * dc->bits_per_pixel / 8] >> _dc_buffer_shift(dc, x)) & BUFFER_MASK(dc);
+}
+
+rt_inline void _dc_buffer_set_packed(struct rtgui_dc_buffer* dc, rt_uint8_t* line, int x, rt_uint32_t pixel)
+{
+	rt_uint8_t* ptr;
+	int shift;
+
+	ptr = line + x * dc->bits_per_pixel / 8;
+	shift = _dc_buffer_shift(dc, x);
+	*ptr = (*ptr & ~(BUFFER_MASK(dc) << shift)) | (pixel << shift);
+}
+
+rt_inline void _dc_buffer_set_pixel(struct rtgui_dc_buffer* dc, rt_uint32_t pixel, int x, int y)
+{
+	rt_uint8_t* ptr;
+
+	switch (dc->bits_per_pixel)
+	{
+	case 32:
+		*(rt_uint32_t*)BUFFER_PIXEL(dc, x, y) = pixel;
+		break;
+	case 24:
+		ptr = BUFFER_PIXEL(dc, x, y);
+		ptr[0] = RTGUI_RGB_R(pixel);
+		ptr[1] = RTGUI_RGB_G(pixel);
+		ptr[2] = RTGUI_RGB_B(pixel);
+		break;
+	case 16:
+		*(rt_uint16_t*)BUFFER_PIXEL(dc, x, y) = (rt_uint16_t)pixel;
+		break;
+	default:
+		_dc_buffer_set_packed(dc, dc->pixel + y * dc->pitch, x, pixel);
+		break;
+	}
+}
+
+/* fill the pixels [x1, x2) of line y, which are inside of buffer */
+static void _dc_buffer_fill_hline(struct rtgui_dc_buffer* dc, rt_uint32_t pixel, int x1, int x2, int y)
+{
+	rt_uint8_t* ptr;
+	int ppb;
+
+	ptr = BUFFER_PIXEL(dc, x1, y);
+	switch (dc->bits_per_pixel)
+	{
+	case 32:
+		for (; x1 < x2; x1 ++, ptr += 4) *(rt_uint32_t*)ptr = pixel;
+		break;
+	case 24:
+		for (; x1 < x2; x1 ++, ptr += 3)
+		{
+			ptr[0] = RTGUI_RGB_R(pixel);
+			ptr[1] = RTGUI_RGB_G(pixel);
+			ptr[2] = RTGUI_RGB_B(pixel);
+		}
+		break;
+	case 16:
+		for (; x1 < x2; x1 ++, ptr += 2) *(rt_uint16_t*)ptr = (rt_uint16_t)pixel;
+		break;
+	default:
+		/* the head and tail in partial bytes, the whole bytes are set at once */
+		ppb = 8 / dc->bits_per_pixel;
+		for (; x1 < x2 && x1 % ppb != 0; x1 ++)
+			_dc_buffer_set_pixel(dc, pixel, x1, y);
+		if (x2 - x1 >= ppb)
+		{
+			rt_memset(BUFFER_PIXEL(dc, x1, y), pixel * (0xff / BUFFER_MASK(dc)), (x2 - x1) / ppb);
+			x1 += (x2 - x1) / ppb * ppb;
+		}
+		for (; x1 < x2; x1 ++)
+			_dc_buffer_set_pixel(dc, pixel, x1, y);
+		break;
+	}
+}
+
+/*
+ * get the raw line of count pixels from (x, y). The packed pixels which don't
+ * start at byte are shifted to the scratch line.
+ */
+static rt_uint8_t* _dc_buffer_get_line(struct rtgui_dc_buffer* dc, int x, int y, int count, rt_uint8_t* scratch)
+{
+	rt_uint8_t* line;
+	int index;
+
+	if (dc->bits_per_pixel >= 8 || ((x * dc->bits_per_pixel) & 0x07) == 0)
+		return BUFFER_PIXEL(dc, x, y);
+
+	line = dc->pixel + y * dc->pitch;
+	for (index = 0; index < count; index ++)
+		_dc_buffer_set_packed(dc, scratch, index, _dc_buffer_get_packed(dc, line, x + index));
+
+	return scratch;
+}
+
+/* put a raw line of count pixels to (x, y) */
+static void _dc_buffer_put_line(struct rtgui_dc_buffer* dc, int x, int y, rt_uint8_t* pixels, int count)
+{
+	rt_uint8_t* line;
+	int index;
+
+	if (dc->bits_per_pixel >= 8)
+	{
+		rt_memcpy(BUFFER_PIXEL(dc, x, y), pixels, count * dc->bits_per_pixel / 8);
+		return;
+	}
+
+	index = 0;
+	if (((x * dc->bits_per_pixel) & 0x07) == 0)
+	{
+		/* on the byte boundary, copy the whole bytes */
+		index = count * dc->bits_per_pixel / 8;
+		rt_memcpy(BUFFER_PIXEL(dc, x, y), pixels, index);
+		index = index * 8 / dc->bits_per_pixel;
+	}
+
+	line = dc->pixel + y * dc->pitch;
+	for (; index < count; index ++)
+		_dc_buffer_set_packed(dc, line, x + index, _dc_buffer_get_packed(dc, pixels, index));
+}
+
+/* the count of pixels from (x, y), up to count, which are the color key or not by key */
+static int _dc_buffer_key_run(struct rtgui_dc_buffer* dc, int x, int y, int count, rt_bool_t key)
+{
+	rt_uint8_t *ptr, *line;
+	rt_uint32_t pixel, pattern;
+	int index, ppb;
+
+	pixel = dc->key_pixel;
+	ptr = BUFFER_PIXEL(dc, x, y);
+	index = 0;
+	switch (dc->bits_per_pixel)
+	{
+	case 32:
+		if (key) while (index < count && (((rt_uint32_t*)ptr)[index] & 0x00ffffff) == pixel) index ++;
+		else while (index < count && (((rt_uint32_t*)ptr)[index] & 0x00ffffff) != pixel) index ++;
+		break;
+	case 24:
+		for (; index < count; index ++, ptr += 3)
+			if (((ptr[0] | (ptr[1] << 8) | (ptr[2] << 16)) == pixel) != key) break;
+		break;
+	case 16:
+		if (key) while (index < count && ((rt_uint16_t*)ptr)[index] == pixel) index ++;
+		else while (index < count && ((rt_uint16_t*)ptr)[index] != pixel) index ++;
+		break;
+	default:
+		/* the whole bytes of key are skipped, so are the ones without key in mono */
+		line = dc->pixel + y * dc->pitch;
+		ppb = 8 / dc->bits_per_pixel;
+		pattern = pixel * (0xff / BUFFER_MASK(dc));
+		if (!key) pattern = dc->bits_per_pixel == 1? (~pattern & 0xff) : 0x100;
+		while (index < count)
+		{
+			if ((x + index) % ppb == 0 && count - index >= ppb)
+			{
+				if (line[(x + index) / ppb] == pattern)
+				{
+					index += ppb;
+					continue;
+				}
+			}
+			if ((_dc_buffer_get_packed(dc, line, x + index) == pixel) != key) break;
+			index ++;
+		}
+		break;
+	}
+
+	return index;
+}
+
+/*
+ * get the next run of the pixels which are not the color key in the count
+ * pixels from (x, y). The offset of run is returned and its count is in run,
+ * which is 0 if all of them are the color key.
+ */
+static int _dc_buffer_next_run(struct rtgui_dc_buffer* dc, int x, int y, int count, int* run)
+{
+	int offset;
+
+	if (dc->key_enable == RT_FALSE)
+	{
+		*run = count;
+		return 0;
+	}
+
+	offset = _dc_buffer_key_run(dc, x, y, count, RT_TRUE);
+	*run = _dc_buffer_key_run(dc, x + offset, y, count - offset, RT_FALSE);
+
+	return offset;
+}
+
 static void rtgui_dc_buffer_draw_point(struct rtgui_dc* self, int x, int y)
 {
-	rtgui_color_t* ptr;
 	struct rtgui_dc_buffer* dc;
 
 	dc = (struct rtgui_dc_buffer*)self;
 
 	/* does not draw point out of dc */
-	if ((x > dc->width) || (y > dc->height)) return ;
-	
-	/* note: there is no parameter check in this function */
-	ptr = (rtgui_color_t*)(dc->pixel + y * dc->pitch + x * sizeof(rtgui_color_t));
+	if ((rt_uint16_t)x >= dc->width || (rt_uint16_t)y >= dc->height) return;
 
-	*ptr = dc->gc.foreground;
+	_dc_buffer_set_pixel(dc, _dc_buffer_fc_pixel(dc), x, y);
 }
 
 static void rtgui_dc_buffer_draw_color_point(struct rtgui_dc* self, int x, int y, rtgui_color_t color)
 {
-	rtgui_color_t* ptr;
 	struct rtgui_dc_buffer* dc;
 
 	dc = (struct rtgui_dc_buffer*)self;
+	if ((rt_uint16_t)x >= dc->width || (rt_uint16_t)y >= dc->height) return;
 
-	/* note: there is no parameter check in this function */
-	ptr = (rtgui_color_t*)(dc->pixel + y * dc->pitch + x * sizeof(rtgui_color_t));
+	_dc_buffer_set_pixel(dc, dc->map_color(color), x, y);
+}
 
-	*ptr = color;
+static void rtgui_dc_buffer_draw_points(struct rtgui_dc* self, struct rtgui_point* points, int count)
+{
+	struct rtgui_dc_buffer* dc;
+	rt_uint32_t pixel;
+
+	dc = (struct rtgui_dc_buffer*)self;
+	pixel = _dc_buffer_fc_pixel(dc);
+	for (; count > 0; count --, points ++)
+	{
+		/* does not draw point out of dc */
+		if ((rt_uint16_t)points->x >= dc->width || (rt_uint16_t)points->y >= dc->height) continue;
+
+		_dc_buffer_set_pixel(dc, pixel, points->x, points->y);
+	}
+}
+
+static void rtgui_dc_buffer_draw_color_points(struct rtgui_dc* self, struct rtgui_point* points,
+	rtgui_color_t* colors, int count)
+{
+	struct rtgui_dc_buffer* dc;
+
+	dc = (struct rtgui_dc_buffer*)self;
+	for (; count > 0; count --, points ++, colors ++)
+	{
+		if ((rt_uint16_t)points->x >= dc->width || (rt_uint16_t)points->y >= dc->height) continue;
+
+		_dc_buffer_set_pixel(dc, dc->map_color(*colors), points->x, points->y);
+	}
+}
+
+static void rtgui_dc_buffer_draw_spans(struct rtgui_dc* self, struct rtgui_span* spans, int count)
+{
+	int x1, x2;
+	struct rtgui_dc_buffer* dc;
+	rt_uint32_t pixel;
+
+	dc = (struct rtgui_dc_buffer*)self;
+	pixel = _dc_buffer_fc_pixel(dc);
+	for (; count > 0; count --, spans ++)
+	{
+		/* keep the span in dc */
+		if ((rt_uint16_t)spans->y >= dc->height) continue;
+		x1 = spans->x1;
+		x2 = spans->x2;
+		if (x1 > x2) _int_swap(x1, x2);
+		if (x1 < 0) x1 = 0;
+		if (x2 > dc->width) x2 = dc->width;
+
+		if (x1 < x2) _dc_buffer_fill_hline(dc, pixel, x1, x2, spans->y);
+	}
 }
 
 static void rtgui_dc_buffer_draw_vline(struct rtgui_dc* self, int x, int y1, int y2)
 {
-	rtgui_color_t* ptr;
-	register rt_base_t index;
+	rt_uint32_t pixel;
 	struct rtgui_dc_buffer* dc;
 
 	dc = (struct rtgui_dc_buffer*)self;
 
-	if (x  >= dc->width) return;
-	if (y1 > dc->height) y1 = dc->height;
+	if ((rt_uint16_t)x >= dc->width) return;
+	if (y1 < 0) y1 = 0;
 	if (y2 > dc->height) y2 = dc->height;
 
-	ptr = (rtgui_color_t*)(dc->pixel + y1 * dc->pitch + x * sizeof(rtgui_color_t));
-	for (index = y1; index < y2; index ++)
+	pixel = _dc_buffer_fc_pixel(dc);
+	for (; y1 < y2; y1 ++)
 	{
 		/* draw this point */
-		*ptr = dc->gc.foreground;
-		ptr += dc->width;
+		_dc_buffer_set_pixel(dc, pixel, x, y1);
 	}
 }
 
 static void rtgui_dc_buffer_draw_hline(struct rtgui_dc* self, int x1, int x2, int y)
 {
-	rtgui_color_t* ptr;
-	register rt_base_t index;
 	struct rtgui_dc_buffer* dc;
 
 	dc = (struct rtgui_dc_buffer*)self;
-	if (y >= dc->height) return;
-	if (x1 > dc->width) x1 = dc->width;
+	if ((rt_uint16_t)y >= dc->height) return;
+	if (x1 < 0) x1 = 0;
 	if (x2 > dc->width) x2 = dc->width;
 
-	ptr = (rtgui_color_t*)(dc->pixel + y * dc->pitch + x1 * sizeof(rtgui_color_t));
-	for (index = x1; index < x2; index ++)
-	{
-		/* draw this point */
-		*ptr++ = dc->gc.foreground;
-	}
+	if (x1 < x2) _dc_buffer_fill_hline(dc, _dc_buffer_fc_pixel(dc), x1, x2, y);
 }
 
 static void rtgui_dc_buffer_fill_rect (struct rtgui_dc* self, struct rtgui_rect* rect)
 {
-	rtgui_color_t foreground;
 	rtgui_rect_t r;
+	rt_uint32_t pixel;
+	register rt_base_t index;
 	struct rtgui_dc_buffer* dc;
 
 	r = *rect;
 	dc = (struct rtgui_dc_buffer*)self;
-	if (r.x1 > dc->width) r.x1 = dc->width;
+	if (r.x1 < 0) r.x1 = 0;
+	if (r.y1 < 0) r.y1 = 0;
 	if (r.x2 > dc->width) r.x2 = dc->width;
-	if (r.y1 > dc->height) r.y1 = dc->height;
 	if (r.y2 > dc->height) r.y2 = dc->height;
-	
-	/* save foreground color */
-	foreground = RTGUI_DC_FC(self);
+	if (r.x1 >= r.x2 || r.y1 >= r.y2) return;
+
+	/* fill first line in background */
+	pixel = _dc_buffer_bc_pixel(dc);
+	_dc_buffer_fill_hline(dc, pixel, r.x1, r.x2, r.y1);
+
+	/* memory copy other lines, the packed pixels may not start at byte */
+	for (index = r.y1 + 1; index < r.y2; index ++)
+	{
+		if (dc->bits_per_pixel >= 8)
+			rt_memcpy(BUFFER_PIXEL(dc, r.x1, index), BUFFER_PIXEL(dc, r.x1, r.y1),
+				(r.x2 - r.x1) * dc->bits_per_pixel / 8);
+		else
+			_dc_buffer_fill_hline(dc, pixel, r.x1, r.x2, index);
+	}
+}
+
+/*
+ * get the owner and the first clip rect of a hardware or client dc in the band
+ * of the logic rect, which is converted to device. The rects from it until end
+ * or the one below the rect are walked.
+ */
+static rtgui_rect_t* _dc_buffer_get_clip(struct rtgui_dc* dest, rtgui_widget_t **owner,
+	rtgui_rect_t *rect, rtgui_rect_t *device_rect, rtgui_rect_t *screen, rtgui_rect_t **end)
+{
+	/* both of them are embedded in owner */
+	*owner = RTGUI_CONTAINER_OF(dest, struct rtgui_widget, dc_type);
+
+	/* convert logic to device */
+	*device_rect = *rect;
+	rtgui_rect_moveto(device_rect, (*owner)->extent.x1, (*owner)->extent.y1);
+
+	if (dest->type == RTGUI_DC_HW)
+	{
+		/* hardware dc has no clip, keep it in screen */
+		rtgui_graphic_driver_get_rect(hw_driver, screen);
+		*end = screen + 1;
+		return screen;
+	}
+
+	return rtgui_region_find_band(&((*owner)->clip), device_rect->y1, end);
+}
+
+/*
+ * blit the device pixels of a logic rect to the owner of a hardware or client
+ * dc by the blit_rect operation of driver, in each clip rect of client dc.
+ */
+static void rtgui_dc_buffer_blit_rect(struct rtgui_dc* dest, rt_uint8_t* pixels, int pitch, rtgui_rect_t* rect)
+{
+	rtgui_widget_t *owner;
+	rtgui_rect_t device_rect, screen_rect, clip_rect;
+	rtgui_rect_t *prect, *end;
+	int bpp;
+
+	bpp = hw_driver->bits_per_pixel/8;
+	for (prect = _dc_buffer_get_clip(dest, &owner, rect, &device_rect, &screen_rect, &end);
+		prect < end && prect->y1 < device_rect.y2; prect ++)
+	{
+		clip_rect = device_rect;
+		rtgui_rect_intersect(prect, &clip_rect);
+		if (clip_rect.x1 >= clip_rect.x2 || clip_rect.y1 >= clip_rect.y2) continue;
+
+		hw_driver->ops->blit_rect(pixels + (clip_rect.y1 - device_rect.y1) * pitch +
+			(clip_rect.x1 - device_rect.x1) * bpp, pitch, &clip_rect);
+	}
+}
+
+/*
+ * blit the pixels of a logic rect from dc_point of buffer to the owner of a
+ * hardware or client dc in raw line, each clip rect is intersected once and
+ * only the pixels in it are converted to the line buffer. The pixels are drawn
+ * directly if there is no converter, the packed ones which don't start at
+ * byte are shifted to the scratch line first. The runs between the pixels of
+ * color key are drawn one by one.
+ */
+static void rtgui_dc_buffer_blit_lines(struct rtgui_dc* dest, struct rtgui_dc_buffer* dc,
+	struct rtgui_point* dc_point, rtgui_rect_t* rect, rtgui_blit_line_func blit_line,
+	rt_uint8_t* line_ptr, rt_uint8_t* scratch)
+{
+	rtgui_widget_t *owner;
+	rtgui_rect_t device_rect, screen_rect, clip_rect;
+	rtgui_rect_t *prect, *end;
+	rt_uint8_t *line;
+	int x, y, sx, sy, count, width;
+
+	for (prect = _dc_buffer_get_clip(dest, &owner, rect, &device_rect, &screen_rect, &end);
+		prect < end && prect->y1 < device_rect.y2; prect ++)
+	{
+		clip_rect = device_rect;
+		rtgui_rect_intersect(prect, &clip_rect);
+		if (clip_rect.x1 >= clip_rect.x2 || clip_rect.y1 >= clip_rect.y2) continue;
+
+		sx = dc_point->x + clip_rect.x1 - device_rect.x1;
+		sy = dc_point->y + clip_rect.y1 - device_rect.y1;
+		width = clip_rect.x2 - clip_rect.x1;
+		for (y = clip_rect.y1; y < clip_rect.y2; y ++, sy ++)
+		{
+			for (x = 0; x < width; x += count)
+			{
+				x += _dc_buffer_next_run(dc, sx + x, sy, width - x, &count);
+				if (count == 0) break;
+
+				line = _dc_buffer_get_line(dc, sx + x, sy, count, scratch);
+				if (blit_line != RT_NULL)
+				{
+					blit_line(line_ptr, line, count);
+					line = line_ptr;
+				}
+				hw_driver->ops->draw_raw_hline(line, clip_rect.x1 + x, clip_rect.x1 + x + count, y);
+			}
+		}
+	}
+}
 
-	/* set background color as foreground color */
-	RTGUI_DC_FC(self) = RTGUI_DC_BC(self);
+/* blend a line by get_pixel and set_pixel of driver, the pixel device coalesces them */
+static void _dc_buffer_blend_hline(rt_uint8_t* pixels, rtgui_blit_line_func blend, int x1, int x2, int y)
+{
+	rtgui_color_t line[BLEND_PIECE];
+	int x, index, count;
 
-	/* fill first line */
-	rtgui_dc_buffer_draw_hline(&(dc->parent), r.x1, r.x2, r.y1);
+	for (x = x1; x < x2; x += count, pixels += count * sizeof(rtgui_color_t))
+	{
+		count = x2 - x;
+		if (count > BLEND_PIECE) count = BLEND_PIECE;
+
+		for (index = 0; index < count; index ++)
+			hw_driver->ops->get_pixel(&line[index], x + index, y);
+		blend((rt_uint8_t*)line, pixels, count);
+		for (index = 0; index < count; index ++)
+			hw_driver->ops->set_pixel(&line[index], x + index, y);
+	}
+}
 
-	/* memory copy other lines */
-	if (r.y2 > r.y1)
+/*
+ * blend a line of ARGB888 pixels on the buffer in the pieces on stack, which
+ * are converted to ARGB888 and back. It's for the formats without blender.
+ */
+static void _dc_buffer_blend_piece(struct rtgui_dc_buffer* dc, rt_uint8_t* pixels,
+	rtgui_blit_line_func blend, int x1, int x2, int y)
+{
+	rtgui_color_t line[BLEND_PIECE];
+	rt_uint8_t piece[BLEND_PIECE], scratch[BLEND_PIECE];
+	rtgui_blit_line_func decode, encode;
+	int x, count;
+
+	decode = rtgui_blit_line_get_format(RTGRAPHIC_PIXEL_FORMAT_ARGB888, dc->pixel_format);
+	encode = rtgui_blit_line_get_format(dc->pixel_format, RTGRAPHIC_PIXEL_FORMAT_ARGB888);
+	for (x = x1; x < x2; x += count, pixels += count * sizeof(rtgui_color_t))
 	{
-		register rt_base_t index;
-		for (index = r.y1 + 1; index < r.y2; index ++)
+		count = x2 - x;
+		if (count > BLEND_PIECE) count = BLEND_PIECE;
+
+		decode((rt_uint8_t*)line, _dc_buffer_get_line(dc, x, y, count, scratch), count);
+		blend((rt_uint8_t*)line, pixels, count);
+		encode(piece, (rt_uint8_t*)line, count);
+		_dc_buffer_put_line(dc, x, y, piece, count);
+	}
+}
+
+void rtgui_dc_blend_pixels(struct rtgui_dc* dc, rt_uint8_t* pixels, int pitch,
+	rtgui_rect_t* rect, rt_uint8_t mode)
+{
+	rtgui_widget_t *owner;
+	rtgui_rect_t device_rect, screen_rect, clip_rect;
+	rtgui_rect_t *prect, *end;
+	rt_uint8_t *line;
+	rtgui_blit_line_func blend;
+	int y;
+
+	RT_ASSERT(dc != RT_NULL && pixels != RT_NULL && rect != RT_NULL);
+
+	if (rtgui_dc_get_visible(dc) == RT_FALSE) return;
+	blend = rtgui_blend_line_get(RTGRAPHIC_PIXEL_FORMAT_ARGB888, mode);
+	if (blend == RT_NULL) return;
+
+	if (dc->type == RTGUI_DC_BUFFER)
+	{
+		struct rtgui_dc_buffer* buffer = (struct rtgui_dc_buffer*)dc;
+		rtgui_blit_line_func buffer_blend;
+
+		/* keep it in buffer */
+		clip_rect.x1 = clip_rect.y1 = 0;
+		clip_rect.x2 = buffer->width;
+		clip_rect.y2 = buffer->height;
+		rtgui_rect_intersect(rect, &clip_rect);
+		if (clip_rect.x1 >= clip_rect.x2 || clip_rect.y1 >= clip_rect.y2) return;
+
+		/* blend on the pixels of buffer in place, or in pieces if there is no blender */
+		buffer_blend = RT_NULL;
+		if (buffer->bits_per_pixel >= 8)
+			buffer_blend = rtgui_blend_line_get(buffer->pixel_format, mode);
+
+		pixels += (clip_rect.y1 - rect->y1) * pitch + (clip_rect.x1 - rect->x1) * sizeof(rtgui_color_t);
+		for (y = clip_rect.y1; y < clip_rect.y2; y ++)
+		{
+			if (buffer_blend != RT_NULL)
+				buffer_blend(BUFFER_PIXEL(buffer, clip_rect.x1, y), pixels, clip_rect.x2 - clip_rect.x1);
+			else
+				_dc_buffer_blend_piece(buffer, pixels, blend, clip_rect.x1, clip_rect.x2, y);
+			pixels += pitch;
+		}
+		return;
+	}
+
+	for (prect = _dc_buffer_get_clip(dc, &owner, rect, &device_rect, &screen_rect, &end);
+		prect < end && prect->y1 < device_rect.y2; prect ++)
+	{
+		clip_rect = device_rect;
+		rtgui_rect_intersect(prect, &clip_rect);
+		if (clip_rect.x1 >= clip_rect.x2 || clip_rect.y1 >= clip_rect.y2) continue;
+
+		line = pixels + (clip_rect.y1 - device_rect.y1) * pitch +
+			(clip_rect.x1 - device_rect.x1) * sizeof(rtgui_color_t);
+		for (y = clip_rect.y1; y < clip_rect.y2; y ++, line += pitch)
 		{
-			rt_memcpy(dc->pixel + index * dc->pitch,
-				dc->pixel + r.y1 * dc->pitch,
-				(r.x2 - r.x1) * sizeof(rtgui_color_t));
+			/* the framebuffer is blended in place */
+			if (hw_driver->ops->blend_hline != RT_NULL)
+				hw_driver->ops->blend_hline(line, mode, clip_rect.x1, clip_rect.x2, y);
+			else
+				_dc_buffer_blend_hline(line, blend, clip_rect.x1, clip_rect.x2, y);
 		}
 	}
+}
+
+/*
+ * blit the pixels of a rect from dc_point of buffer to another buffer, the
+ * line of the same format is copied and the others are converted in the
+ * pieces on stack. The pixels of color key keep the destination.
+ */
+static void _dc_buffer_blit_buffer(struct rtgui_dc_buffer* dc, struct rtgui_point* dc_point,
+	struct rtgui_dc_buffer* dest, rtgui_rect_t* rect)
+{
+	rtgui_rect_t clip_rect;
+	rtgui_blit_line_func blit_line;
+	rt_uint8_t piece[BLEND_PIECE * sizeof(rtgui_color_t)], scratch[BLEND_PIECE];
+	rt_uint8_t *line;
+	int x, y, sx, sy, run, count, width;
+
+	/* keep it in the destination buffer */
+	clip_rect.x1 = clip_rect.y1 = 0;
+	clip_rect.x2 = dest->width;
+	clip_rect.y2 = dest->height;
+	rtgui_rect_intersect(rect, &clip_rect);
+	if (clip_rect.x1 >= clip_rect.x2 || clip_rect.y1 >= clip_rect.y2) return;
+
+	blit_line = RT_NULL;
+	if (dc->pixel_format != dest->pixel_format)
+	{
+		blit_line = rtgui_blit_line_get_format(dest->pixel_format, dc->pixel_format);
+		if (blit_line == RT_NULL) return;
+	}
 
-	/* restore foreground color */
-	RTGUI_DC_FC(self) = foreground;
+	sx = dc_point->x + clip_rect.x1 - rect->x1;
+	sy = dc_point->y + clip_rect.y1 - rect->y1;
+	width = clip_rect.x2 - clip_rect.x1;
+	for (y = clip_rect.y1; y < clip_rect.y2; y ++, sy ++)
+	{
+		for (x = 0; x < width; x += count)
+		{
+			x += _dc_buffer_next_run(dc, sx + x, sy, width - x, &run);
+			if (run == 0) break;
+
+			/* the whole run is copied if it needs neither piece nor scratch */
+			count = run;
+			if (count > BLEND_PIECE && (blit_line != RT_NULL || dc->bits_per_pixel < 8))
+				count = BLEND_PIECE;
+
+			line = _dc_buffer_get_line(dc, sx + x, sy, count, scratch);
+			if (blit_line != RT_NULL)
+			{
+				blit_line(piece, line, count);
+				line = piece;
+			}
+			_dc_buffer_put_line(dest, clip_rect.x1 + x, y, line, count);
+		}
+	}
 }
 
-/* blit a dc to a hardware dc */
+/* blit a dc to a hardware, client or buffer dc */
 static void rtgui_dc_buffer_blit(struct rtgui_dc* self, struct rtgui_point* dc_point, struct rtgui_dc* dest, rtgui_rect_t* rect)
 {
 	struct rtgui_dc_buffer* dc = (struct rtgui_dc_buffer*)self;
+	struct rtgui_point point;
+	rt_uint8_t *line_ptr, *pixels;
+	rt_uint16_t rect_width, rect_height, index, pitch;
+	rtgui_blit_line_func blit_line;
+	rtgui_rect_t blit_rect;
 
 	if (dc_point == RT_NULL) dc_point = &rtgui_empty_point;
 	if (rtgui_dc_get_visible(dest) == RT_FALSE) return;
+	/* the lines are copied forward, they can't overlap in one buffer */
+	if (dest == self) return;
 
-	if ((dest->type == RTGUI_DC_HW) || (dest->type == RTGUI_DC_CLIENT))
+	/* clip the source rect in buffer, and move the destination rect with it */
+	point = *dc_point;
+	blit_rect = *rect;
+	if (point.x < 0)
 	{
-		rt_uint8_t *line_ptr, *pixels;
-		rt_uint16_t rect_width, rect_height, index, pitch;
-		rtgui_blit_line_func blit_line;
+		blit_rect.x1 -= point.x;
+		point.x = 0;
+	}
+	if (point.y < 0)
+	{
+		blit_rect.y1 -= point.y;
+		point.y = 0;
+	}
+	if (blit_rect.x2 - blit_rect.x1 > dc->width - point.x)
+		blit_rect.x2 = blit_rect.x1 + dc->width - point.x;
+	if (blit_rect.y2 - blit_rect.y1 > dc->height - point.y)
+		blit_rect.y2 = blit_rect.y1 + dc->height - point.y;
+	if (blit_rect.x1 >= blit_rect.x2 || blit_rect.y1 >= blit_rect.y2) return;
 
-		/* calculate correct width and height */
-		if (rtgui_rect_width(*rect) > (dc->width - dc_point->x))
-			rect_width = dc->width - dc_point->x;
-		else
-			rect_width = rtgui_rect_width(*rect);
+	dc_point = &point;
+	rect_width  = rtgui_rect_width(blit_rect);
+	rect_height = rtgui_rect_height(blit_rect);
 
-		if (rtgui_rect_height(*rect) > (dc->height - dc_point->y))
-			rect_height = dc->height - dc_point->y;
-		else
-			rect_height = rtgui_rect_height(*rect);
+	/* prepare pixel line */
+	pixels = BUFFER_PIXEL(dc, dc_point->x, dc_point->y);
 
-		/* prepare pixel line */
-		pixels = dc->pixel + dc_point->y * dc->pitch + dc_point->x * sizeof(rtgui_color_t);
+	if (dc->blend_mode != RTGUI_BLENDMODE_NONE)
+	{
+		/* the blended buffer is in ARGB888 */
+		rtgui_dc_blend_pixels(dest, pixels, dc->pitch, &blit_rect, dc->blend_mode);
+		return;
+	}
 
-		if (hw_driver->bits_per_pixel == sizeof(rtgui_color_t) * 8)
+	if (dest->type == RTGUI_DC_BUFFER)
+	{
+		_dc_buffer_blit_buffer(dc, dc_point, (struct rtgui_dc_buffer*)dest, &blit_rect);
+		return;
+	}
+
+	if ((dest->type == RTGUI_DC_HW) || (dest->type == RTGUI_DC_CLIENT))
+	{
+		/* the rect of packed pixels can't be clipped in byte, the color key is skipped in line */
+		if (hw_driver->ops->blit_rect != RT_NULL && hw_driver->bits_per_pixel >= 8 &&
+			dc->bits_per_pixel >= 8 && dc->key_enable == RT_FALSE)
 		{
-			/* it's the same byte per pixel, draw it directly */
-			for (index = rect->y1; index < rect->y1 + rect_height; index++)
+			if (dc->pixel_format == hw_driver->pixel_format)
 			{
-				dest->engine->blit_line(dest, rect->x1, rect->x1 + rect_width, index, pixels);
-				pixels += dc->width * sizeof(rtgui_color_t);
+				/* it's the same pixel format, blit the buffer directly */
+				rtgui_dc_buffer_blit_rect(dest, pixels, dc->pitch, &blit_rect);
+				return;
 			}
+
+			/*
+			 * convert the rect to device pixels and blit it at once by the
+			 * accelerator, the framebuffer is faster in line.
+			 */
+			pitch = rect_width * hw_driver->bits_per_pixel/8;
+			if (hw_driver->ext_ops != RT_NULL && hw_driver->ext_ops->blit_rect != RT_NULL)
+				line_ptr = (rt_uint8_t*) rtgui_malloc(pitch * rect_height);
+			else
+				line_ptr = RT_NULL;
+			blit_line = rtgui_blit_line_get_format(hw_driver->pixel_format, dc->pixel_format);
+			if (line_ptr != RT_NULL && blit_line != RT_NULL)
+			{
+				for (index = 0; index < rect_height; index ++)
+				{
+					blit_line(line_ptr + index * pitch, pixels, rect_width);
+					pixels += dc->pitch;
+				}
+
+				rtgui_dc_buffer_blit_rect(dest, line_ptr, pitch, &blit_rect);
+				rtgui_free(line_ptr);
+				return;
+			}
+			if (line_ptr != RT_NULL) rtgui_free(line_ptr);
 		}
-		else
+
+		if (dc->pixel_format == hw_driver->pixel_format)
 		{
-			/* get blit line function */
-			blit_line = rtgui_blit_line_get(hw_driver->bits_per_pixel/8, 4);
-			/* calculate pitch */
-			pitch = rect_width * sizeof(rtgui_color_t);
-			/* create line buffer */
-			line_ptr = (rt_uint8_t*) rtgui_malloc(rect_width * hw_driver->bits_per_pixel/8);
-
-			/* draw each line */
-			for (index = rect->y1; index < rect->y1 + rect_height; index ++)
+			/* it's the same pixel format, draw it directly */
+			line_ptr = RT_NULL;
+			if (dc->bits_per_pixel < 8)
 			{
-				/* blit on line buffer */
-				blit_line(line_ptr, (rt_uint8_t*)pixels, pitch);
-				pixels += dc->width * sizeof(rtgui_color_t);
-
-				/* draw on hardware dc */
-				dest->engine->blit_line(dest, rect->x1, rect->x1 + rect_width, index, line_ptr);
+				/* the scratch line of packed pixels */
+				line_ptr = rtgui_application_get_scratch(BUFFER_LINE_SIZE(dc->bits_per_pixel, rect_width));
+				if (line_ptr == RT_NULL) return;
 			}
 
-			/* release line buffer */
-			rtgui_free(line_ptr);
+			rtgui_dc_buffer_blit_lines(dest, dc, dc_point, &blit_rect, RT_NULL, RT_NULL, line_ptr);
+		}
+		else
+		{
+			/* get blit line function */
+			blit_line = rtgui_blit_line_get_format(hw_driver->pixel_format, dc->pixel_format);
+			if (blit_line == RT_NULL) return;
+			/* get line buffer, and the scratch line of packed pixels after it */
+			pitch = BUFFER_LINE_SIZE(hw_driver->bits_per_pixel, rect_width);
+			line_ptr = rtgui_application_get_scratch(pitch + BUFFER_LINE_SIZE(dc->bits_per_pixel, rect_width));
+			if (line_ptr == RT_NULL) return;
+
+			rtgui_dc_buffer_blit_lines(dest, dc, dc_point, &blit_rect, blit_line, line_ptr, line_ptr + pitch);
 		}
+
+		/* release line buffer */
+		rtgui_application_put_scratch(line_ptr);
 	}
 }
 
+/* the line_data is in the pixel format of buffer */
 static void rtgui_dc_buffer_blit_line(struct rtgui_dc* self, int x1, int x2, int y, rt_uint8_t* line_data)
 {
-	rtgui_color_t* color_ptr;
 	struct rtgui_dc_buffer* dc = (struct rtgui_dc_buffer*)self;
 
 	RT_ASSERT(dc != RT_NULL);
 	RT_ASSERT(line_data != RT_NULL);
 
 	/* out of range */
-	if ((x1 > dc->width) || (y > dc->height)) return;
+	if ((rt_uint16_t)x1 >= dc->width || (rt_uint16_t)y >= dc->height) return;
 	/* check range */
 	if (x2 > dc->width) x2 = dc->width;
 
-	color_ptr = (rtgui_color_t*)(dc->pixel + y * dc->pitch + x1 * sizeof(rtgui_color_t));
-	rt_memcpy(color_ptr, line_data, (x2 - x1) * sizeof(rtgui_color_t));
+	if (x1 < x2) _dc_buffer_put_line(dc, x1, y, line_data, x2 - x1);
 }
 
 static void rtgui_dc_buffer_set_gc(struct rtgui_dc* self, rtgui_gc_t *gc)
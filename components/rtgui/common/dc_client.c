@@ -34,6 +34,9 @@ static void rtgui_dc_client_draw_vline(struct rtgui_dc* dc, int x, int y1, int y
 static void rtgui_dc_client_fill_rect (struct rtgui_dc* dc, rtgui_rect_t* rect);
 static void rtgui_dc_client_blit_line (struct rtgui_dc* self, int x1, int x2, int y, rt_uint8_t* line_data);
 static void rtgui_dc_client_blit	  (struct rtgui_dc* dc, struct rtgui_point* dc_point, struct rtgui_dc* dest, rtgui_rect_t* rect);
+static void rtgui_dc_client_draw_points(struct rtgui_dc* dc, struct rtgui_point* points, int count);
+static void rtgui_dc_client_draw_color_points(struct rtgui_dc* dc, struct rtgui_point* points, rtgui_color_t* colors, int count);
+static void rtgui_dc_client_draw_spans(struct rtgui_dc* dc, struct rtgui_span* spans, int count);
 static void rtgui_dc_client_set_gc (struct rtgui_dc* dc, rtgui_gc_t *gc);
 static rtgui_gc_t *rtgui_dc_client_get_gc (struct rtgui_dc* dc);
 static rt_bool_t rtgui_dc_client_fini(struct rtgui_dc* dc);
@@ -44,6 +47,121 @@ static void rtgui_dc_client_get_rect(struct rtgui_dc* dc, rtgui_rect_t* rect);
 #define dc_set_foreground(c) 	dc->gc.foreground = c
 #define dc_set_background(c) 	dc->gc.background = c
 #define _int_swap(x, y)			do {x ^= y; y ^= x; x ^= y;} while (0)
+/* the bytes of packed raw line shifted on stack */
+#define DC_CLIENT_PIECE			32
+
+/* draw in the foreground of gc, which is mapped to device pixel once if driver supports */
+rt_inline void _dc_client_set_pixel(rtgui_widget_t *owner, int x, int y)
+{
+	const struct rtgui_graphic_driver_ops *ops = hw_driver->ops;
+
+	if (ops->map_color != RT_NULL)
+		ops->set_pixel_native(rtgui_gc_fc_pixel(&(owner->gc), ops), x, y);
+	else
+		ops->set_pixel(&(owner->gc.foreground), x, y);
+}
+
+rt_inline void _dc_client_draw_hline(rtgui_widget_t *owner, int x1, int x2, int y)
+{
+	const struct rtgui_graphic_driver_ops *ops = hw_driver->ops;
+
+	if (ops->map_color != RT_NULL)
+		ops->draw_hline_native(rtgui_gc_fc_pixel(&(owner->gc), ops), x1, x2, y);
+	else
+		ops->draw_hline(&(owner->gc.foreground), x1, x2, y);
+}
+
+rt_inline void _dc_client_draw_vline(rtgui_widget_t *owner, int x, int y1, int y2)
+{
+	const struct rtgui_graphic_driver_ops *ops = hw_driver->ops;
+
+	if (ops->map_color != RT_NULL)
+		ops->draw_vline_native(rtgui_gc_fc_pixel(&(owner->gc), ops), x, y1, y2);
+	else
+		ops->draw_vline(&(owner->gc.foreground), x, y1, y2);
+}
+
+/*
+ * the clip rects in the band of line y. The batch of points and spans in the
+ * same line looks the band up once.
+ */
+struct _dc_client_band
+{
+	int y;
+	rtgui_rect_t *start, *end;
+};
+
+rt_inline rtgui_rect_t *_dc_client_band_get(rtgui_widget_t *owner, struct _dc_client_band *band, int y)
+{
+	if (band->start == RT_NULL || band->y != y)
+	{
+		band->start = rtgui_region_find_band(&(owner->clip), y, &(band->end));
+		band->y = y;
+	}
+
+	return band->start;
+}
+
+static rt_bool_t _dc_client_band_contains(rtgui_widget_t *owner, struct _dc_client_band *band, int x, int y)
+{
+	rtgui_rect_t *prect;
+
+	for (prect = _dc_client_band_get(owner, band, y);
+		prect < band->end && prect->y1 <= y && prect->x1 <= x; prect ++)
+	{
+		if (x < prect->x2) return RT_TRUE;
+	}
+
+	return RT_FALSE;
+}
+
+/* whether (x, y) of device is in the clip, only the band of y is walked */
+rt_inline rt_bool_t _dc_client_clip_contains(rtgui_widget_t *owner, int x, int y)
+{
+	struct _dc_client_band band = {0, RT_NULL, RT_NULL};
+
+	return _dc_client_band_contains(owner, &band, x, y);
+}
+
+/*
+ * draw the raw line from the pixel of offset. The packed pixels which are not
+ * on byte boundary are shifted to the first byte on stack: the left pixel of
+ * mono is in the least significant bit, and of gray is in the most one.
+ */
+static void _dc_client_draw_raw_hline(rt_uint8_t *pixels, int offset, int x1, int x2, int y)
+{
+	rt_uint8_t line[DC_CLIENT_PIECE];
+	rt_uint8_t *src;
+	int bits, shift, count, bytes, index, last;
+	const struct rtgui_graphic_driver *driver = hw_driver;
+
+	bits = offset * driver->bits_per_pixel;
+	if ((bits & 0x07) == 0)
+	{
+		driver->ops->draw_raw_hline(pixels + bits / 8, x1, x2, y);
+		return;
+	}
+
+	/* the source bytes of the rest pixels */
+	shift = bits & 0x07;
+	src = pixels + bits / 8;
+	last = ((x2 - x1) * driver->bits_per_pixel + shift + 7) / 8 - 1;
+	for (; x1 < x2; x1 += count, src += bytes, last -= bytes)
+	{
+		count = DC_CLIENT_PIECE * 8 / driver->bits_per_pixel;
+		if (count > x2 - x1) count = x2 - x1;
+		bytes = (count * driver->bits_per_pixel + 7) / 8;
+
+		for (index = 0; index < bytes; index ++)
+		{
+			if (driver->pixel_format == RTGRAPHIC_PIXEL_FORMAT_MONO)
+				line[index] = (src[index] >> shift) | (index < last? src[index + 1] << (8 - shift) : 0);
+			else
+				line[index] = (src[index] << shift) | (index < last? src[index + 1] >> (8 - shift) : 0);
+		}
+		driver->ops->draw_raw_hline(line, x1, x1 + count, y);
+	}
+}
 
 struct rtgui_dc* rtgui_dc_begin_drawing(rtgui_widget_t* owner)
 {
@@ -71,6 +189,10 @@ const struct rtgui_dc_engine dc_client_engine =
 	rtgui_dc_client_blit_line,
 	rtgui_dc_client_blit,
 
+	rtgui_dc_client_draw_points,
+	rtgui_dc_client_draw_color_points,
+	rtgui_dc_client_draw_spans,
+
 	rtgui_dc_client_set_gc,
 	rtgui_dc_client_get_gc,
 
@@ -97,28 +219,17 @@ extern void rtgui_mouse_hide_cursor(void);
 struct rtgui_dc* rtgui_dc_client_create(rtgui_widget_t* owner)
 {
 	struct rtgui_dc* dc;
-	rtgui_widget_t* widget;
 
 	/* adjudge owner */
 	if (owner == RT_NULL || owner->toplevel == RT_NULL) return RT_NULL;
 	if (!RTGUI_IS_TOPLEVEL(owner->toplevel)) return RT_NULL;
 
-	dc = RTGUI_WIDGET_DC(owner);
-	/* set init visible as true */
-	RTGUI_WIDGET_DC_SET_VISIBLE(owner);
-
-	/* check widget visible */
-	widget = owner;
-	while (widget != RT_NULL)
-	{
-		if (RTGUI_WIDGET_IS_HIDE(widget))
-		{
-			RTGUI_WIDGET_DC_SET_UNVISIBLE(owner);
-			return RT_NULL;
-		}
+	/* check widget visible, it's cached until the widgets are changed */
+	if (rtgui_widget_check_dc_visible(owner) == RT_FALSE) return RT_NULL;
 
-		widget = widget->parent;
-	}
+	/* the hardware dc may be used in the same place */
+	rtgui_dc_client_init(owner);
+	dc = RTGUI_WIDGET_DC(owner);
 
 	if (RTGUI_IS_WINTITLE(owner->toplevel))
 	{
@@ -179,6 +290,10 @@ static rt_bool_t rtgui_dc_client_fini(struct rtgui_dc* dc)
 	/* get owner */
 	owner = RTGUI_CONTAINER_OF(dc, struct rtgui_widget, dc_type);
 
+	/* write the pixels buffered by driver */
+	if (hw_driver->ops->flush != RT_NULL)
+		hw_driver->ops->flush();
+
 	if (RTGUI_IS_WINTITLE(owner->toplevel))
 	{
 		/* update title extent */
@@ -243,7 +358,6 @@ static rt_bool_t rtgui_dc_client_fini(struct rtgui_dc* dc)
  */
 static void rtgui_dc_client_draw_point(struct rtgui_dc* self, int x, int y)
 {
-	rtgui_rect_t rect;
 	rtgui_widget_t *owner;
 
 	if (self == RT_NULL) return;
@@ -255,16 +369,15 @@ static void rtgui_dc_client_draw_point(struct rtgui_dc* self, int x, int y)
 	x = x + owner->extent.x1;
 	y = y + owner->extent.y1;
 
-	if (rtgui_region_contains_point(&(owner->clip), x, y, &rect) == RT_EOK)
+	if (_dc_client_clip_contains(owner, x, y) == RT_TRUE)
 	{
 		/* draw this point */
-		hw_driver->ops->set_pixel(&(owner->gc.foreground), x, y);
+		_dc_client_set_pixel(owner, x, y);
 	}
 }
 
 static void rtgui_dc_client_draw_color_point(struct rtgui_dc* self, int x, int y, rtgui_color_t color)
 {
-	rtgui_rect_t rect;
 	rtgui_widget_t *owner;
 
 	if (self == RT_NULL) return;
@@ -276,7 +389,7 @@ static void rtgui_dc_client_draw_color_point(struct rtgui_dc* self, int x, int y
 	x = x + owner->extent.x1;
 	y = y + owner->extent.y1;
 
-	if (rtgui_region_contains_point(&(owner->clip), x, y, &rect) == RT_EOK)
+	if (_dc_client_clip_contains(owner, x, y) == RT_TRUE)
 	{
 		/* draw this point */
 		hw_driver->ops->set_pixel(&color, x, y);
@@ -288,7 +401,7 @@ static void rtgui_dc_client_draw_color_point(struct rtgui_dc* self, int x, int y
  */
 static void rtgui_dc_client_draw_vline(struct rtgui_dc* self, int x, int y1, int y2)
 {
-	register rt_base_t index;
+	rtgui_rect_t *prect, *end;
 	rtgui_widget_t *owner;
 
 	if (self == RT_NULL) return;
@@ -302,40 +415,15 @@ static void rtgui_dc_client_draw_vline(struct rtgui_dc* self, int x, int y1, int
 	y2 = y2 + owner->extent.y1;
 	if (y1 > y2) _int_swap(y1, y2);
 
-	if (owner->clip.data == RT_NULL)
-	{
-		rtgui_rect_t* prect;
-
-		prect = &(owner->clip.extents);
-
-		/* calculate vline intersect */
-		if (prect->x1 > x   || prect->x2 <= x) return;
-		if (prect->y2 <= y1 || prect->y1 > y2) return;
-
-		if (prect->y1 > y1) y1 = prect->y1;
-		if (prect->y2 < y2) y2 = prect->y2;
-
-		/* draw vline */
-		hw_driver->ops->draw_vline(&(owner->gc.foreground), x, y1, y2);
-	}
-	else for (index = 0; index < rtgui_region_num_rects(&(owner->clip)); index ++)
+	/* walk the bands from y1 to y2 */
+	for (prect = rtgui_region_find_band(&(owner->clip), y1, &end);
+		prect < end && prect->y1 < y2; prect ++)
 	{
-		rtgui_rect_t* prect;
-		register rt_base_t draw_y1, draw_y2;
-
-		prect = ((rtgui_rect_t *)(owner->clip.data + index + 1));
-		draw_y1 = y1;
-		draw_y2 = y2;
-
 		/* calculate vline clip */
-		if (prect->x1 > x   || prect->x2 <= x) continue;
-		if (prect->y2 <= y1 || prect->y1 > y2) continue;
-
-		if (prect->y1 > y1) draw_y1 = prect->y1;
-		if (prect->y2 < y2) draw_y2 = prect->y2;
+		if (prect->x1 > x || prect->x2 <= x) continue;
 
 		/* draw vline */
-		hw_driver->ops->draw_vline(&(owner->gc.foreground), x, draw_y1, draw_y2);
+		_dc_client_draw_vline(owner, x, prect->y1 > y1? prect->y1 : y1, prect->y2 < y2? prect->y2 : y2);
 	}
 }
 
@@ -344,7 +432,7 @@ static void rtgui_dc_client_draw_vline(struct rtgui_dc* self, int x, int y1, int
  */
 static void rtgui_dc_client_draw_hline(struct rtgui_dc* self, int x1, int x2, int y)
 {
-	register rt_base_t index;
+	rtgui_rect_t *prect, *end;
 	rtgui_widget_t *owner;
 
 	if (self == RT_NULL) return;
@@ -359,46 +447,23 @@ static void rtgui_dc_client_draw_hline(struct rtgui_dc* self, int x1, int x2, in
 	if (x1 > x2) _int_swap(x1, x2);
 	y  = y + owner->extent.y1;
 
-	if (owner->clip.data == RT_NULL)
+	/* the rects of band are sorted in x */
+	for (prect = rtgui_region_find_band(&(owner->clip), y, &end);
+		prect < end && prect->y1 <= y && prect->x1 < x2; prect ++)
 	{
-		rtgui_rect_t* prect;
-
-		prect = &(owner->clip.extents);
-
-		/* calculate vline intersect */
-		if (prect->y1 > y  || prect->y2 <= y ) return;
-		if (prect->x2 <= x1 || prect->x1 > x2) return;
-
-		if (prect->x1 > x1) x1 = prect->x1;
-		if (prect->x2 < x2) x2 = prect->x2;
-
-		/* draw hline */
-		hw_driver->ops->draw_hline(&(owner->gc.foreground), x1, x2, y);
-	}
-	else for (index = 0; index < rtgui_region_num_rects(&(owner->clip)); index ++)
-	{
-		rtgui_rect_t* prect;
-		register rt_base_t draw_x1, draw_x2;
-
-		prect = ((rtgui_rect_t *)(owner->clip.data + index + 1));
-		draw_x1 = x1;
-		draw_x2 = x2;
-
 		/* calculate hline clip */
-		if (prect->y1 > y  || prect->y2 <= y ) continue;
-		if (prect->x2 <= x1 || prect->x1 > x2) continue;
-
-		if (prect->x1 > x1) draw_x1 = prect->x1;
-		if (prect->x2 < x2) draw_x2 = prect->x2;
+		if (prect->x2 <= x1) continue;
 
 		/* draw hline */
-		hw_driver->ops->draw_hline(&(owner->gc.foreground), draw_x1, draw_x2, y);
+		_dc_client_draw_hline(owner, prect->x1 > x1? prect->x1 : x1, prect->x2 < x2? prect->x2 : x2, y);
 	}
 }
 
 static void rtgui_dc_client_fill_rect (struct rtgui_dc* self, struct rtgui_rect* rect)
 {
 	rtgui_color_t foreground;
+	rtgui_rect_t device_rect, draw_rect;
+	rtgui_rect_t *prect, *end;
 	register rt_base_t index;
 	rtgui_widget_t *owner;
 
@@ -408,16 +473,36 @@ static void rtgui_dc_client_fill_rect (struct rtgui_dc* self, struct rtgui_rect*
 	owner = RTGUI_CONTAINER_OF(self, struct rtgui_widget, dc_type);
 	if (!RTGUI_WIDGET_IS_DC_VISIBLE(owner)) return;
 
+	/* convert logic to device */
+	device_rect = *rect;
+	rtgui_rect_moveto(&device_rect, owner->extent.x1, owner->extent.y1);
+
 	/* save foreground color */
 	foreground = owner->gc.foreground;
 
 	/* set background color as foreground color */
 	owner->gc.foreground = owner->gc.background;
 
-	/* fill rect */
-	for (index = rect->y1; index < rect->y2; index ++)
+	/*
+	 * intersect the rect with each clip rect of the bands it covers once, and
+	 * fill the whole intersection by driver.
+	 */
+	for (prect = rtgui_region_find_band(&(owner->clip), device_rect.y1, &end);
+		prect < end && prect->y1 < device_rect.y2; prect ++)
 	{
-		rtgui_dc_client_draw_hline(self, rect->x1, rect->x2, index);
+		draw_rect = device_rect;
+		rtgui_rect_intersect(prect, &draw_rect);
+		if (draw_rect.x1 >= draw_rect.x2 || draw_rect.y1 >= draw_rect.y2) continue;
+
+		if (hw_driver->ops->fill_rect != RT_NULL)
+		{
+			hw_driver->ops->fill_rect(&(owner->gc.background), &draw_rect);
+		}
+		else
+		{
+			for (index = draw_rect.y1; index < draw_rect.y2; index ++)
+				_dc_client_draw_hline(owner, draw_rect.x1, draw_rect.x2, index);
+		}
 	}
 
 	/* restore foreground color */
@@ -426,7 +511,7 @@ static void rtgui_dc_client_fill_rect (struct rtgui_dc* self, struct rtgui_rect*
 
 static void rtgui_dc_client_blit_line (struct rtgui_dc* self, int x1, int x2, int y, rt_uint8_t* line_data)
 {
-	register rt_base_t index;
+	rtgui_rect_t *prect, *end;
 	rtgui_widget_t *owner;
 
 	if (self == RT_NULL) return;
@@ -441,45 +526,20 @@ static void rtgui_dc_client_blit_line (struct rtgui_dc* self, int x1, int x2, in
 	if (x1 > x2) _int_swap(x1, x2);
 	y  = y + owner->extent.y1;
 
-	if (rtgui_region_is_flat(&(owner->clip)) == RT_EOK)
+	/* the rects of band are sorted in x */
+	for (prect = rtgui_region_find_band(&(owner->clip), y, &end);
+		prect < end && prect->y1 <= y && prect->x1 < x2; prect ++)
 	{
-		rtgui_rect_t* prect;
-		int offset = 0;
-		prect = &(owner->clip.extents);
-
-		/* calculate vline intersect */
-		if (prect->y1 > y  || prect->y2 <= y ) return;
-		if (prect->x2 <= x1 || prect->x1 > x2) return;
-
-		if (prect->x1 > x1) x1 = prect->x1;
-		if (prect->x2 < x2) x2 = prect->x2;
-
-		/* patch note: 
-		 * We need to adjust the offset when update widget clip!
-		 * Of course at ordinary times for 0. General */
-		offset = owner->clip.extents.x1 - owner->extent.x1;
-		offset = offset * hw_driver->bits_per_pixel/8;
-		/* draw hline */
-		hw_driver->ops->draw_raw_hline(line_data+offset, x1, x2, y);
-	}
-	else for (index = 0; index < rtgui_region_num_rects(&(owner->clip)); index ++)
-	{
-		rtgui_rect_t* prect;
 		register rt_base_t draw_x1, draw_x2;
 
-		prect = ((rtgui_rect_t *)(owner->clip.data + index + 1));
-		draw_x1 = x1;
-		draw_x2 = x2;
-
 		/* calculate hline clip */
-		if (prect->y1 > y  || prect->y2 <= y ) continue;
-		if (prect->x2 <= x1 || prect->x1 > x2) continue;
+		if (prect->x2 <= x1) continue;
 
-		if (prect->x1 > x1) draw_x1 = prect->x1;
-		if (prect->x2 < x2) draw_x2 = prect->x2;
+		draw_x1 = prect->x1 > x1? prect->x1 : x1;
+		draw_x2 = prect->x2 < x2? prect->x2 : x2;
 
-		/* draw hline */
-		hw_driver->ops->draw_raw_hline(line_data + (draw_x1 - x1) * hw_driver->bits_per_pixel/8, draw_x1, draw_x2, y);
+		/* draw the pixels from draw_x1 of line */
+		_dc_client_draw_raw_hline(line_data, draw_x1 - x1, draw_x1, draw_x2, y);
 	}
 }
 
@@ -489,6 +549,89 @@ static void rtgui_dc_client_blit(struct rtgui_dc* dc, struct rtgui_point* dc_poi
 	return ;
 }
 
+/*
+ * draw a batch of logic points on device
+ */
+static void rtgui_dc_client_draw_points(struct rtgui_dc* self, struct rtgui_point* points, int count)
+{
+	struct _dc_client_band band = {0, RT_NULL, RT_NULL};
+	rtgui_widget_t *owner;
+	int x, y;
+
+	if (self == RT_NULL) return;
+
+	/* get owner */
+	owner = RTGUI_CONTAINER_OF(self, struct rtgui_widget, dc_type);
+	if (!RTGUI_WIDGET_IS_DC_VISIBLE(owner)) return;
+
+	for (; count > 0; count --, points ++)
+	{
+		x = points->x + owner->extent.x1;
+		y = points->y + owner->extent.y1;
+
+		if (_dc_client_band_contains(owner, &band, x, y) == RT_TRUE)
+			_dc_client_set_pixel(owner, x, y);
+	}
+}
+
+static void rtgui_dc_client_draw_color_points(struct rtgui_dc* self, struct rtgui_point* points,
+	rtgui_color_t* colors, int count)
+{
+	struct _dc_client_band band = {0, RT_NULL, RT_NULL};
+	rtgui_widget_t *owner;
+	int x, y;
+
+	if (self == RT_NULL) return;
+
+	/* get owner */
+	owner = RTGUI_CONTAINER_OF(self, struct rtgui_widget, dc_type);
+	if (!RTGUI_WIDGET_IS_DC_VISIBLE(owner)) return;
+
+	for (; count > 0; count --, points ++, colors ++)
+	{
+		x = points->x + owner->extent.x1;
+		y = points->y + owner->extent.y1;
+
+		if (_dc_client_band_contains(owner, &band, x, y) == RT_TRUE)
+			hw_driver->ops->set_pixel(colors, x, y);
+	}
+}
+
+/*
+ * draw a batch of logic horizontal spans on device
+ */
+static void rtgui_dc_client_draw_spans(struct rtgui_dc* self, struct rtgui_span* spans, int count)
+{
+	struct _dc_client_band band = {0, RT_NULL, RT_NULL};
+	rtgui_rect_t *prect;
+	rtgui_widget_t *owner;
+	int x1, x2, y;
+
+	if (self == RT_NULL) return;
+
+	/* get owner */
+	owner = RTGUI_CONTAINER_OF(self, struct rtgui_widget, dc_type);
+	if (!RTGUI_WIDGET_IS_DC_VISIBLE(owner)) return;
+
+	for (; count > 0; count --, spans ++)
+	{
+		/* convert logic to device */
+		x1 = spans->x1 + owner->extent.x1;
+		x2 = spans->x2 + owner->extent.x1;
+		if (x1 > x2) _int_swap(x1, x2);
+		y  = spans->y + owner->extent.y1;
+
+		/* the rects of band are sorted in x */
+		for (prect = _dc_client_band_get(owner, &band, y);
+			prect < band.end && prect->y1 <= y && prect->x1 < x2; prect ++)
+		{
+			if (prect->x2 <= x1) continue;
+
+			_dc_client_draw_hline(owner, prect->x1 > x1? prect->x1 : x1, prect->x2 < x2? prect->x2 : x2, y);
+		}
+	}
+}
+
 static void rtgui_dc_client_set_gc(struct rtgui_dc* self, rtgui_gc_t *gc)
 {
 	rtgui_widget_t *owner;
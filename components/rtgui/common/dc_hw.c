@@ -29,18 +29,17 @@ static void rtgui_dc_hw_draw_vline(struct rtgui_dc* dc, int x, int y1, int y2);
 static void rtgui_dc_hw_fill_rect (struct rtgui_dc* dc, rtgui_rect_t* rect);
 static void rtgui_dc_hw_blit_line (struct rtgui_dc* self, int x1, int x2, int y, rt_uint8_t* line_data);
 static void rtgui_dc_hw_blit	  (struct rtgui_dc* dc, struct rtgui_point* dc_point, struct rtgui_dc* dest, rtgui_rect_t* rect);
+static void rtgui_dc_hw_draw_points(struct rtgui_dc* dc, struct rtgui_point* points, int count);
+static void rtgui_dc_hw_draw_color_points(struct rtgui_dc* dc, struct rtgui_point* points, rtgui_color_t* colors, int count);
+static void rtgui_dc_hw_draw_spans(struct rtgui_dc* dc, struct rtgui_span* spans, int count);
 static void rtgui_dc_hw_set_gc (struct rtgui_dc* dc, rtgui_gc_t *gc);
 static rtgui_gc_t *rtgui_dc_hw_get_gc (struct rtgui_dc* dc);
 static rt_bool_t rtgui_dc_hw_fini(struct rtgui_dc* dc);
 static rt_bool_t rtgui_dc_hw_get_visible(struct rtgui_dc* dc);
 static void rtgui_dc_hw_get_rect(struct rtgui_dc* dc, rtgui_rect_t* rect);
 
-struct rtgui_dc_hw
-{
-	struct rtgui_dc parent;
-	rtgui_widget_t *owner;
-	const struct rtgui_graphic_driver* hw_driver;
-};
+#define hw_driver				(rtgui_graphic_driver_get_default())
+#define _int_swap(x, y)			do {x ^= y; y ^= x; x ^= y;} while (0)
 
 const struct rtgui_dc_engine dc_hw_engine = 
 {
@@ -52,6 +51,10 @@ const struct rtgui_dc_engine dc_hw_engine =
 	rtgui_dc_hw_blit_line,
 	rtgui_dc_hw_blit,
 
+	rtgui_dc_hw_draw_points,
+	rtgui_dc_hw_draw_color_points,
+	rtgui_dc_hw_draw_spans,
+
 	rtgui_dc_hw_set_gc,
 	rtgui_dc_hw_get_gc,
 
@@ -66,37 +69,19 @@ extern void rtgui_mouse_show_cursor(void);
 extern void rtgui_mouse_hide_cursor(void);
 struct rtgui_dc* rtgui_dc_hw_create(rtgui_widget_t* owner)
 {
-	struct rtgui_dc_hw* dc;
-	rtgui_widget_t* widget;
+	struct rtgui_dc* dc;
 
 	/* adjudge owner */
 	if (owner == RT_NULL || owner->toplevel == RT_NULL) return RT_NULL;
 	if (!RTGUI_IS_TOPLEVEL(owner->toplevel)) return RT_NULL;
 
-	/* set init visible as true */
-	RTGUI_WIDGET_DC_SET_VISIBLE(owner);
+	/* check widget visible, it's cached until the widgets are changed */
+	if (rtgui_widget_check_dc_visible(owner) == RT_FALSE) return RT_NULL;
 
-	/* check widget visible */
-	widget = owner;
-	while (widget != RT_NULL)
-	{
-		if (RTGUI_WIDGET_IS_HIDE(widget))
-		{
-			RTGUI_WIDGET_DC_SET_UNVISIBLE(owner);
-			return RT_NULL;
-		}
-
-		widget = widget->parent;
-	}
-
-	if (!RTGUI_WIDGET_IS_DC_VISIBLE(owner)) return RT_NULL;
-
-	/* create DC */
-	dc = (struct rtgui_dc_hw*) rtgui_malloc(sizeof(struct rtgui_dc_hw));
-	dc->parent.type = RTGUI_DC_HW;
-	dc->parent.engine = &dc_hw_engine;
-	dc->owner = owner;
-	dc->hw_driver = rtgui_graphic_driver_get_default();
+	/* the hardware dc is embedded in owner as client dc */
+	dc = RTGUI_WIDGET_DC(owner);
+	dc->type = RTGUI_DC_HW;
+	dc->engine = &dc_hw_engine;
 
 	if (RTGUI_IS_WINTITLE(owner->toplevel))
 	{
@@ -142,19 +127,21 @@ struct rtgui_dc* rtgui_dc_hw_create(rtgui_widget_t* owner)
 		}
 	}
 
-	return &(dc->parent);
+	return dc;
 }
 
 static rt_bool_t rtgui_dc_hw_fini(struct rtgui_dc* dc)
 {
 	rtgui_widget_t* owner;
-	struct rtgui_dc_hw* self;
 
 	if (dc == RT_NULL || dc->type != RTGUI_DC_HW) return RT_FALSE;
 
-	self = (struct rtgui_dc_hw*)dc;
 	/* get owner */
-	owner = self->owner;
+	owner = RTGUI_CONTAINER_OF(dc, struct rtgui_widget, dc_type);
+
+	/* write the pixels buffered by driver */
+	if (hw_driver->ops->flush != RT_NULL)
+		hw_driver->ops->flush();
 
 	if (RTGUI_IS_WINTITLE(owner->toplevel))
 	{
@@ -172,7 +159,7 @@ static rt_bool_t rtgui_dc_hw_fini(struct rtgui_dc* dc)
 			rt_kprintf("show cursor\n");
 #endif
 			/* update screen */
-			rtgui_graphic_driver_screen_update(self->hw_driver, &(owner->extent));
+			rtgui_graphic_driver_screen_update(hw_driver, &(owner->extent));
 #else
 #ifdef RTGUI_USING_MOUSE_CURSOR
 			/* show cursor */
@@ -180,7 +167,7 @@ static rt_bool_t rtgui_dc_hw_fini(struct rtgui_dc* dc)
 #endif
 
 			/* update screen */
-			rtgui_graphic_driver_screen_update(self->hw_driver, &(owner->extent));
+			rtgui_graphic_driver_screen_update(hw_driver, &(owner->extent));
 #endif
 		}
 	}
@@ -200,7 +187,7 @@ static rt_bool_t rtgui_dc_hw_fini(struct rtgui_dc* dc)
 			rt_kprintf("show cursor\n");
 #endif
 			/* update screen */
-			rtgui_graphic_driver_screen_update(self->hw_driver, &(owner->extent));
+			rtgui_graphic_driver_screen_update(hw_driver, &(owner->extent));
 #else
 			/* send to server to end drawing */
 			struct rtgui_event_update_end eupdate;
@@ -212,9 +199,6 @@ static rt_bool_t rtgui_dc_hw_fini(struct rtgui_dc* dc)
 		}
 	}
 
-	/* release hardware dc */
-	rtgui_free(self);
-
 	return RT_TRUE;
 }
 
@@ -223,35 +207,38 @@ static rt_bool_t rtgui_dc_hw_fini(struct rtgui_dc* dc)
  */
 static void rtgui_dc_hw_draw_point(struct rtgui_dc* self, int x, int y)
 {
-	struct rtgui_dc_hw* dc;
+	rtgui_widget_t *owner;
 
 	RT_ASSERT(self != RT_NULL);
-	dc = (struct rtgui_dc_hw*) self;
+	owner = RTGUI_CONTAINER_OF(self, struct rtgui_widget, dc_type);
 
-	x = x + dc->owner->extent.x1;
+	x = x + owner->extent.x1;
 #if (0) /* Please yourself to decide whether to use it*/
-	if(x < dc->owner->extent.x1 || x >= dc->owner->extent.x2) return;
+	if(x < owner->extent.x1 || x >= owner->extent.x2) return;
 #endif
-	y = y + dc->owner->extent.y1;
+	y = y + owner->extent.y1;
 #if (0)
-	if(y < dc->owner->extent.y1 || y >= dc->owner->extent.y2) return;
+	if(y < owner->extent.y1 || y >= owner->extent.y2) return;
 #endif
 	/* draw this point */
-	dc->hw_driver->ops->set_pixel(&(dc->owner->gc.foreground), x, y);
+	if (hw_driver->ops->map_color != RT_NULL)
+		hw_driver->ops->set_pixel_native(rtgui_gc_fc_pixel(&(owner->gc), hw_driver->ops), x, y);
+	else
+		hw_driver->ops->set_pixel(&(owner->gc.foreground), x, y);
 }
 
 static void rtgui_dc_hw_draw_color_point(struct rtgui_dc* self, int x, int y, rtgui_color_t color)
 {
-	struct rtgui_dc_hw* dc;
+	rtgui_widget_t *owner;
 
 	RT_ASSERT(self != RT_NULL);
-	dc = (struct rtgui_dc_hw*) self;
+	owner = RTGUI_CONTAINER_OF(self, struct rtgui_widget, dc_type);
 
-	x = x + dc->owner->extent.x1;
-	y = y + dc->owner->extent.y1;
+	x = x + owner->extent.x1;
+	y = y + owner->extent.y1;
 
 	/* draw this point */
-	dc->hw_driver->ops->set_pixel(&color, x, y);
+	hw_driver->ops->set_pixel(&color, x, y);
 }
 
 /*
@@ -259,17 +246,20 @@ static void rtgui_dc_hw_draw_color_point(struct rtgui_dc* self, int x, int y, rt
  */
 static void rtgui_dc_hw_draw_vline(struct rtgui_dc* self, int x, int y1, int y2)
 {
-	struct rtgui_dc_hw* dc;
+	rtgui_widget_t *owner;
 
 	RT_ASSERT(self != RT_NULL);
-	dc = (struct rtgui_dc_hw*) self;
+	owner = RTGUI_CONTAINER_OF(self, struct rtgui_widget, dc_type);
 
-	x = x + dc->owner->extent.x1;
-	y1 = y1 + dc->owner->extent.y1;
-	y2 = y2 + dc->owner->extent.y1;
+	x = x + owner->extent.x1;
+	y1 = y1 + owner->extent.y1;
+	y2 = y2 + owner->extent.y1;
 
 	/* draw vline */
-	dc->hw_driver->ops->draw_vline(&(dc->owner->gc.foreground), x, y1, y2);
+	if (hw_driver->ops->map_color != RT_NULL)
+		hw_driver->ops->draw_vline_native(rtgui_gc_fc_pixel(&(owner->gc), hw_driver->ops), x, y1, y2);
+	else
+		hw_driver->ops->draw_vline(&(owner->gc.foreground), x, y1, y2);
 }
 
 /*
@@ -277,55 +267,82 @@ static void rtgui_dc_hw_draw_vline(struct rtgui_dc* self, int x, int y1, int y2)
  */
 static void rtgui_dc_hw_draw_hline(struct rtgui_dc* self, int x1, int x2, int y)
 {
-	struct rtgui_dc_hw* dc;
+	rtgui_widget_t *owner;
 
 	RT_ASSERT(self != RT_NULL);
-	dc = (struct rtgui_dc_hw*) self;
+	owner = RTGUI_CONTAINER_OF(self, struct rtgui_widget, dc_type);
 
 	/* convert logic to device */
-	x1 = x1 + dc->owner->extent.x1;
-	x2 = x2 + dc->owner->extent.x1;
-	y  = y + dc->owner->extent.y1;
+	x1 = x1 + owner->extent.x1;
+	x2 = x2 + owner->extent.x1;
+	y  = y + owner->extent.y1;
 
 	/* draw hline */
-	dc->hw_driver->ops->draw_hline(&(dc->owner->gc.foreground), x1, x2, y);
+	if (hw_driver->ops->map_color != RT_NULL)
+		hw_driver->ops->draw_hline_native(rtgui_gc_fc_pixel(&(owner->gc), hw_driver->ops), x1, x2, y);
+	else
+		hw_driver->ops->draw_hline(&(owner->gc.foreground), x1, x2, y);
 }
 
 static void rtgui_dc_hw_fill_rect (struct rtgui_dc* self, struct rtgui_rect* rect)
 {
 	rtgui_color_t color;
 	register rt_base_t index, x1, x2;
-	struct rtgui_dc_hw* dc;
+	rtgui_widget_t *owner;
 
 	RT_ASSERT(self != RT_NULL);
-	dc = (struct rtgui_dc_hw*) self;
+	owner = RTGUI_CONTAINER_OF(self, struct rtgui_widget, dc_type);
 
 	/* get background color */
-	color = dc->owner->gc.background;
+	color = owner->gc.background;
+	if (hw_driver->ops->fill_rect != RT_NULL)
+	{
+		rtgui_rect_t screen, device_rect;
+
+		/* convert logic to device and keep it in screen */
+		device_rect = *rect;
+		rtgui_rect_moveto(&device_rect, owner->extent.x1, owner->extent.y1);
+		rtgui_graphic_driver_get_rect(hw_driver, &screen);
+		rtgui_rect_intersect(&screen, &device_rect);
+		if (device_rect.x1 < device_rect.x2 && device_rect.y1 < device_rect.y2)
+			hw_driver->ops->fill_rect(&color, &device_rect);
+		return;
+	}
+
 	/* convert logic to device */
-	x1 = rect->x1 + dc->owner->extent.x1;
-	x2 = rect->x2 + dc->owner->extent.x1;
+	x1 = rect->x1 + owner->extent.x1;
+	x2 = rect->x2 + owner->extent.x1;
 
 	/* fill rect */
-	for (index = dc->owner->extent.y1 + rect->y1; index < dc->owner->extent.y1 + rect->y2; index ++)
+	if (hw_driver->ops->map_color != RT_NULL)
 	{
-		dc->hw_driver->ops->draw_hline(&color, x1, x2, index);
+		rt_uint32_t pixel;
+
+		pixel = rtgui_gc_bc_pixel(&(owner->gc), hw_driver->ops);
+		for (index = owner->extent.y1 + rect->y1; index < owner->extent.y1 + rect->y2; index ++)
+			hw_driver->ops->draw_hline_native(pixel, x1, x2, index);
+		return;
+	}
+
+	for (index = owner->extent.y1 + rect->y1; index < owner->extent.y1 + rect->y2; index ++)
+	{
+		hw_driver->ops->draw_hline(&color, x1, x2, index);
 	}
 }
 
 static void rtgui_dc_hw_blit_line (struct rtgui_dc* self, int x1, int x2, int y, rt_uint8_t* line_data)
 {
-	struct rtgui_dc_hw* dc;
+	rtgui_widget_t *owner;
 
 	RT_ASSERT(self != RT_NULL);
-	dc = (struct rtgui_dc_hw*) self;
+	owner = RTGUI_CONTAINER_OF(self, struct rtgui_widget, dc_type);
 
 	/* convert logic to device */
-	x1 = x1 + dc->owner->extent.x1;
-	x2 = x2 + dc->owner->extent.x1;
-	y  = y + dc->owner->extent.y1;
+	x1 = x1 + owner->extent.x1;
+	x2 = x2 + owner->extent.x1;
+	y  = y + owner->extent.y1;
 
-	dc->hw_driver->ops->draw_raw_hline(line_data, x1, x2, y);
+	hw_driver->ops->draw_raw_hline(line_data, x1, x2, y);
 }
 
 static void rtgui_dc_hw_blit(struct rtgui_dc* dc, struct rtgui_point* dc_point, struct rtgui_dc* dest, rtgui_rect_t* rect)
@@ -334,46 +351,146 @@ static void rtgui_dc_hw_blit(struct rtgui_dc* dc, struct rtgui_point* dc_point,
 	return ;
 }
 
+/*
+ * draw the logic points on device, the points out of owner are skipped as the
+ * client dc does.
+ */
+static void rtgui_dc_hw_draw_points(struct rtgui_dc* self, struct rtgui_point* points, int count)
+{
+	rtgui_widget_t *owner;
+	const struct rtgui_graphic_driver_ops *ops;
+	rtgui_rect_t *extent;
+	rt_uint32_t pixel;
+	int x, y;
+
+	RT_ASSERT(self != RT_NULL);
+	owner = RTGUI_CONTAINER_OF(self, struct rtgui_widget, dc_type);
+	ops = hw_driver->ops;
+	extent = &(owner->extent);
+
+	if (ops->map_color != RT_NULL)
+	{
+		/* map the foreground to device pixel once */
+		pixel = rtgui_gc_fc_pixel(&(owner->gc), ops);
+		for (; count > 0; count --, points ++)
+		{
+			x = points->x + extent->x1;
+			y = points->y + extent->y1;
+			if (x < extent->x1 || x >= extent->x2 || y < extent->y1 || y >= extent->y2) continue;
+
+			ops->set_pixel_native(pixel, x, y);
+		}
+	}
+	else
+	{
+		for (; count > 0; count --, points ++)
+		{
+			x = points->x + extent->x1;
+			y = points->y + extent->y1;
+			if (x < extent->x1 || x >= extent->x2 || y < extent->y1 || y >= extent->y2) continue;
+
+			ops->set_pixel(&(owner->gc.foreground), x, y);
+		}
+	}
+}
+
+static void rtgui_dc_hw_draw_color_points(struct rtgui_dc* self, struct rtgui_point* points,
+	rtgui_color_t* colors, int count)
+{
+	rtgui_widget_t *owner;
+	const struct rtgui_graphic_driver_ops *ops;
+	rtgui_rect_t *extent;
+	int x, y;
+
+	RT_ASSERT(self != RT_NULL);
+	owner = RTGUI_CONTAINER_OF(self, struct rtgui_widget, dc_type);
+	ops = hw_driver->ops;
+	extent = &(owner->extent);
+
+	for (; count > 0; count --, points ++, colors ++)
+	{
+		x = points->x + extent->x1;
+		y = points->y + extent->y1;
+		if (x < extent->x1 || x >= extent->x2 || y < extent->y1 || y >= extent->y2) continue;
+
+		ops->set_pixel(colors, x, y);
+	}
+}
+
+static void rtgui_dc_hw_draw_spans(struct rtgui_dc* self, struct rtgui_span* spans, int count)
+{
+	rtgui_widget_t *owner;
+	const struct rtgui_graphic_driver_ops *ops;
+	rtgui_rect_t *extent;
+	rt_uint32_t pixel = 0;
+	int x1, x2, y;
+
+	RT_ASSERT(self != RT_NULL);
+	owner = RTGUI_CONTAINER_OF(self, struct rtgui_widget, dc_type);
+	ops = hw_driver->ops;
+	extent = &(owner->extent);
+
+	if (ops->map_color != RT_NULL)
+		pixel = rtgui_gc_fc_pixel(&(owner->gc), ops);
+	for (; count > 0; count --, spans ++)
+	{
+		/* convert logic to device and keep it in owner */
+		x1 = spans->x1 + extent->x1;
+		x2 = spans->x2 + extent->x1;
+		if (x1 > x2) _int_swap(x1, x2);
+		y  = spans->y + extent->y1;
+		if (y < extent->y1 || y >= extent->y2) continue;
+		if (x1 < extent->x1) x1 = extent->x1;
+		if (x2 > extent->x2) x2 = extent->x2;
+		if (x1 >= x2) continue;
+
+		if (ops->map_color != RT_NULL)
+			ops->draw_hline_native(pixel, x1, x2, y);
+		else
+			ops->draw_hline(&(owner->gc.foreground), x1, x2, y);
+	}
+}
+
 static void rtgui_dc_hw_set_gc(struct rtgui_dc* self, rtgui_gc_t *gc)
 {
-	struct rtgui_dc_hw* dc;
+	rtgui_widget_t *owner;
 
 	RT_ASSERT(self != RT_NULL);
-	dc = (struct rtgui_dc_hw*) self;
+	owner = RTGUI_CONTAINER_OF(self, struct rtgui_widget, dc_type);
 
 	/* set gc */
-	dc->owner->gc = *gc;
+	owner->gc = *gc;
 }
 
 static rtgui_gc_t* rtgui_dc_hw_get_gc(struct rtgui_dc* self)
 {
-	struct rtgui_dc_hw* dc;
+	rtgui_widget_t *owner;
 
 	RT_ASSERT(self != RT_NULL);
-	dc = (struct rtgui_dc_hw*) self;
+	owner = RTGUI_CONTAINER_OF(self, struct rtgui_widget, dc_type);
 
-	return &(dc->owner->gc);
+	return &(owner->gc);
 }
 
 static rt_bool_t rtgui_dc_hw_get_visible(struct rtgui_dc* self)
 {
-	struct rtgui_dc_hw* dc;
+	rtgui_widget_t *owner;
 
 	RT_ASSERT(self != RT_NULL);
-	dc = (struct rtgui_dc_hw*) self;
+	owner = RTGUI_CONTAINER_OF(self, struct rtgui_widget, dc_type);
 
-	if (!RTGUI_WIDGET_IS_DC_VISIBLE(dc->owner)) return RT_FALSE;
+	if (!RTGUI_WIDGET_IS_DC_VISIBLE(owner)) return RT_FALSE;
 
 	return RT_TRUE;
 }
 
 static void rtgui_dc_hw_get_rect(struct rtgui_dc* self, rtgui_rect_t* rect)
 {
-	struct rtgui_dc_hw* dc;
+	rtgui_widget_t *owner;
 
 	RT_ASSERT(self != RT_NULL);
-	dc = (struct rtgui_dc_hw*) self;
+	owner = RTGUI_CONTAINER_OF(self, struct rtgui_widget, dc_type);
 
 	/* get owner */
-	rtgui_widget_get_rect(dc->owner, rect);
+	rtgui_widget_get_rect(owner, rect);
 }
@@ -29,17 +29,15 @@ const struct rtgui_font_engine bmp_font_engine =
 void rtgui_bitmap_font_draw_char(struct rtgui_font_bitmap* font, struct rtgui_dc* dc, const char ch,
 	rtgui_rect_t* rect)
 {
-	rtgui_color_t bc;
 	const rt_uint8_t* font_ptr;
 	rt_uint16_t x, y, h, style;
-	register rt_base_t i, j, k, word_bytes;
+	register rt_base_t word_bytes;
 
 	/* check first and last char */
 	if (ch < font->first_char || ch > font->last_char) return;
 
 	/* get text style */
 	style = rtgui_dc_get_gc(dc)->textstyle;
-	bc = rtgui_dc_get_gc(dc)->background;
 
 	x = rect->x1;
 	y = rect->y1;
@@ -57,24 +55,8 @@ void rtgui_bitmap_font_draw_char(struct rtgui_font_bitmap* font, struct rtgui_dc
 
 	h = (font->height + y > rect->y2) ? rect->y2 - rect->y1 : font->height;
 
-	for (i = 0; i < h; i++)
-	{
-		for (j = 0; j < word_bytes; j++)
-		{
-			for (k = 0; k < 8; k++)
-			{
-				if (((font_ptr[i * word_bytes + j] >> (7 - k)) & 0x01) != 0)
-				{
-					/* draw a pixel */
-					rtgui_dc_draw_point(dc, k + 8 * j + x, i + y);
-				}
-				else if (style & RTGUI_TEXTSTYLE_DRAW_BACKGROUND)
-				{
-					rtgui_dc_draw_color_point(dc, k + 8 * j + x, i + y, bc);
-				}
-			}
-		}
-	}
+	rtgui_dc_draw_mono_bits(dc, x, y, word_bytes * 8, h, word_bytes, font_ptr,
+		(style & RTGUI_TEXTSTYLE_DRAW_BACKGROUND)? RT_TRUE : RT_FALSE);
 }
 
 static void rtgui_bitmap_font_draw_text(struct rtgui_font* font, struct rtgui_dc* dc, 
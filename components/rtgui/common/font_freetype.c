@@ -5,6 +5,9 @@
 #include <freetype/freetype.h>
 #include <freetype/ftglyph.h>
 
+/* the points of glyph gathered on stack before drawn */
+#define FREETYPE_POINT_MAX	64
+
 static void rtgui_freetype_font_draw_text(struct rtgui_font* font, struct rtgui_dc* dc, const char* text, rt_ubase_t len, struct rtgui_rect* rect);
 static void rtgui_freetype_font_get_metrics(struct rtgui_font* font, const char* text, rtgui_rect_t* rect);
 
@@ -79,19 +82,31 @@ static void rtgui_freetype_font_draw_text(struct rtgui_font* font, struct rtgui_
 		err = FT_Load_Glyph(freetype->face, index, FT_LOAD_DEFAULT|FT_LOAD_RENDER);
 		if (err == 0)
 		{
-			int rows, x;
+			int rows, x, count;
 			rt_uint8_t* ptr;
+			struct rtgui_point points[FREETYPE_POINT_MAX];
+			rtgui_color_t colors[FREETYPE_POINT_MAX];
 
-			/* render font */
+			/* render font, the points are drawn in batch */
 			ptr = (rt_uint8_t*)freetype->face->glyph->bitmap.buffer;
-			
+			count = 0;
 			for (rows = 0; rows < freetype->face->glyph->bitmap.rows; rows ++)
 				for (x = 0; x < freetype->face->glyph->bitmap.width; x++)
 				{
 					if (*ptr > 0)
-						rtgui_dc_draw_color_point(dc, rect->x1 + x, rect->y1 + rows, RTGUI_RGB(0xff - *ptr, 0xff - *ptr, 0xff - *ptr));
+					{
+						points[count].x = rect->x1 + x;
+						points[count].y = rect->y1 + rows;
+						colors[count] = RTGUI_RGB(0xff - *ptr, 0xff - *ptr, 0xff - *ptr);
+						if (++ count == FREETYPE_POINT_MAX)
+						{
+							rtgui_dc_draw_color_points(dc, points, colors, count);
+							count = 0;
+						}
+					}
 					ptr ++;
 				}
+			if (count > 0) rtgui_dc_draw_color_points(dc, points, colors, count);
 		}
 
 		text_ptr ++;
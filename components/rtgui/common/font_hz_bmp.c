@@ -17,7 +17,6 @@ const struct rtgui_font_engine hz_bmp_font_engine =
 static void _rtgui_hz_bitmap_font_draw_text(struct rtgui_font_bitmap* bmp_font, struct rtgui_dc* dc, const char* text, rt_ubase_t len, struct rtgui_rect* rect)
 {
 	rt_uint8_t* str;
-	rtgui_color_t bc;
 	rt_uint16_t style;
 	register rt_base_t h, word_bytes, font_bytes;
 
@@ -25,7 +24,6 @@ static void _rtgui_hz_bitmap_font_draw_text(struct rtgui_font_bitmap* bmp_font,
 
 	/* get text style */
 	style = rtgui_dc_get_gc(dc)->textstyle;
-	bc = rtgui_dc_get_gc(dc)->background;
 
 	/* drawing height */
 	h = (bmp_font->height + rect->y1 > rect->y2)? rect->y2 - rect->y1 : bmp_font->height;
@@ -38,7 +36,7 @@ static void _rtgui_hz_bitmap_font_draw_text(struct rtgui_font_bitmap* bmp_font,
 	{
 		const rt_uint8_t* font_ptr;
 		rt_ubase_t sect, index;
-		register rt_base_t i, j, k;
+		rt_base_t w;
 
 		/* calculate section and index */
 		sect  = *str - 0xA0;
@@ -46,23 +44,10 @@ static void _rtgui_hz_bitmap_font_draw_text(struct rtgui_font_bitmap* bmp_font,
 
 		/* get font pixel data */
 		font_ptr = bmp_font->bmp + (94 * (sect - 1) + (index - 1)) * font_bytes;
-		/* draw word */
-		for (i=0; i < h; i ++)
-		{
-			for (j=0; j < word_bytes; j++)
-				for (k=0; k < 8; k++)
-				{
-					if ( ((font_ptr[i*word_bytes + j] >> (7-k)) & 0x01) != 0 &&
-						(rect->x1 + 8 * j + k < rect->x2))
-					{
-						rtgui_dc_draw_point(dc, rect->x1 + 8*j + k, rect->y1 + i);
-					}
-					else if (style & RTGUI_TEXTSTYLE_DRAW_BACKGROUND)
-					{
-						rtgui_dc_draw_color_point(dc, rect->x1 + 8*j + k, rect->y1 + i, bc);
-					}
-				}
-		}
+		/* draw word, which is clipped in rect */
+		w = rect->x2 - rect->x1 < word_bytes * 8? rect->x2 - rect->x1 : word_bytes * 8;
+		rtgui_dc_draw_mono_bits(dc, rect->x1, rect->y1, w, h, word_bytes, font_ptr,
+			(style & RTGUI_TEXTSTYLE_DRAW_BACKGROUND)? RT_TRUE : RT_FALSE);
 
 		/* move x to next character */
 		rect->x1 += bmp_font->width;
@@ -113,13 +113,11 @@ static void rtgui_hz_file_font_load(struct rtgui_font* font)
 static void _rtgui_hz_file_font_draw_text(struct rtgui_hz_file_font* hz_file_font, struct rtgui_dc* dc, const char* text, rt_ubase_t len, struct rtgui_rect* rect)
 {
 	rt_uint8_t* str;
-	rtgui_color_t bc;
 	rt_uint16_t style;
 	register rt_base_t h, word_bytes;
 
 	/* get text style */
 	style = rtgui_dc_get_gc(dc)->textstyle;
-	bc = rtgui_dc_get_gc(dc)->background;
 
 	/* drawing height */
 	h = (hz_file_font->font_size + rect->y1 > rect->y2)?
@@ -131,28 +129,15 @@ static void _rtgui_hz_file_font_draw_text(struct rtgui_hz_file_font* hz_file_fon
 	while (len > 0 && rect->x1 < rect->x2)
 	{
 		const rt_uint8_t* font_ptr;
-		register rt_base_t i, j, k;
+		rt_base_t w;
 
 		/* get font pixel data */
 		font_ptr = _font_cache_get(hz_file_font, *str | (*(str+1) << 8));
 
-		/* draw word */
-		for (i=0; i < h; i ++)
-		{
-			for (j=0; j < word_bytes; j++)
-				for (k=0; k < 8; k++)
-				{
-					if ( ((font_ptr[i*word_bytes + j] >> (7-k)) & 0x01) != 0 &&
-						(rect->x1 + 8 * j + k < rect->x2))
-					{
-						rtgui_dc_draw_point(dc, rect->x1 + 8*j + k, rect->y1 + i);
-					}
-					else if (style & RTGUI_TEXTSTYLE_DRAW_BACKGROUND)
-					{
-						rtgui_dc_draw_color_point(dc, rect->x1 + 8*j + k, rect->y1 + i, bc);
-					}
-				}
-		}
+		/* draw word, which is clipped in rect */
+		w = rect->x2 - rect->x1 < word_bytes * 8? rect->x2 - rect->x1 : word_bytes * 8;
+		rtgui_dc_draw_mono_bits(dc, rect->x1, rect->y1, w, h, word_bytes, font_ptr,
+			(style & RTGUI_TEXTSTYLE_DRAW_BACKGROUND)? RT_TRUE : RT_FALSE);
 
 		/* move x to next character */
 		rect->x1 += hz_file_font->font_size;
@@ -1,105 +1,360 @@
 #include <rtgui/rtgui_system.h>
 #include <rtgui/driver.h>
+#include <rtgui/blit.h>
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+#if defined(__ARM_NEON__) || defined(__ARM_NEON)
+#include <arm_neon.h>
+#endif
 
 #define GET_PIXEL(dst, x, y, type)	\
 	(type *)((rt_uint8_t*)((dst)->framebuffer) + (y) * (dst)->pitch + (x) * ((dst)->bits_per_pixel/8))
 
-static void _rgb565_set_pixel(rtgui_color_t *c, int x, int y)
+/*
+ * The span fill kernels store a 32 bits pattern in count words. They take
+ * the widest store of CPU after the head is aligned, and the kernel is
+ * selected when the device is set.
+ */
+typedef void (*framebuffer_fill_func)(rt_uint32_t *dst, rt_uint32_t pattern, rt_ubase_t count);
+
+static void _fill_word(rt_uint32_t *dst, rt_uint32_t pattern, rt_ubase_t count)
 {
-	*GET_PIXEL(rtgui_graphic_get_device(), x, y, rt_uint16_t) = rtgui_color_to_565(*c);
+	for (; count >= 4; count -= 4, dst += 4)
+	{
+		dst[0] = pattern;
+		dst[1] = pattern;
+		dst[2] = pattern;
+		dst[3] = pattern;
+	}
+	while (count--) *dst++ = pattern;
 }
 
-static void _rgb565_get_pixel(rtgui_color_t *c, int x, int y)
+#if !defined(__SSE2__) && !defined(__ARM_NEON__) && !defined(__ARM_NEON)
+/* the 64 bits store when there is no SIMD store */
+static void _fill_dword(rt_uint32_t *dst, rt_uint32_t pattern, rt_ubase_t count)
 {
-	rt_uint16_t pixel;
+	unsigned long long value;
+	unsigned long long *ptr;
 
-	pixel = *GET_PIXEL(rtgui_graphic_get_device(), x, y, rt_uint16_t);
+	if (count > 0 && ((rt_ubase_t)dst & 0x07))
+	{
+		*dst++ = pattern;
+		count --;
+	}
 
-	/* get pixel from color */
-	*c = rtgui_color_from_565(pixel);
+	value = ((unsigned long long)pattern << 32) | pattern;
+	for (ptr = (unsigned long long*)dst; count >= 8; count -= 8, ptr += 4)
+	{
+		ptr[0] = value;
+		ptr[1] = value;
+		ptr[2] = value;
+		ptr[3] = value;
+	}
+	for (; count >= 2; count -= 2) *ptr++ = value;
+
+	if (count) *(rt_uint32_t*)ptr = pattern;
 }
+#endif
 
-static void _rgb565_draw_hline(rtgui_color_t *c, int x1, int x2, int y)
+#if defined(__SSE2__)
+static void _fill_sse2(rt_uint32_t *dst, rt_uint32_t pattern, rt_ubase_t count)
 {
-	rt_ubase_t index;
-	rt_uint16_t pixel;
-	rt_uint16_t *pixel_ptr;
+	__m128i value;
 
-	/* get pixel from color */
-	pixel = rtgui_color_to_565(*c);
+	while (count > 0 && ((rt_ubase_t)dst & 0x0f))
+	{
+		*dst++ = pattern;
+		count --;
+	}
 
-	/* get pixel pointer in framebuffer */
-	pixel_ptr = GET_PIXEL(rtgui_graphic_get_device(), x1, y, rt_uint16_t);
-	
-	for (index = x1; index < x2; index ++)
+	value = _mm_set1_epi32((int)pattern);
+	for (; count >= 16; count -= 16, dst += 16)
 	{
-		*pixel_ptr = pixel;
-		pixel_ptr ++;
+		_mm_store_si128((__m128i*)dst, value);
+		_mm_store_si128((__m128i*)(dst + 4), value);
+		_mm_store_si128((__m128i*)(dst + 8), value);
+		_mm_store_si128((__m128i*)(dst + 12), value);
 	}
+	for (; count >= 4; count -= 4, dst += 4)
+		_mm_store_si128((__m128i*)dst, value);
+
+	while (count--) *dst++ = pattern;
 }
+#endif
 
-static void _rgb565_draw_vline(rtgui_color_t *c, int x , int y1, int y2)
+#if defined(__ARM_NEON__) || defined(__ARM_NEON)
+static void _fill_neon(rt_uint32_t *dst, rt_uint32_t pattern, rt_ubase_t count)
+{
+	uint32x4_t value;
+
+	while (count > 0 && ((rt_ubase_t)dst & 0x0f))
+	{
+		*dst++ = pattern;
+		count --;
+	}
+
+	value = vdupq_n_u32(pattern);
+	for (; count >= 16; count -= 16, dst += 16)
+	{
+		vst1q_u32(dst, value);
+		vst1q_u32(dst + 4, value);
+		vst1q_u32(dst + 8, value);
+		vst1q_u32(dst + 12, value);
+	}
+	for (; count >= 4; count -= 4, dst += 4)
+		vst1q_u32(dst, value);
+
+	while (count--) *dst++ = pattern;
+}
+#endif
+
+static framebuffer_fill_func _framebuffer_fill = _fill_word;
+
+static framebuffer_fill_func _framebuffer_fill_select(void)
+{
+#if defined(__SSE2__)
+	return _fill_sse2;
+#elif defined(__ARM_NEON__) || defined(__ARM_NEON)
+	return _fill_neon;
+#else
+	/* the 64 bits store is only cheap on a 64 bits CPU */
+	if (sizeof(rt_ubase_t) == 8) return _fill_dword;
+	return _fill_word;
+#endif
+}
+
+/* fill a span of 16 bits pixel, the head and tail are not aligned to word */
+rt_inline void _framebuffer_fill16(rt_uint16_t *dst, rt_uint16_t pixel, rt_ubase_t count)
+{
+	if (count == 0) return;
+
+	if ((rt_ubase_t)dst & 0x03)
+	{
+		*dst++ = pixel;
+		count --;
+	}
+
+	/* short spans of text and line are faster in place */
+	if (count >= 8)
+	{
+		_framebuffer_fill((rt_uint32_t*)dst, ((rt_uint32_t)pixel << 16) | pixel, count / 2);
+		dst += count & ~1;
+		count &= 1;
+	}
+
+	while (count--) *dst++ = pixel;
+}
+
+/*
+ * The 2D operations take the accelerator of device when there is one, it
+ * returns after the framebuffer is written.
+ */
+static rt_bool_t _framebuffer_ext_fill(const void *pixel, struct rtgui_rect *rect)
+{
+	struct rt_device_rect_info info;
+	const struct rtgui_graphic_ext_ops *ext_ops;
+
+	ext_ops = rtgui_graphic_get_device()->ext_ops;
+	if (ext_ops == RT_NULL || ext_ops->fill_rect == RT_NULL) return RT_FALSE;
+
+	info.x = rect->x1;
+	info.y = rect->y1;
+	info.width = rect->x2 - rect->x1;
+	info.height = rect->y2 - rect->y1;
+	ext_ops->fill_rect((const char*)pixel, &info);
+
+	return RT_TRUE;
+}
+
+static void _framebuffer_fill_rect16(rt_uint16_t pixel, struct rtgui_rect *rect)
 {
 	rt_uint8_t *dst;
-	rt_uint16_t pixel;
-	rt_ubase_t index;
+	rt_ubase_t pitch;
+	int y;
+
+	if (rect->x2 <= rect->x1 || _framebuffer_ext_fill(&pixel, rect)) return;
+
+	pitch = rtgui_graphic_get_device()->pitch;
+	dst = GET_PIXEL(rtgui_graphic_get_device(), rect->x1, rect->y1, rt_uint8_t);
+	for (y = rect->y1; y < rect->y2; y ++, dst += pitch)
+		_framebuffer_fill16((rt_uint16_t*)dst, pixel, rect->x2 - rect->x1);
+}
+
+static void framebuffer_blit_rect(rt_uint8_t *pixels, int pitch, struct rtgui_rect *rect)
+{
+	rt_uint8_t *dst;
+	rt_ubase_t size, dst_pitch;
+	int y;
+	const struct rtgui_graphic_ext_ops *ext_ops;
+
+	ext_ops = rtgui_graphic_get_device()->ext_ops;
+	if (ext_ops != RT_NULL && ext_ops->blit_rect != RT_NULL)
+	{
+		struct rt_device_rect_info info;
+
+		info.x = rect->x1;
+		info.y = rect->y1;
+		info.width = rect->x2 - rect->x1;
+		info.height = rect->y2 - rect->y1;
+		ext_ops->blit_rect((const char*)pixels, pitch, &info);
+		return;
+	}
+
+	dst_pitch = rtgui_graphic_get_device()->pitch;
+	size = (rect->x2 - rect->x1) * (rtgui_graphic_get_device()->bits_per_pixel/8);
+	dst = GET_PIXEL(rtgui_graphic_get_device(), rect->x1, rect->y1, rt_uint8_t);
+	for (y = rect->y1; y < rect->y2; y ++, dst += dst_pitch, pixels += pitch)
+		rt_memcpy(dst, pixels, size);
+}
+
+static void framebuffer_copy_area(struct rtgui_rect *rect, int x, int y)
+{
+	rt_uint8_t *src, *dst;
+	rt_ubase_t size;
+	int pitch, line;
+	const struct rtgui_graphic_ext_ops *ext_ops;
+
+	ext_ops = rtgui_graphic_get_device()->ext_ops;
+	if (ext_ops != RT_NULL && ext_ops->copy_area != RT_NULL)
+	{
+		struct rt_device_rect_info info;
 
-	pixel = rtgui_color_to_565(*c);
+		info.x = rect->x1;
+		info.y = rect->y1;
+		info.width = rect->x2 - rect->x1;
+		info.height = rect->y2 - rect->y1;
+		ext_ops->copy_area(&info, x, y);
+		return;
+	}
+
+	pitch = rtgui_graphic_get_device()->pitch;
+	size = (rect->x2 - rect->x1) * (rtgui_graphic_get_device()->bits_per_pixel/8);
+	src = GET_PIXEL(rtgui_graphic_get_device(), rect->x1, rect->y1, rt_uint8_t);
+	dst = GET_PIXEL(rtgui_graphic_get_device(), x, y, rt_uint8_t);
+
+	/* copy from the bottom line when the area is moved down */
+	if (y > rect->y1)
+	{
+		src += (rect->y2 - rect->y1 - 1) * pitch;
+		dst += (rect->y2 - rect->y1 - 1) * pitch;
+		pitch = -pitch;
+	}
+	for (line = rect->y1; line < rect->y2; line ++, src += pitch, dst += pitch)
+		rt_memmove(dst, src, size);
+}
+
+/*
+ * blend a line of ARGB888 pixels in place, the blender of each mode is
+ * selected by the pixel format when the device is set.
+ */
+static rtgui_blit_line_func _framebuffer_blend[RTGUI_BLENDMODE_MOD + 1];
+
+static void framebuffer_blend_hline(rt_uint8_t *pixels, int mode, int x1, int x2, int y)
+{
+	if (x2 <= x1 || mode > RTGUI_BLENDMODE_MOD || _framebuffer_blend[mode] == RT_NULL) return;
+
+	_framebuffer_blend[mode](GET_PIXEL(rtgui_graphic_get_device(), x1, y, rt_uint8_t),
+		pixels, x2 - x1);
+}
+
+/* the operations in device pixel of 16 bits, which are shared by RGB565 and RGB565P */
+static void _fb16_set_pixel_native(rt_uint32_t pixel, int x, int y)
+{
+	*GET_PIXEL(rtgui_graphic_get_device(), x, y, rt_uint16_t) = (rt_uint16_t)pixel;
+}
+
+static void _fb16_draw_hline_native(rt_uint32_t pixel, int x1, int x2, int y)
+{
+	if (x2 <= x1) return;
+
+	_framebuffer_fill16(GET_PIXEL(rtgui_graphic_get_device(), x1, y, rt_uint16_t),
+		(rt_uint16_t)pixel, x2 - x1);
+}
+
+static void _fb16_draw_vline_native(rt_uint32_t pixel, int x , int y1, int y2)
+{
+	rt_uint8_t *dst;
+	rt_ubase_t index, pitch;
+
+	pitch = rtgui_graphic_get_device()->pitch;
 	dst = GET_PIXEL(rtgui_graphic_get_device(), x, y1, rt_uint8_t);
 	for (index = y1; index < y2; index ++)
 	{
-		*(rt_uint16_t*)dst = pixel;
-		dst += rtgui_graphic_get_device()->pitch;
+		*(rt_uint16_t*)dst = (rt_uint16_t)pixel;
+		dst += pitch;
 	}
 }
 
-static void _rgb565p_set_pixel(rtgui_color_t *c, int x, int y)
+static rt_uint32_t _rgb565_map_color(rtgui_color_t c)
 {
-	*GET_PIXEL(rtgui_graphic_get_device(), x, y, rt_uint16_t) = rtgui_color_to_565p(*c);
+	return rtgui_color_to_565(c);
 }
 
-static void _rgb565p_get_pixel(rtgui_color_t *c, int x, int y)
+static void _rgb565_set_pixel(rtgui_color_t *c, int x, int y)
+{
+	_fb16_set_pixel_native(rtgui_color_to_565(*c), x, y);
+}
+
+static void _rgb565_get_pixel(rtgui_color_t *c, int x, int y)
 {
 	rt_uint16_t pixel;
 
 	pixel = *GET_PIXEL(rtgui_graphic_get_device(), x, y, rt_uint16_t);
 
 	/* get pixel from color */
-	*c = rtgui_color_from_565p(pixel);
+	*c = rtgui_color_from_565(pixel);
 }
 
-static void _rgb565p_draw_hline(rtgui_color_t *c, int x1, int x2, int y)
+static void _rgb565_draw_hline(rtgui_color_t *c, int x1, int x2, int y)
+{
+	_fb16_draw_hline_native(rtgui_color_to_565(*c), x1, x2, y);
+}
+
+static void _rgb565_draw_vline(rtgui_color_t *c, int x , int y1, int y2)
+{
+	_fb16_draw_vline_native(rtgui_color_to_565(*c), x, y1, y2);
+}
+
+static void _rgb565_fill_rect(rtgui_color_t *c, struct rtgui_rect *rect)
+{
+	_framebuffer_fill_rect16(rtgui_color_to_565(*c), rect);
+}
+
+static rt_uint32_t _rgb565p_map_color(rtgui_color_t c)
+{
+	return rtgui_color_to_565p(c);
+}
+
+static void _rgb565p_set_pixel(rtgui_color_t *c, int x, int y)
+{
+	_fb16_set_pixel_native(rtgui_color_to_565p(*c), x, y);
+}
+
+static void _rgb565p_get_pixel(rtgui_color_t *c, int x, int y)
 {
-	rt_ubase_t index;
 	rt_uint16_t pixel;
-	rt_uint16_t *pixel_ptr;
+
+	pixel = *GET_PIXEL(rtgui_graphic_get_device(), x, y, rt_uint16_t);
 
 	/* get pixel from color */
-	pixel = rtgui_color_to_565p(*c);
+	*c = rtgui_color_from_565p(pixel);
+}
 
-	/* get pixel pointer in framebuffer */
-	pixel_ptr = GET_PIXEL(rtgui_graphic_get_device(), x1, y, rt_uint16_t);
-	
-	for (index = x1; index < x2; index ++)
-	{
-		*pixel_ptr = pixel;
-		pixel_ptr ++;
-	}
+static void _rgb565p_draw_hline(rtgui_color_t *c, int x1, int x2, int y)
+{
+	_fb16_draw_hline_native(rtgui_color_to_565p(*c), x1, x2, y);
 }
 
 static void _rgb565p_draw_vline(rtgui_color_t *c, int x , int y1, int y2)
 {
-	rt_uint8_t *dst;
-	rt_uint16_t pixel;
-	rt_ubase_t index;
+	_fb16_draw_vline_native(rtgui_color_to_565p(*c), x, y1, y2);
+}
 
-	pixel = rtgui_color_to_565p(*c);
-	dst = GET_PIXEL(rtgui_graphic_get_device(), x, y1, rt_uint8_t);
-	for (index = y1; index < y2; index ++)
-	{
-		*(rt_uint16_t*)dst = pixel;
-		dst += rtgui_graphic_get_device()->pitch;
-	}
+static void _rgb565p_fill_rect(rtgui_color_t *c, struct rtgui_rect *rect)
+{
+	_framebuffer_fill_rect16(rtgui_color_to_565p(*c), rect);
 }
 
 /* draw raw hline */
@@ -118,6 +373,15 @@ const struct rtgui_graphic_driver_ops _framebuffer_rgb565_ops =
 	_rgb565_draw_hline,
 	_rgb565_draw_vline,
 	framebuffer_draw_raw_hline,
+	_rgb565_fill_rect,
+	framebuffer_blit_rect,
+	framebuffer_copy_area,
+	RT_NULL,
+	_rgb565_map_color,
+	_fb16_set_pixel_native,
+	_fb16_draw_hline_native,
+	_fb16_draw_vline_native,
+	framebuffer_blend_hline,
 };
 
 const struct rtgui_graphic_driver_ops _framebuffer_rgb565p_ops = 
@@ -127,71 +391,640 @@ const struct rtgui_graphic_driver_ops _framebuffer_rgb565p_ops =
 	_rgb565p_draw_hline,
 	_rgb565p_draw_vline,
 	framebuffer_draw_raw_hline,
+	_rgb565p_fill_rect,
+	framebuffer_blit_rect,
+	framebuffer_copy_area,
+	RT_NULL,
+	_rgb565p_map_color,
+	_fb16_set_pixel_native,
+	_fb16_draw_hline_native,
+	_fb16_draw_vline_native,
+	framebuffer_blend_hline,
 };
 
-#define FRAMEBUFFER	(rtgui_graphic_get_device()->framebuffer)
-#define MONO_PIXEL(framebuffer, x, y) \
-	((rt_uint8_t**)(framebuffer))[y/8][x]
+/*
+ * The pixels of 24 and 32 bits are in the byte order of rtgui_color_t: R, G, B
+ * and A, which is what the blit line functions produce. So a 32 bits line of
+ * dc buffer is copied to framebuffer directly.
+ */
+/* the device pixel of RGB888 and ARGB888 is the color itself */
+static rt_uint32_t _rgb888_map_color(rtgui_color_t c)
+{
+	return c;
+}
 
-static void _mono_set_pixel(rtgui_color_t *c, int x, int y)
+static void _rgb888_set_pixel_native(rt_uint32_t pixel, int x, int y)
+{
+	rt_uint8_t *dst;
+
+	dst = GET_PIXEL(rtgui_graphic_get_device(), x, y, rt_uint8_t);
+	dst[0] = RTGUI_RGB_R(pixel);
+	dst[1] = RTGUI_RGB_G(pixel);
+	dst[2] = RTGUI_RGB_B(pixel);
+}
+
+static void _rgb888_draw_hline_native(rt_uint32_t pixel, int x1, int x2, int y)
+{
+	rt_ubase_t index;
+	rt_uint8_t r, g, b;
+	rt_uint8_t *dst;
+
+	r = RTGUI_RGB_R(pixel);
+	g = RTGUI_RGB_G(pixel);
+	b = RTGUI_RGB_B(pixel);
+
+	dst = GET_PIXEL(rtgui_graphic_get_device(), x1, y, rt_uint8_t);
+	for (index = x1; index < x2; index ++)
+	{
+		*dst++ = r;
+		*dst++ = g;
+		*dst++ = b;
+	}
+}
+
+static void _rgb888_draw_vline_native(rt_uint32_t pixel, int x , int y1, int y2)
+{
+	rt_ubase_t index, pitch;
+	rt_uint8_t r, g, b;
+	rt_uint8_t *dst;
+
+	r = RTGUI_RGB_R(pixel);
+	g = RTGUI_RGB_G(pixel);
+	b = RTGUI_RGB_B(pixel);
+
+	pitch = rtgui_graphic_get_device()->pitch;
+	dst = GET_PIXEL(rtgui_graphic_get_device(), x, y1, rt_uint8_t);
+	for (index = y1; index < y2; index ++)
+	{
+		dst[0] = r;
+		dst[1] = g;
+		dst[2] = b;
+		dst += pitch;
+	}
+}
+
+static void _rgb888_set_pixel(rtgui_color_t *c, int x, int y)
+{
+	_rgb888_set_pixel_native(*c, x, y);
+}
+
+static void _rgb888_get_pixel(rtgui_color_t *c, int x, int y)
+{
+	rt_uint8_t *src;
+
+	src = GET_PIXEL(rtgui_graphic_get_device(), x, y, rt_uint8_t);
+	*c = RTGUI_RGB(src[0], src[1], src[2]);
+}
+
+static void _rgb888_draw_hline(rtgui_color_t *c, int x1, int x2, int y)
+{
+	_rgb888_draw_hline_native(*c, x1, x2, y);
+}
+
+static void _rgb888_draw_vline(rtgui_color_t *c, int x , int y1, int y2)
+{
+	_rgb888_draw_vline_native(*c, x, y1, y2);
+}
+
+/* fill the first line and copy it to the others */
+static void _rgb888_fill_rect(rtgui_color_t *c, struct rtgui_rect *rect)
+{
+	rt_uint8_t pixel[3];
+	rt_uint8_t *line, *dst;
+	rt_ubase_t pitch, size;
+	int y;
+
+	pixel[0] = RTGUI_RGB_R(*c);
+	pixel[1] = RTGUI_RGB_G(*c);
+	pixel[2] = RTGUI_RGB_B(*c);
+	if (rect->x2 <= rect->x1 || rect->y2 <= rect->y1 || _framebuffer_ext_fill(pixel, rect)) return;
+
+	_rgb888_draw_hline(c, rect->x1, rect->x2, rect->y1);
+
+	pitch = rtgui_graphic_get_device()->pitch;
+	size = (rect->x2 - rect->x1) * 3;
+	line = GET_PIXEL(rtgui_graphic_get_device(), rect->x1, rect->y1, rt_uint8_t);
+	for (y = rect->y1 + 1, dst = line + pitch; y < rect->y2; y ++, dst += pitch)
+		rt_memcpy(dst, line, size);
+}
+
+static void _argb888_set_pixel_native(rt_uint32_t pixel, int x, int y)
+{
+	*GET_PIXEL(rtgui_graphic_get_device(), x, y, rt_uint32_t) = pixel;
+}
+
+static void _argb888_draw_hline_native(rt_uint32_t pixel, int x1, int x2, int y)
+{
+	if (x2 <= x1) return;
+
+	_framebuffer_fill(GET_PIXEL(rtgui_graphic_get_device(), x1, y, rt_uint32_t), pixel, x2 - x1);
+}
+
+static void _argb888_draw_vline_native(rt_uint32_t pixel, int x , int y1, int y2)
+{
+	rt_uint8_t *dst;
+	rt_ubase_t index, pitch;
+
+	pitch = rtgui_graphic_get_device()->pitch;
+	dst = GET_PIXEL(rtgui_graphic_get_device(), x, y1, rt_uint8_t);
+	for (index = y1; index < y2; index ++)
+	{
+		*(rt_uint32_t*)dst = pixel;
+		dst += pitch;
+	}
+}
+
+static void _argb888_set_pixel(rtgui_color_t *c, int x, int y)
 {
-	if (*c == white)
-		MONO_PIXEL(FRAMEBUFFER, x, y) &= ~(1 << (y%8));
+	_argb888_set_pixel_native(*c, x, y);
+}
+
+static void _argb888_get_pixel(rtgui_color_t *c, int x, int y)
+{
+	*c = *GET_PIXEL(rtgui_graphic_get_device(), x, y, rtgui_color_t);
+}
+
+static void _argb888_draw_hline(rtgui_color_t *c, int x1, int x2, int y)
+{
+	_argb888_draw_hline_native(*c, x1, x2, y);
+}
+
+static void _argb888_draw_vline(rtgui_color_t *c, int x , int y1, int y2)
+{
+	_argb888_draw_vline_native(*c, x, y1, y2);
+}
+
+static void _argb888_fill_rect(rtgui_color_t *c, struct rtgui_rect *rect)
+{
+	rt_uint8_t *dst;
+	rt_ubase_t pitch;
+	int y;
+
+	if (rect->x2 <= rect->x1 || _framebuffer_ext_fill(c, rect)) return;
+
+	pitch = rtgui_graphic_get_device()->pitch;
+	dst = GET_PIXEL(rtgui_graphic_get_device(), rect->x1, rect->y1, rt_uint8_t);
+	for (y = rect->y1; y < rect->y2; y ++, dst += pitch)
+		_framebuffer_fill((rt_uint32_t*)dst, *c, rect->x2 - rect->x1);
+}
+
+const struct rtgui_graphic_driver_ops _framebuffer_rgb888_ops = 
+{
+	_rgb888_set_pixel,
+	_rgb888_get_pixel,
+	_rgb888_draw_hline,
+	_rgb888_draw_vline,
+	framebuffer_draw_raw_hline,
+	_rgb888_fill_rect,
+	framebuffer_blit_rect,
+	framebuffer_copy_area,
+	RT_NULL,
+	_rgb888_map_color,
+	_rgb888_set_pixel_native,
+	_rgb888_draw_hline_native,
+	_rgb888_draw_vline_native,
+	framebuffer_blend_hline,
+};
+
+/* the RGB888 panel in 32 bits per pixel ignores the alpha byte */
+const struct rtgui_graphic_driver_ops _framebuffer_argb888_ops = 
+{
+	_argb888_set_pixel,
+	_argb888_get_pixel,
+	_argb888_draw_hline,
+	_argb888_draw_vline,
+	framebuffer_draw_raw_hline,
+	_argb888_fill_rect,
+	framebuffer_blit_rect,
+	framebuffer_copy_area,
+	RT_NULL,
+	_rgb888_map_color,
+	_argb888_set_pixel_native,
+	_argb888_draw_hline_native,
+	_argb888_draw_vline_native,
+	framebuffer_blend_hline,
+};
+
+/*
+ * The gray panels have 4 levels in 2 bits or 16 levels in 4 bits per pixel,
+ * the level 0 is black. The pixels are packed in line and the left one is in
+ * the most significant bits of byte. A raw line starts at the first byte.
+ */
+#define GRAY_PIXEL(x, y, bpp) \
+	((rt_uint8_t*)(rtgui_graphic_get_device()->framebuffer) + \
+	 (y) * rtgui_graphic_get_device()->pitch + (x) / (8 / (bpp)))
+#define GRAY_SHIFT(x, bpp)		((8 / (bpp) - 1 - (x) % (8 / (bpp))) * (bpp))
+#define GRAY_MASK(bpp)			((1 << (bpp)) - 1)
+
+/* the device pixel of gray panel is the level */
+#define GRAY_LEVEL(c, bpp)		(rtgui_color_to_gray(c) >> (8 - (bpp)))
+
+rt_inline void _gray_set_pixel(rt_uint8_t level, int x, int y, int bpp)
+{
+	rt_uint8_t *dst;
+
+	dst = GRAY_PIXEL(x, y, bpp);
+	*dst = (*dst & ~(GRAY_MASK(bpp) << GRAY_SHIFT(x, bpp))) | (level << GRAY_SHIFT(x, bpp));
+}
+
+rt_inline void _gray_get_pixel(rtgui_color_t *c, int x, int y, int bpp)
+{
+	rt_uint8_t level;
+
+	level = (*GRAY_PIXEL(x, y, bpp) >> GRAY_SHIFT(x, bpp)) & GRAY_MASK(bpp);
+	*c = rtgui_color_from_gray(level * 255 / GRAY_MASK(bpp));
+}
+
+rt_inline void _gray_draw_hline(rt_uint8_t level, int x1, int x2, int y, int bpp)
+{
+	rt_uint8_t *dst;
+	rt_uint8_t fill;
+	int ppb;
+
+	/* pixels per byte */
+	ppb = 8 / bpp;
+	fill = bpp == 2? level * 0x55 : level * 0x11;
+
+	dst = GRAY_PIXEL(x1, y, bpp);
+	/* the head and tail in partial bytes */
+	while (x1 < x2 && x1 % ppb != 0)
+	{
+		*dst = (*dst & ~(GRAY_MASK(bpp) << GRAY_SHIFT(x1, bpp))) | (level << GRAY_SHIFT(x1, bpp));
+		if (++x1 % ppb == 0) dst ++;
+	}
+	if (x2 - x1 >= ppb)
+	{
+		rt_memset(dst, fill, (x2 - x1) / ppb);
+		dst += (x2 - x1) / ppb;
+		x1 += (x2 - x1) / ppb * ppb;
+	}
+	for (; x1 < x2; x1 ++)
+		*dst = (*dst & ~(GRAY_MASK(bpp) << GRAY_SHIFT(x1, bpp))) | (level << GRAY_SHIFT(x1, bpp));
+}
+
+rt_inline void _gray_draw_vline(rt_uint8_t level, int x, int y1, int y2, int bpp)
+{
+	rt_uint8_t *dst;
+	rt_uint8_t mask, value;
+	rt_ubase_t index, pitch;
+
+	mask = ~(GRAY_MASK(bpp) << GRAY_SHIFT(x, bpp));
+	value = level << GRAY_SHIFT(x, bpp);
+
+	pitch = rtgui_graphic_get_device()->pitch;
+	dst = GRAY_PIXEL(x, y1, bpp);
+	for (index = y1; index < y2; index ++)
+	{
+		*dst = (*dst & mask) | value;
+		dst += pitch;
+	}
+}
+
+rt_inline void _gray_fill_rect(rt_uint8_t level, struct rtgui_rect *rect, int bpp)
+{
+	int y;
+
+	for (y = rect->y1; y < rect->y2; y ++)
+		_gray_draw_hline(level, rect->x1, rect->x2, y, bpp);
+}
+
+rt_inline void _gray_draw_raw_hline(rt_uint8_t *pixels, int x1, int x2, int y, int bpp)
+{
+	rt_uint8_t *dst;
+	rt_uint8_t level;
+	int ppb, index;
+
+	ppb = 8 / bpp;
+	dst = GRAY_PIXEL(x1, y, bpp);
+	if (x1 % ppb == 0)
+	{
+		/* on the byte boundary, copy the whole bytes */
+		rt_memcpy(dst, pixels, (x2 - x1) / ppb);
+		index = (x2 - x1) / ppb * ppb;
+	}
+	else index = 0;
+
+	for (; index < x2 - x1; index ++)
+	{
+		level = (pixels[index / ppb] >> GRAY_SHIFT(index, bpp)) & GRAY_MASK(bpp);
+		dst = GRAY_PIXEL(x1 + index, y, bpp);
+		*dst = (*dst & ~(GRAY_MASK(bpp) << GRAY_SHIFT(x1 + index, bpp))) |
+			(level << GRAY_SHIFT(x1 + index, bpp));
+	}
+}
+
+static rt_uint32_t _gray4_map_color(rtgui_color_t c)
+{
+	return GRAY_LEVEL(c, 2);
+}
+
+static void _gray4_set_pixel_native(rt_uint32_t pixel, int x, int y)
+{
+	_gray_set_pixel(pixel, x, y, 2);
+}
+
+static void _gray4_draw_hline_native(rt_uint32_t pixel, int x1, int x2, int y)
+{
+	_gray_draw_hline(pixel, x1, x2, y, 2);
+}
+
+static void _gray4_draw_vline_native(rt_uint32_t pixel, int x , int y1, int y2)
+{
+	_gray_draw_vline(pixel, x, y1, y2, 2);
+}
+
+static void _gray4_set_pixel(rtgui_color_t *c, int x, int y)
+{
+	_gray_set_pixel(GRAY_LEVEL(*c, 2), x, y, 2);
+}
+
+static void _gray4_get_pixel(rtgui_color_t *c, int x, int y)
+{
+	_gray_get_pixel(c, x, y, 2);
+}
+
+static void _gray4_draw_hline(rtgui_color_t *c, int x1, int x2, int y)
+{
+	_gray_draw_hline(GRAY_LEVEL(*c, 2), x1, x2, y, 2);
+}
+
+static void _gray4_draw_vline(rtgui_color_t *c, int x , int y1, int y2)
+{
+	_gray_draw_vline(GRAY_LEVEL(*c, 2), x, y1, y2, 2);
+}
+
+static void _gray4_draw_raw_hline(rt_uint8_t *pixels, int x1, int x2, int y)
+{
+	_gray_draw_raw_hline(pixels, x1, x2, y, 2);
+}
+
+static void _gray4_fill_rect(rtgui_color_t *c, struct rtgui_rect *rect)
+{
+	_gray_fill_rect(GRAY_LEVEL(*c, 2), rect, 2);
+}
+
+static rt_uint32_t _gray16_map_color(rtgui_color_t c)
+{
+	return GRAY_LEVEL(c, 4);
+}
+
+static void _gray16_set_pixel_native(rt_uint32_t pixel, int x, int y)
+{
+	_gray_set_pixel(pixel, x, y, 4);
+}
+
+static void _gray16_draw_hline_native(rt_uint32_t pixel, int x1, int x2, int y)
+{
+	_gray_draw_hline(pixel, x1, x2, y, 4);
+}
+
+static void _gray16_draw_vline_native(rt_uint32_t pixel, int x , int y1, int y2)
+{
+	_gray_draw_vline(pixel, x, y1, y2, 4);
+}
+
+static void _gray16_set_pixel(rtgui_color_t *c, int x, int y)
+{
+	_gray_set_pixel(GRAY_LEVEL(*c, 4), x, y, 4);
+}
+
+static void _gray16_get_pixel(rtgui_color_t *c, int x, int y)
+{
+	_gray_get_pixel(c, x, y, 4);
+}
+
+static void _gray16_draw_hline(rtgui_color_t *c, int x1, int x2, int y)
+{
+	_gray_draw_hline(GRAY_LEVEL(*c, 4), x1, x2, y, 4);
+}
+
+static void _gray16_draw_vline(rtgui_color_t *c, int x , int y1, int y2)
+{
+	_gray_draw_vline(GRAY_LEVEL(*c, 4), x, y1, y2, 4);
+}
+
+static void _gray16_draw_raw_hline(rt_uint8_t *pixels, int x1, int x2, int y)
+{
+	_gray_draw_raw_hline(pixels, x1, x2, y, 4);
+}
+
+static void _gray16_fill_rect(rtgui_color_t *c, struct rtgui_rect *rect)
+{
+	_gray_fill_rect(GRAY_LEVEL(*c, 4), rect, 4);
+}
+
+const struct rtgui_graphic_driver_ops _framebuffer_gray4_ops = 
+{
+	_gray4_set_pixel,
+	_gray4_get_pixel,
+	_gray4_draw_hline,
+	_gray4_draw_vline,
+	_gray4_draw_raw_hline,
+	_gray4_fill_rect,
+	RT_NULL,
+	RT_NULL,
+	RT_NULL,
+	_gray4_map_color,
+	_gray4_set_pixel_native,
+	_gray4_draw_hline_native,
+	_gray4_draw_vline_native,
+	RT_NULL,
+};
+
+const struct rtgui_graphic_driver_ops _framebuffer_gray16_ops = 
+{
+	_gray16_set_pixel,
+	_gray16_get_pixel,
+	_gray16_draw_hline,
+	_gray16_draw_vline,
+	_gray16_draw_raw_hline,
+	_gray16_fill_rect,
+	RT_NULL,
+	RT_NULL,
+	RT_NULL,
+	_gray16_map_color,
+	_gray16_set_pixel_native,
+	_gray16_draw_hline_native,
+	_gray16_draw_vline_native,
+	RT_NULL,
+};
+
+/*
+ * The mono panel is organized in pages of 8 lines, a page is a line of bytes
+ * and the bit n of byte is the line n of page. The pages are pitch (width)
+ * bytes apart, and a set bit is black. A raw line has one bit per pixel from
+ * x1 and the left pixel is in the least significant bit.
+ */
+#define MONO_PAGE(x, y)		(rtgui_graphic_get_device()->framebuffer + \
+	((y) >> 3) * rtgui_graphic_get_device()->pitch + (x))
+#define MONO_MASK(y1, y2)	((rt_uint8_t)((0xff << ((y1) & 0x07)) & (0xff >> (8 - ((y2) - ((y1) & ~0x07))))))
+
+/* the device pixel of mono panel is the bit, only white is cleared */
+static rt_uint32_t _mono_map_color(rtgui_color_t c)
+{
+	return c != white;
+}
+
+static void _mono_set_pixel_native(rt_uint32_t pixel, int x, int y)
+{
+	if (pixel)
+		*MONO_PAGE(x, y) |= (1 << (y & 0x07));
 	else
-		MONO_PIXEL(FRAMEBUFFER, x, y) |= (1 << (y%8));
+		*MONO_PAGE(x, y) &= ~(1 << (y & 0x07));
+}
+
+static void _mono_set_pixel(rtgui_color_t *c, int x, int y)
+{
+	_mono_set_pixel_native(*c != white, x, y);
 }
 
 static void _mono_get_pixel(rtgui_color_t *c, int x, int y)
 {
-	if (MONO_PIXEL(FRAMEBUFFER, x, y) & (1 << (y%8)))
+	if (*MONO_PAGE(x, y) & (1 << (y & 0x07)))
 		*c = black;
 	else
 		*c = white;
 }
 
-static void _mono_draw_hline(rtgui_color_t *c, int x1, int x2, int y)
+static void _mono_draw_hline_native(rt_uint32_t pixel, int x1, int x2, int y)
 {
-	rt_ubase_t index;
-	
-	if (*c == white)
-		for (index = x1; index < x2; index ++)
-		{
-			MONO_PIXEL(FRAMEBUFFER, index, y) &= ~(1 << (y%8));
-		}
+	rt_uint8_t *dst, *end;
+	rt_uint8_t mask;
+
+	dst = (rt_uint8_t*)MONO_PAGE(x1, y);
+	end = dst + (x2 - x1);
+	mask = 1 << (y & 0x07);
+
+	if (pixel)
+	{
+		while (dst < end) *dst++ |= mask;
+	}
 	else
-		for (index = x1; index < x2; index ++)
+	{
+		mask = ~mask;
+		while (dst < end) *dst++ &= mask;
+	}
+}
+
+static void _mono_draw_hline(rtgui_color_t *c, int x1, int x2, int y)
+{
+	_mono_draw_hline_native(*c != white, x1, x2, y);
+}
+
+/* fill the lines [y1, y2) of a column page by page */
+static void _mono_fill_column(rt_uint8_t *dst, rt_ubase_t pitch, int y1, int y2, rt_bool_t set)
+{
+	rt_uint8_t mask;
+	int page_end;
+
+	for (; y1 < y2; y1 = page_end, dst += pitch)
+	{
+		page_end = (y1 & ~0x07) + 8;
+		if (page_end > y2) page_end = y2;
+
+		mask = MONO_MASK(y1, page_end);
+		if (set) *dst |= mask;
+		else *dst &= ~mask;
+	}
+}
+
+static void _mono_draw_vline_native(rt_uint32_t pixel, int x , int y1, int y2)
+{
+	if (y2 <= y1) return;
+
+	_mono_fill_column((rt_uint8_t*)MONO_PAGE(x, y1), rtgui_graphic_get_device()->pitch,
+		y1, y2, pixel != 0);
+}
+
+static void _mono_draw_vline(rtgui_color_t *c, int x , int y1, int y2)
+{
+	_mono_draw_vline_native(*c != white, x, y1, y2);
+}
+
+/* draw raw hline */
+static void _mono_draw_raw_hline(rt_uint8_t *pixels, int x1, int x2, int y)
+{
+	rt_uint8_t *dst;
+	rt_uint8_t mask, bits;
+	int index, count;
+
+	dst = (rt_uint8_t*)MONO_PAGE(x1, y);
+	mask = 1 << (y & 0x07);
+	for (count = x2 - x1; count > 0; count -= 8, pixels ++)
+	{
+		bits = *pixels;
+		for (index = 0; index < 8 && index < count; index ++, dst ++, bits >>= 1)
 		{
-			MONO_PIXEL(FRAMEBUFFER, index, y) |= (1 << (y%8));
+			if (bits & 0x01) *dst |= mask;
+			else *dst &= ~mask;
 		}
+	}
 }
 
-static void _mono_draw_vline(rtgui_color_t *c, int x , int y1, int y2)
+static void _mono_fill_rect(rtgui_color_t *c, struct rtgui_rect *rect)
 {
+	rt_uint8_t *dst;
+	rt_uint8_t mask;
+	rt_ubase_t pitch, width;
 	rt_ubase_t index;
-	
-	if (*c == white)
-		for (index = y1; index < y2; index ++)
+	int y, page_end;
+
+	if (rect->x2 <= rect->x1) return;
+
+	pitch = rtgui_graphic_get_device()->pitch;
+	width = rect->x2 - rect->x1;
+	dst = (rt_uint8_t*)MONO_PAGE(rect->x1, rect->y1);
+	for (y = rect->y1; y < rect->y2; y = page_end, dst += pitch)
+	{
+		page_end = (y & ~0x07) + 8;
+		if (page_end > rect->y2) page_end = rect->y2;
+
+		/* a whole page is stored in byte */
+		mask = MONO_MASK(y, page_end);
+		if (mask == 0xff)
 		{
-			MONO_PIXEL(FRAMEBUFFER, x, index) &= ~(1 << (index%8));
+			rt_memset(dst, *c == white? 0x00 : 0xff, width);
 		}
-	else
-		for (index = y1; index < y2; index ++)
+		else if (*c == white)
+		{
+			mask = ~mask;
+			for (index = 0; index < width; index ++) dst[index] &= mask;
+		}
+		else
 		{
-			MONO_PIXEL(FRAMEBUFFER, x, index) |=  (1 << (index%8));
+			for (index = 0; index < width; index ++) dst[index] |= mask;
 		}
+	}
 }
 
-/* draw raw hline */
-static void _mono_draw_raw_hline(rt_uint8_t *pixels, int x1, int x2, int y)
+/* gather 8 lines of raw pixels to each byte of page */
+static void _mono_blit_rect(rt_uint8_t *pixels, int pitch, struct rtgui_rect *rect)
 {
-	rt_ubase_t index;
+	rt_uint8_t *dst, *src;
+	rt_uint8_t mask, value;
+	rt_ubase_t dst_pitch;
+	int x, y, line, page_end;
 
-	for (index = x1; index < x2; index ++)
+	dst_pitch = rtgui_graphic_get_device()->pitch;
+	dst = (rt_uint8_t*)MONO_PAGE(rect->x1, rect->y1);
+	for (y = rect->y1; y < rect->y2; y = page_end, dst += dst_pitch)
 	{
-		if (pixels[index/8] && (1 << (index % 8)))
-			MONO_PIXEL(FRAMEBUFFER, index, y) |=  (1 << (y%8));
-		else
-			MONO_PIXEL(FRAMEBUFFER, index, y) &= ~(1 << (y%8));
+		page_end = (y & ~0x07) + 8;
+		if (page_end > rect->y2) page_end = rect->y2;
+		mask = MONO_MASK(y, page_end);
+
+		for (x = 0; x < rect->x2 - rect->x1; x ++)
+		{
+			value = 0;
+			src = pixels + (y - rect->y1) * pitch + (x >> 3);
+			for (line = y; line < page_end; line ++, src += pitch)
+			{
+				if (*src & (1 << (x & 0x07)))
+					value |= 1 << (line & 0x07);
+			}
+
+			dst[x] = (dst[x] & ~mask) | value;
+		}
 	}
 }
 
@@ -202,22 +1035,49 @@ const struct rtgui_graphic_driver_ops _framebuffer_mono_ops =
 	_mono_draw_hline,
 	_mono_draw_vline,
 	_mono_draw_raw_hline,
+	_mono_fill_rect,
+	_mono_blit_rect,
+	RT_NULL,
+	RT_NULL,
+	_mono_map_color,
+	_mono_set_pixel_native,
+	_mono_draw_hline_native,
+	_mono_draw_vline_native,
+	RT_NULL,
 };
 
 const struct rtgui_graphic_driver_ops *rtgui_framebuffer_get_ops(int pixel_format)
 {
+	int mode, blend_format;
+
+	_framebuffer_fill = _framebuffer_fill_select();
+
+	/* the RGB888 panel in 32 bits per pixel is blended as ARGB888 */
+	blend_format = pixel_format;
+	if (pixel_format == RTGRAPHIC_PIXEL_FORMAT_RGB888 &&
+		rtgui_graphic_get_device()->bits_per_pixel == 32)
+		blend_format = RTGRAPHIC_PIXEL_FORMAT_ARGB888;
+	for (mode = RTGUI_BLENDMODE_NONE; mode <= RTGUI_BLENDMODE_MOD; mode ++)
+		_framebuffer_blend[mode] = rtgui_blend_line_get(blend_format, mode);
+
 	switch (pixel_format)
 	{
 	case RTGRAPHIC_PIXEL_FORMAT_MONO:
 		return &_framebuffer_mono_ops;
 	case RTGRAPHIC_PIXEL_FORMAT_GRAY4:
-		break;
+		return &_framebuffer_gray4_ops;
 	case RTGRAPHIC_PIXEL_FORMAT_GRAY16:
-		break;
+		return &_framebuffer_gray16_ops;
 	case RTGRAPHIC_PIXEL_FORMAT_RGB565:
 		return &_framebuffer_rgb565_ops;
 	case RTGRAPHIC_PIXEL_FORMAT_RGB565P:
 		return &_framebuffer_rgb565p_ops;
+	case RTGRAPHIC_PIXEL_FORMAT_RGB888:
+		if (rtgui_graphic_get_device()->bits_per_pixel == 32)
+			return &_framebuffer_argb888_ops;
+		return &_framebuffer_rgb888_ops;
+	case RTGRAPHIC_PIXEL_FORMAT_ARGB888:
+		return &_framebuffer_argb888_ops;
 	}
 
 	return RT_NULL;
@@ -466,7 +466,7 @@ static void rtgui_image_bmp_blit(struct rtgui_image* image, struct rtgui_dc* dc,
 		{
 			for (y = 0; y < h; y ++)
 			{
-				dc->engine->blit_line(dc, 
+				rtgui_dc_blit_line(dc, 
 					dst_rect->x1, dst_rect->x1 + w,
 					dst_rect->y1 + y, 
 					ptr);
@@ -489,7 +489,7 @@ static void rtgui_image_bmp_blit(struct rtgui_image* image, struct rtgui_dc* dc,
 					for (y = 0; y < h; y ++)
 					{
 						blit_line(line_ptr, ptr, pitch);
-						dc->engine->blit_line(dc,
+						rtgui_dc_blit_line(dc,
 							dst_rect->x1, dst_rect->x1 + w,
 							dst_rect->y1 + y, 
 							line_ptr);
@@ -612,7 +612,7 @@ static void rtgui_image_bmp_blit(struct rtgui_image* image, struct rtgui_dc* dc,
 					if (line_ptr != RT_NULL)
 					{
 						blit_line(line_ptr, bmp->line_pixels, pitch);
-						dc->engine->blit_line(dc,
+						rtgui_dc_blit_line(dc,
 							dst_rect->x1, dst_rect->x1 + w,
 							dst_rect->y1 + y, 
 							line_ptr);
@@ -380,7 +380,7 @@ static void rtgui_image_jpeg_unload(struct rtgui_image* image)
 
 static void rtgui_image_jpeg_blit(struct rtgui_image* image, struct rtgui_dc* dc, struct rtgui_rect* rect)
 {
-	rt_uint16_t x, y;
+	rt_uint16_t y;
 	rtgui_color_t* ptr;
 	struct rtgui_image_jpeg* jpeg;
 
@@ -393,21 +393,9 @@ static void rtgui_image_jpeg_blit(struct rtgui_image* image, struct rtgui_dc* dc
 	{
 		ptr = (rtgui_color_t*) jpeg->pixels;
 
-		/* draw each point within dc */
-		for (y = 0; y < image->h; y ++)
-		{
-			for (x = 0; x < image->w; x++)
-			{
-				/* not alpha */
-				if ((*ptr >> 24) != 255)
-				{
-					rtgui_dc_draw_color_point(dc, x + rect->x1, y + rect->y1, *ptr);
-				}
-
-				/* move to next color buffer */
-				ptr ++;
-			}
-		}
+		/* draw each line within dc */
+		for (y = 0; y < image->h; y ++, ptr += image->w)
+			rtgui_dc_draw_color_line(dc, rect->x1, y + rect->y1, ptr, image->w);
 	}
 	else 
 	{
@@ -418,17 +406,7 @@ static void rtgui_image_jpeg_blit(struct rtgui_image* image, struct rtgui_dc* dc
 		for (y = 0; y < image->h; y ++)
 		{
 			ptr = (rtgui_color_t*)rtgui_image_get_line(image, y);
-			for (x = 0; x < image->w; x++)
-			{
-				/* not alpha */
-				if ((*ptr >> 24) != 255)
-				{
-					rtgui_dc_draw_color_point(dc, x + rect->x1, y + rect->y1, *ptr);
-				}
-
-				/* move to next color buffer */
-				ptr ++;
-			}
+			rtgui_dc_draw_color_line(dc, rect->x1, y + rect->y1, ptr, image->w);
 		}
 	}
 }
@@ -1,5 +1,6 @@
 #include <rtthread.h>
 #include <rtgui/rtgui_system.h>
+#include <rtgui/dc.h>
 
 #ifdef RTGUI_IMAGE_PNG
 #include "png.h"
@@ -42,68 +43,75 @@ static void rtgui_image_png_read_data(png_structp png_ptr, png_bytep data, png_s
 	rtgui_filerw_read(filerw, data, length, 1);
 }
 
+/*
+ * convert a row of png to ARGB888 colors, whose alpha is the opacity, so the
+ * pixels are blended on dc by RTGUI_BLENDMODE_BLEND.
+ */
+static void rtgui_image_png_convert(png_infop info_ptr, png_bytep row, rtgui_color_t *ptr, rt_uint32_t width)
+{
+	rt_uint32_t x;
+	png_bytep data;
+
+	switch (info_ptr->color_type)
+	{
+	case PNG_COLOR_TYPE_RGB:
+		for (x = 0; x < width; x++)
+		{
+			data = &(row[x * 3]);
+			ptr[x] = RTGUI_RGB(data[0], data[1], data[2]);
+		}
+		break;
+
+	case PNG_COLOR_TYPE_RGBA:
+		for (x = 0; x < width; x++)
+		{
+			data = &(row[x * 4]);
+			ptr[x] = RTGUI_ARGB(data[3], data[0], data[1], data[2]);
+		}
+		break;
+
+	case PNG_COLOR_TYPE_PALETTE:
+		for (x = 0; x < width; x++)
+		{
+			data = &(row[x]);
+			ptr[x] = RTGUI_RGB(info_ptr->palette[data[0]].red,
+				info_ptr->palette[data[0]].green,
+				info_ptr->palette[data[0]].blue);
+		}
+		break;
+
+	default:
+		break;
+	}
+}
+
+/* the blend mode of the png, the opaque one is copied */
+rt_inline rt_uint8_t rtgui_image_png_blend_mode(png_infop info_ptr)
+{
+	if (info_ptr->color_type & PNG_COLOR_MASK_ALPHA) return RTGUI_BLENDMODE_BLEND;
+
+	return RTGUI_BLENDMODE_NONE;
+}
+
 static rt_bool_t rtgui_image_png_process(png_structp png_ptr, png_infop info_ptr, struct rtgui_image_png* png)
 {
-    rt_uint32_t x, y;
-    png_bytep row;
-    png_bytep data;
-    rtgui_color_t *ptr;
+	rt_uint32_t y;
+	png_bytep row;
+	rtgui_color_t *ptr;
 
 	row = (png_bytep) rtgui_malloc (png_get_rowbytes(png_ptr, info_ptr));
 	if (row == RT_NULL) return RT_FALSE;
 
-    ptr = (rtgui_color_t *)png->pixels;
-
-    switch (info_ptr->color_type)
-    {
-		case PNG_COLOR_TYPE_RGB:
-			for (y = 0; y < info_ptr->height; y++)
-			{
-				png_read_row(png_ptr, row, png_bytep_NULL);
-				for (x = 0; x < info_ptr->width; x++)
-				{
-					data = &(row[x * 3]);
-
-					ptr[x+y*info_ptr->width] = RTGUI_RGB(data[0], data[1], data[2]);
-				}
-			}
-			break;
-
-        case PNG_COLOR_TYPE_RGBA:
-            for (y = 0; y < info_ptr->height; y++)
-            {
-				png_read_row(png_ptr, row, png_bytep_NULL);
-                for (x = 0; x < info_ptr->width; x++)
-                {
-                    data = &(row[x * 4]);
-
-                    ptr[x+y*info_ptr->width] = RTGUI_ARGB((255 - data[3]), data[0], data[1], data[2]);
-                }
-            }
-
-            break;
-
-        case PNG_COLOR_TYPE_PALETTE:
-            for (y = 0; y < info_ptr->height; y++)
-            {
-				png_read_row(png_ptr, row, png_bytep_NULL);
-                for (x = 0; x < info_ptr->width; x++)
-                {
-                    data = &(row[x]);
-
-					ptr[x] = RTGUI_ARGB(0, info_ptr->palette[data[0]].red,
-						info_ptr->palette[data[0]].green,
-						info_ptr->palette[data[0]].blue);
-                }
-            }
-
-        default:
-            break;
-    };
-
-    rtgui_free(row);
-
-    return RT_TRUE;
+	ptr = (rtgui_color_t *)png->pixels;
+	for (y = 0; y < info_ptr->height; y++)
+	{
+		png_read_row(png_ptr, row, png_bytep_NULL);
+		rtgui_image_png_convert(info_ptr, row, ptr + y * info_ptr->width, info_ptr->width);
+	}
+
+	rtgui_free(row);
+
+	return RT_TRUE;
 }
 
 static rt_bool_t rtgui_image_png_check(struct rtgui_filerw* file)
@@ -242,8 +250,8 @@ static void rtgui_image_png_unload(struct rtgui_image* image)
 
 static void rtgui_image_png_blit(struct rtgui_image* image, struct rtgui_dc* dc, struct rtgui_rect* rect)
 {
-	rt_uint16_t x, y, w, h;
-	rtgui_color_t* ptr;
+	rt_uint16_t y, w, h;
+	rtgui_rect_t blit_rect;
 	struct rtgui_image_png* png;
 
 	RT_ASSERT(image != RT_NULL && dc != RT_NULL && rect != RT_NULL);
@@ -251,78 +259,51 @@ static void rtgui_image_png_blit(struct rtgui_image* image, struct rtgui_dc* dc,
 
 	png = (struct rtgui_image_png*) image->data;
 
-    if (image->w < rtgui_rect_width(*rect)) w = image->w;
-    else w = rtgui_rect_width(*rect);
-    if (image->h < rtgui_rect_height(*rect)) h = image->h;
-    else h = rtgui_rect_height(*rect);
-
-    if (png->pixels != RT_NULL)
-    {
-        ptr = (rtgui_color_t*)png->pixels;
-        /* draw each point within dc */
-        for (y = 0; y < h; y ++)
-        {
-            for (x = 0; x < w; x++)
-            {
-                /* not alpha */
-                if ((*ptr >> 24) != 255)
-                {
-                    rtgui_dc_draw_color_point(dc, x + rect->x1, y + rect->y1, *ptr);
-                }
-
-                /* move to next color buffer */
-                ptr ++;
-            }
-        }
-    }
-    else
-    {
-        png_bytep row;
-        png_bytep data;
-
-        row = (png_bytep) rtgui_malloc (png_get_rowbytes(png->png_ptr, png->info_ptr));
-        if (row == RT_NULL) return ;
-
-        switch (png->info_ptr->color_type)
-        {
-        case PNG_COLOR_TYPE_RGBA:
-            for (y = 0; y < h; y++)
-            {
-                png_read_row(png->png_ptr, row, png_bytep_NULL);
-                for (x = 0; x < w; x++)
-                {
-                    data = &(row[x * 4]);
-                    if (data[3] != 0)
-                    {
-                        rtgui_dc_draw_color_point(dc, x + rect->x1, y + rect->y1, 
-							RTGUI_ARGB((255 - data[3]), data[0], data[1], data[2]));
-                    }
-                }
-            }
-
-            break;
-
-        case PNG_COLOR_TYPE_PALETTE:
-            for (y = 0; y < h; y++)
-            {
-                png_read_row(png->png_ptr, row, png_bytep_NULL);
-                for (x = 0; x < w; x++)
-                {
-                    data = &(row[x]);
-
-                    rtgui_dc_draw_color_point(dc, x + rect->x1, y + rect->y1,
-						RTGUI_ARGB(0, png->info_ptr->palette[data[0]].red,
-						png->info_ptr->palette[data[0]].green,
-						png->info_ptr->palette[data[0]].blue));
-                }
-            }
-
-        default:
-            break;
-        };
-
-        rtgui_free(row);
-    }
+	if (image->w < rtgui_rect_width(*rect)) w = image->w;
+	else w = rtgui_rect_width(*rect);
+	if (image->h < rtgui_rect_height(*rect)) h = image->h;
+	else h = rtgui_rect_height(*rect);
+
+	blit_rect.x1 = rect->x1;
+	blit_rect.y1 = rect->y1;
+	blit_rect.x2 = rect->x1 + w;
+	blit_rect.y2 = rect->y1 + h;
+
+	if (png->pixels != RT_NULL)
+	{
+		/* blend all pixels within dc */
+		rtgui_dc_blend_pixels(dc, png->pixels, image->w * sizeof(rtgui_color_t),
+			&blit_rect, rtgui_image_png_blend_mode(png->info_ptr));
+	}
+	else
+	{
+		png_bytep row;
+		rtgui_color_t *line;
+
+		row = (png_bytep) rtgui_malloc (png_get_rowbytes(png->png_ptr, png->info_ptr));
+		if (row == RT_NULL) return ;
+		line = (rtgui_color_t*) rtgui_malloc (image->w * sizeof(rtgui_color_t));
+		if (line == RT_NULL)
+		{
+			rtgui_free(row);
+			return ;
+		}
+
+		/* blend each row within dc */
+		for (y = 0; y < h; y++)
+		{
+			png_read_row(png->png_ptr, row, png_bytep_NULL);
+			rtgui_image_png_convert(png->info_ptr, row, line, w);
+
+			blit_rect.y2 = blit_rect.y1 + 1;
+			rtgui_dc_blend_pixels(dc, (rt_uint8_t*)line, image->w * sizeof(rtgui_color_t),
+				&blit_rect, rtgui_image_png_blend_mode(png->info_ptr));
+			blit_rect.y1 ++;
+		}
+
+		rtgui_free(line);
+		rtgui_free(row);
+	}
 }
 
 void rtgui_image_png_init()
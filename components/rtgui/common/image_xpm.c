@@ -584,7 +584,7 @@ static void rtgui_image_xpm_unload(struct rtgui_image* image)
 
 static void rtgui_image_xpm_blit(struct rtgui_image* image, struct rtgui_dc* dc, struct rtgui_rect* rect)
 {
-	rt_uint16_t x, y;
+	rt_uint16_t y;
 	rtgui_color_t* ptr;
 
 	RT_ASSERT(image != RT_NULL && dc != RT_NULL && rect != RT_NULL);
@@ -592,20 +592,8 @@ static void rtgui_image_xpm_blit(struct rtgui_image* image, struct rtgui_dc* dc,
 
 	ptr = (rtgui_color_t*) image->data;
 
-	/* draw each point within dc */
-	for (y = 0; y < image->h; y ++)
-	{
-		for (x = 0; x < image->w; x++)
-		{
-			/* not alpha */
-			if ((*ptr >> 24) != 255)
-			{
-				rtgui_dc_draw_color_point(dc, x + rect->x1, y + rect->y1, *ptr);
-			}
-
-			/* move to next color buffer */
-			ptr ++;
-		}
-	}
+	/* draw each line within dc */
+	for (y = 0; y < image->h; y ++, ptr += image->w)
+		rtgui_dc_draw_color_line(dc, rect->x1, y + rect->y1, ptr, image->w);
 }
 #endif
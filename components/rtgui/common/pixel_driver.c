@@ -1,15 +1,114 @@
 #include <rtgui/rtgui_system.h>
+#include <rtgui/rtgui_application.h>
 #include <rtgui/driver.h>
 
 #define gfx_device		(rtgui_graphic_get_device()->device)
 #define gfx_device_ops 	rt_graphix_ops(gfx_device)
+#define gfx_ext_ops		(rtgui_graphic_get_device()->ext_ops)
+
+#ifdef RTGUI_USING_PIXEL_SPAN
+/*
+ * A run of set_pixel from left to right in a line is kept in the span of GUI
+ * thread, which is written by blit_line when the run breaks, another operation
+ * is invoked or the drawing ends. The thread without rtgui_application writes
+ * the pixel directly.
+ */
+rt_inline struct rtgui_pixel_span* _pixel_span(void)
+{
+	struct rtgui_application *app;
+
+	app = rtgui_application_self();
+	return app != RT_NULL? &(app->span) : RT_NULL;
+}
+
+static void _pixel_span_write(struct rtgui_pixel_span *span)
+{
+	if (span->count == 1)
+		gfx_device_ops->set_pixel((char*)span->pixels, span->x, span->y);
+	else
+		gfx_device_ops->blit_line((char*)span->pixels, span->x, span->y, span->count);
+
+	span->count = 0;
+}
+
+static void _pixel_flush(void)
+{
+	struct rtgui_pixel_span *span;
+
+	span = _pixel_span();
+	if (span != RT_NULL && span->count != 0)
+		_pixel_span_write(span);
+}
+
+static void _pixel_set_pixel(const char *pixel, int x, int y)
+{
+	struct rtgui_pixel_span *span;
+	int size;
+
+	span = _pixel_span();
+	if (span == RT_NULL)
+	{
+		gfx_device_ops->set_pixel(pixel, x, y);
+		return;
+	}
+
+	if (span->count != 0 && (y != span->y || x != span->x + span->count ||
+		span->count == RTGUI_PIXEL_SPAN_SIZE))
+		_pixel_span_write(span);
+
+	if (span->count == 0)
+	{
+		span->x = x;
+		span->y = y;
+	}
+
+	size = rtgui_graphic_get_device()->bits_per_pixel/8;
+	rt_memcpy(span->pixels + span->count * size, pixel, size);
+	span->count ++;
+}
+
+#define PIXEL_FLUSH()		_pixel_flush()
+#define PIXEL_FLUSH_OP		_pixel_flush
+#else
+#define _pixel_set_pixel(pixel, x, y)	gfx_device_ops->set_pixel(pixel, x, y)
+#define PIXEL_FLUSH()
+#define PIXEL_FLUSH_OP		RT_NULL
+#endif
+
+rt_inline void _pixel_rect_info(struct rt_device_rect_info *info, struct rtgui_rect *rect)
+{
+	info->x = rect->x1;
+	info->y = rect->y1;
+	info->width = rect->x2 - rect->x1;
+	info->height = rect->y2 - rect->y1;
+}
+
+/* fill the rect by 2D accelerator, or in lines */
+static void _pixel_fill_rect(const char *pixel, struct rtgui_rect *rect)
+{
+	int y;
+
+	PIXEL_FLUSH();
+
+	if (gfx_ext_ops != RT_NULL && gfx_ext_ops->fill_rect != RT_NULL)
+	{
+		struct rt_device_rect_info info;
+
+		_pixel_rect_info(&info, rect);
+		gfx_ext_ops->fill_rect(pixel, &info);
+		return;
+	}
+
+	for (y = rect->y1; y < rect->y2; y ++)
+		gfx_device_ops->draw_hline(pixel, rect->x1, rect->x2, y);
+}
 
 static void _pixel_rgb565p_set_pixel(rtgui_color_t *c, int x, int y)
 {
 	rt_uint16_t pixel;
 
 	pixel = rtgui_color_to_565p(*c);
-	gfx_device_ops->set_pixel((char*)&pixel, x, y);
+	_pixel_set_pixel((char*)&pixel, x, y);
 }
 
 static void _pixel_rgb565_set_pixel(rtgui_color_t *c, int x, int y)
@@ -17,7 +116,7 @@ static void _pixel_rgb565_set_pixel(rtgui_color_t *c, int x, int y)
 	rt_uint16_t pixel;
 
 	pixel = rtgui_color_to_565(*c);
-	gfx_device_ops->set_pixel((char*)&pixel, x, y);
+	_pixel_set_pixel((char*)&pixel, x, y);
 }
 
 static void _pixel_rgb888_set_pixel(rtgui_color_t *c, int x, int y)
@@ -25,13 +124,14 @@ static void _pixel_rgb888_set_pixel(rtgui_color_t *c, int x, int y)
 	rt_uint32_t pixel;
 
 	pixel = rtgui_color_to_888(*c);
-	gfx_device_ops->set_pixel((char*)&pixel, x, y);
+	_pixel_set_pixel((char*)&pixel, x, y);
 }
 
 static void _pixel_rgb565p_get_pixel(rtgui_color_t *c, int x, int y)
 {
 	rt_uint16_t pixel;
 
+	PIXEL_FLUSH();
 	gfx_device_ops->get_pixel((char*)&pixel, x, y);
 	*c = rtgui_color_from_565p(pixel);
 }
@@ -40,6 +140,7 @@ static void _pixel_rgb565_get_pixel(rtgui_color_t *c, int x, int y)
 {
 	rt_uint16_t pixel;
 
+	PIXEL_FLUSH();
 	gfx_device_ops->get_pixel((char*)&pixel, x, y);
 	*c = rtgui_color_from_565(pixel);
 }
@@ -48,6 +149,7 @@ static void _pixel_rgb888_get_pixel(rtgui_color_t *c, int x, int y)
 {
 	rt_uint32_t pixel;
 
+	PIXEL_FLUSH();
 	gfx_device_ops->get_pixel((char*)&pixel, x, y);
 	*c = rtgui_color_from_888(pixel);
 }
@@ -57,6 +159,7 @@ static void _pixel_rgb565p_draw_hline(rtgui_color_t *c, int x1, int x2, int y)
 	rt_uint16_t pixel;
 
 	pixel = rtgui_color_to_565p(*c);
+	PIXEL_FLUSH();
 	gfx_device_ops->draw_hline((char*)&pixel, x1, x2, y);
 }
 
@@ -65,6 +168,7 @@ static void _pixel_rgb565_draw_hline(rtgui_color_t *c, int x1, int x2, int y)
 	rt_uint16_t pixel;
 
 	pixel = rtgui_color_to_565(*c);
+	PIXEL_FLUSH();
 	gfx_device_ops->draw_hline((char*)&pixel, x1, x2, y);
 }
 
@@ -73,6 +177,7 @@ static void _pixel_rgb888_draw_hline(rtgui_color_t *c, int x1, int x2, int y)
 	rt_uint32_t pixel;
 
 	pixel = rtgui_color_to_888(*c);
+	PIXEL_FLUSH();
 	gfx_device_ops->draw_hline((char*)&pixel, x1, x2, y);
 }
 
@@ -81,6 +186,7 @@ static void _pixel_rgb565p_draw_vline(rtgui_color_t *c, int x, int y1, int y2)
 	rt_uint16_t pixel;
 
 	pixel = rtgui_color_to_565p(*c);
+	PIXEL_FLUSH();
 	gfx_device_ops->draw_vline((char*)&pixel, x, y1, y2);
 }
 
@@ -89,6 +195,7 @@ static void _pixel_rgb565_draw_vline(rtgui_color_t *c, int x, int y1, int y2)
 	rt_uint16_t pixel;
 
 	pixel = rtgui_color_to_565(*c);
+	PIXEL_FLUSH();
 	gfx_device_ops->draw_vline((char*)&pixel, x, y1, y2);
 }
 
@@ -97,17 +204,154 @@ static void _pixel_rgb888_draw_vline(rtgui_color_t *c, int x, int y1, int y2)
 	rt_uint32_t pixel;
 
 	pixel = rtgui_color_to_888(*c);
+	PIXEL_FLUSH();
 	gfx_device_ops->draw_vline((char*)&pixel, x, y1, y2);
 }
 
 static void _pixel_draw_raw_hline(rt_uint8_t *pixels, int x1, int x2, int y)
 {
+	PIXEL_FLUSH();
 	if (x2 > x1)
 		gfx_device_ops->blit_line((char*)pixels, x1, y, (x2 - x1));
 	else
 		gfx_device_ops->blit_line((char*)pixels, x2, y, (x1 - x2));	
 }
 
+static void _pixel_rgb565p_fill_rect(rtgui_color_t *c, struct rtgui_rect *rect)
+{
+	rt_uint16_t pixel;
+
+	pixel = rtgui_color_to_565p(*c);
+	_pixel_fill_rect((char*)&pixel, rect);
+}
+
+static void _pixel_rgb565_fill_rect(rtgui_color_t *c, struct rtgui_rect *rect)
+{
+	rt_uint16_t pixel;
+
+	pixel = rtgui_color_to_565(*c);
+	_pixel_fill_rect((char*)&pixel, rect);
+}
+
+static void _pixel_rgb888_fill_rect(rtgui_color_t *c, struct rtgui_rect *rect)
+{
+	rt_uint32_t pixel;
+
+	pixel = rtgui_color_to_888(*c);
+	_pixel_fill_rect((char*)&pixel, rect);
+}
+
+static void _pixel_blit_rect(rt_uint8_t *pixels, int pitch, struct rtgui_rect *rect)
+{
+	int y;
+
+	PIXEL_FLUSH();
+
+	if (gfx_ext_ops != RT_NULL && gfx_ext_ops->blit_rect != RT_NULL)
+	{
+		struct rt_device_rect_info info;
+
+		_pixel_rect_info(&info, rect);
+		gfx_ext_ops->blit_rect((const char*)pixels, pitch, &info);
+		return;
+	}
+
+	for (y = rect->y1; y < rect->y2; y ++, pixels += pitch)
+		gfx_device_ops->blit_line((char*)pixels, rect->x1, y, rect->x2 - rect->x1);
+}
+
+static void _pixel_copy_area(struct rtgui_rect *rect, int x, int y)
+{
+	rt_uint32_t pixel;
+	int dx, dy, row, column;
+
+	PIXEL_FLUSH();
+	if (gfx_ext_ops != RT_NULL && gfx_ext_ops->copy_area != RT_NULL)
+	{
+		struct rt_device_rect_info info;
+
+		_pixel_rect_info(&info, rect);
+		gfx_ext_ops->copy_area(&info, x, y);
+		return;
+	}
+
+	/* copy in device pixel, the source is read before it's overwritten */
+	dx = x - rect->x1;
+	dy = y - rect->y1;
+	for (row = 0; row < rect->y2 - rect->y1; row ++)
+	{
+		int py = dy > 0? rect->y2 - 1 - row : rect->y1 + row;
+
+		for (column = 0; column < rect->x2 - rect->x1; column ++)
+		{
+			int px = dx > 0? rect->x2 - 1 - column : rect->x1 + column;
+
+			gfx_device_ops->get_pixel((char*)&pixel, px, py);
+			gfx_device_ops->set_pixel((char*)&pixel, px + dx, py + dy);
+		}
+	}
+}
+
+static rt_uint32_t _pixel_rgb565p_map_color(rtgui_color_t c)
+{
+	return rtgui_color_to_565p(c);
+}
+
+static rt_uint32_t _pixel_rgb565_map_color(rtgui_color_t c)
+{
+	return rtgui_color_to_565(c);
+}
+
+static rt_uint32_t _pixel_rgb888_map_color(rtgui_color_t c)
+{
+	return rtgui_color_to_888(c);
+}
+
+/* the operations in device pixel of 16 bits */
+static void _pixel16_set_pixel_native(rt_uint32_t pixel, int x, int y)
+{
+	rt_uint16_t value;
+
+	value = (rt_uint16_t)pixel;
+	_pixel_set_pixel((char*)&value, x, y);
+}
+
+static void _pixel16_draw_hline_native(rt_uint32_t pixel, int x1, int x2, int y)
+{
+	rt_uint16_t value;
+
+	value = (rt_uint16_t)pixel;
+	PIXEL_FLUSH();
+	gfx_device_ops->draw_hline((char*)&value, x1, x2, y);
+}
+
+static void _pixel16_draw_vline_native(rt_uint32_t pixel, int x, int y1, int y2)
+{
+	rt_uint16_t value;
+
+	value = (rt_uint16_t)pixel;
+	PIXEL_FLUSH();
+	gfx_device_ops->draw_vline((char*)&value, x, y1, y2);
+}
+
+/* the operations in device pixel of 32 bits */
+static void _pixel32_set_pixel_native(rt_uint32_t pixel, int x, int y)
+{
+	_pixel_set_pixel((char*)&pixel, x, y);
+}
+
+static void _pixel32_draw_hline_native(rt_uint32_t pixel, int x1, int x2, int y)
+{
+	PIXEL_FLUSH();
+	gfx_device_ops->draw_hline((char*)&pixel, x1, x2, y);
+}
+
+static void _pixel32_draw_vline_native(rt_uint32_t pixel, int x, int y1, int y2)
+{
+	PIXEL_FLUSH();
+	gfx_device_ops->draw_vline((char*)&pixel, x, y1, y2);
+}
+
 /* pixel device */
 const struct rtgui_graphic_driver_ops _pixel_rgb565p_ops = 
 {
@@ -116,6 +360,15 @@ const struct rtgui_graphic_driver_ops _pixel_rgb565p_ops =
 	_pixel_rgb565p_draw_hline,
 	_pixel_rgb565p_draw_vline,
 	_pixel_draw_raw_hline,
+	_pixel_rgb565p_fill_rect,
+	_pixel_blit_rect,
+	_pixel_copy_area,
+	PIXEL_FLUSH_OP,
+	_pixel_rgb565p_map_color,
+	_pixel16_set_pixel_native,
+	_pixel16_draw_hline_native,
+	_pixel16_draw_vline_native,
+	RT_NULL,
 };
 
 const struct rtgui_graphic_driver_ops _pixel_rgb565_ops = 
@@ -125,6 +378,15 @@ const struct rtgui_graphic_driver_ops _pixel_rgb565_ops =
 	_pixel_rgb565_draw_hline,
 	_pixel_rgb565_draw_vline,
 	_pixel_draw_raw_hline,
+	_pixel_rgb565_fill_rect,
+	_pixel_blit_rect,
+	_pixel_copy_area,
+	PIXEL_FLUSH_OP,
+	_pixel_rgb565_map_color,
+	_pixel16_set_pixel_native,
+	_pixel16_draw_hline_native,
+	_pixel16_draw_vline_native,
+	RT_NULL,
 };
 
 const struct rtgui_graphic_driver_ops _pixel_rgb888_ops = 
@@ -134,6 +396,15 @@ const struct rtgui_graphic_driver_ops _pixel_rgb888_ops =
 	_pixel_rgb888_draw_hline,
 	_pixel_rgb888_draw_vline,
 	_pixel_draw_raw_hline,
+	_pixel_rgb888_fill_rect,
+	_pixel_blit_rect,
+	_pixel_copy_area,
+	PIXEL_FLUSH_OP,
+	_pixel_rgb888_map_color,
+	_pixel32_set_pixel_native,
+	_pixel32_draw_hline_native,
+	_pixel32_draw_vline_native,
+	RT_NULL,
 };
 
 const struct rtgui_graphic_driver_ops *rtgui_pixel_device_get_ops(int pixel_format)
@@ -13,6 +13,7 @@
  */
 #include <rtgui/region.h>
 #include <rtgui/rtgui_system.h>
+#include <rtgui/rtgui_stats.h>
 
 /* #define good(reg) RT_ASSERT(rtgui_region16_valid(reg)) */
 #define good(reg)
@@ -157,7 +158,7 @@ if (!(pReg)->data || (((pReg)->data->numRects + (n)) > (pReg)->data->size)) \
 if (((numRects) < ((reg)->data->size >> 1)) && ((reg)->data->size > 50)) \
 {									 \
     rtgui_region_data_t * NewData;							 \
-    NewData = (rtgui_region_data_t *)rt_realloc((reg)->data, PIXREGION_SZOF(numRects));	 \
+    NewData = (rtgui_region_data_t *)rtgui_realloc((reg)->data, PIXREGION_SZOF(numRects));	 \
     if (NewData)							 \
     {									 \
 	NewData->size = (numRects);					 \
@@ -238,7 +239,7 @@ static rtgui_region_status_t rtgui_rect_alloc(rtgui_region_t * region, int n)
 				n = 250;
 		}
 		n += region->data->numRects;
-		data = (rtgui_region_data_t *)rt_realloc(region->data, PIXREGION_SZOF(n));
+		data = (rtgui_region_data_t *)rtgui_realloc(region->data, PIXREGION_SZOF(n));
 		if (!data) return rtgui_break (region);
 		region->data = data;
 	}
@@ -838,6 +839,7 @@ rtgui_region_intersect(rtgui_region_t *newReg,
 						rtgui_region_t *reg1,
 						rtgui_region_t *reg2)
 {
+	RTGUI_STATS_REGION(RTGUI_STATS_REGION_INTERSECT, PIXREGION_NUM_RECTS(reg1) + PIXREGION_NUM_RECTS(reg2));
 	good(reg1);
 	good(reg2);
 	good(newReg);
@@ -901,6 +903,7 @@ rtgui_region_intersect_rect(rtgui_region_t *newReg,
 {
 	rtgui_region_t region;
 
+	RTGUI_STATS_REGION(RTGUI_STATS_REGION_INTERSECT_RECT, PIXREGION_NUM_RECTS(reg1) + 1);
 	region.data = RT_NULL;
 	region.extents.x1 = rect->x1;
 	region.extents.y1 = rect->y1;
@@ -1012,6 +1015,7 @@ rtgui_region_union_rect(rtgui_region_t *dest, rtgui_region_t *source, rtgui_rect
 {
 	rtgui_region_t region;
 
+	RTGUI_STATS_REGION(RTGUI_STATS_REGION_UNION_RECT, PIXREGION_NUM_RECTS(source) + 1);
 	region.data = RT_NULL;
 	region.extents.x1 = rect->x1;
 	region.extents.y1 = rect->y1;
@@ -1026,6 +1030,8 @@ rtgui_region_union(rtgui_region_t *newReg, rtgui_region_t *reg1, rtgui_region_t
 {
 	int overlap; /* result ignored */
 
+	RTGUI_STATS_REGION(RTGUI_STATS_REGION_UNION, PIXREGION_NUM_RECTS(reg1) + PIXREGION_NUM_RECTS(reg2));
+
 	/* Return RTGUI_REGION_STATUS_SUCCESS if some overlap between reg1, reg2 */
 	good(reg1);
 	good(reg2);
@@ -1421,7 +1427,7 @@ rtgui_region_status_t rtgui_region_validate(rtgui_region_t * badreg,
 		{
 			/* Oops, allocate space for new region information */
 			sizeRI <<= 1;
-			rit = (RegionInfo *) rt_realloc(ri, sizeRI * sizeof(RegionInfo));
+			rit = (RegionInfo *) rtgui_realloc(ri, sizeRI * sizeof(RegionInfo));
 			if (!rit)
 				goto bail;
 			ri = rit;
@@ -1640,6 +1646,8 @@ rtgui_region_subtract(rtgui_region_t *regD,
 {
 	int overlap; /* result ignored */
 
+	RTGUI_STATS_REGION(RTGUI_STATS_REGION_SUBTRACT, PIXREGION_NUM_RECTS(regM) + PIXREGION_NUM_RECTS(regS));
+
 	good(regM);
 	good(regS);
 	good(regD);
@@ -1682,6 +1690,7 @@ rtgui_region_subtract_rect (rtgui_region_t *regD, rtgui_region_t *regM, rtgui_re
 {
 	rtgui_region_t region;
 
+	RTGUI_STATS_REGION(RTGUI_STATS_REGION_SUBTRACT_RECT, PIXREGION_NUM_RECTS(regM) + 1);
 	region.data = RT_NULL;
 	region.extents.x1 = rect->x1;
 	region.extents.y1 = rect->y1;
@@ -1721,6 +1730,7 @@ rtgui_region_inverse(rtgui_region_t *newReg,       /* Destination region */
 
 	good(reg1);
 	good(newReg);
+	RTGUI_STATS_REGION(RTGUI_STATS_REGION_INVERSE, PIXREGION_NUM_RECTS(reg1) + 1);
 	/* check for trivial rejects */
 	if (PIXREGION_NIL(reg1) || !EXTENTCHECK(invRect, &reg1->extents))
 	{
@@ -1866,6 +1876,7 @@ void rtgui_region_translate (rtgui_region_t *region, int x, int y)
 	int nbox;
 	rtgui_rect_t * pbox;
 
+	RTGUI_STATS_REGION(RTGUI_STATS_REGION_TRANSLATE, PIXREGION_NUM_RECTS(region));
 	good(region);
 	region->extents.x1 = x1 = region->extents.x1 + x;
 	region->extents.y1 = y1 = region->extents.y1 + y;
@@ -1873,8 +1884,7 @@ void rtgui_region_translate (rtgui_region_t *region, int x, int y)
 	region->extents.y2 = y2 = region->extents.y2 + y;
 	if (((x1 - RTGUI_SHRT_MIN)|(y1 - RTGUI_SHRT_MIN)|(RTGUI_SHRT_MAX - x2)|(RTGUI_SHRT_MAX - y2)) >= 0)
 	{
-		nbox = region->data->numRects;
-		if (region->data && nbox)
+		if (region->data && (nbox = region->data->numRects))
 		{
 			for (pbox = PIXREGION_BOXPTR(region); nbox--; pbox++)
 			{
@@ -1903,8 +1913,7 @@ void rtgui_region_translate (rtgui_region_t *region, int x, int y)
 	else if (y2 > RTGUI_SHRT_MAX)
 		region->extents.y2 = RTGUI_SHRT_MAX;
 
-	nbox = region->data->numRects;
-	if (region->data && nbox)
+	if (region->data && (nbox = region->data->numRects))
 	{
 		rtgui_rect_t * pboxout;
 
@@ -1962,6 +1971,7 @@ int rtgui_region_contains_point(rtgui_region_t * region,
 
 	good(region);
 	numRects = PIXREGION_NUM_RECTS(region);
+	RTGUI_STATS_REGION(RTGUI_STATS_REGION_CONTAINS_POINT, numRects);
 	if (!numRects || !INBOX(&region->extents, x, y))
 		return -RT_ERROR;
 
@@ -1988,6 +1998,36 @@ int rtgui_region_contains_point(rtgui_region_t * region,
 	return -RT_ERROR;
 }
 
+/*
+ * The rects of region are banded in y and sorted in x in each band, and the
+ * rects of a band have the same y1 and y2. Return the first rect of the band
+ * which contains y or is below y, by binary search on y2.
+ */
+rtgui_rect_t *rtgui_region_find_band(rtgui_region_t *region, int y, rtgui_rect_t **end)
+{
+	rtgui_rect_t *begin, *middle;
+	int count, half;
+
+	good(region);
+	begin = PIXREGION_RECTS(region);
+	count = PIXREGION_NUM_RECTS(region);
+	*end = begin + count;
+
+	while (count > 0)
+	{
+		half = count / 2;
+		middle = begin + half;
+		if (middle->y2 <= y)
+		{
+			begin = middle + 1;
+			count -= half + 1;
+		}
+		else count = half;
+	}
+
+	return begin;
+}
+
 int rtgui_region_not_empty(rtgui_region_t * region)
 {
 	good(region);
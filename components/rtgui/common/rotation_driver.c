@@ -0,0 +1,529 @@
+/*
+ * File      : rotation_driver.c
+ * This file is part of RTGUI in RT-Thread RTOS
+ * COPYRIGHT (C) 2006 - 2012, RT-Thread Development Team
+ *
+ * The license and distribution terms for this file may be
+ * found in the file LICENSE in this distribution or at
+ * http://www.rt-thread.org/license/LICENSE
+ */
+#include <rtgui/rtgui_system.h>
+#include <rtgui/driver.h>
+
+/*
+ * The rotated screen is drawn by the operations of device in its native
+ * orientation. The logic point (x, y) of a screen rotated clockwise is on
+ * device at:
+ *   90:  (device_width - 1 - y, x)
+ *   180: (device_width - 1 - x, device_height - 1 - y)
+ *   270: (y, device_height - 1 - x)
+ * so a logic line of 90 and 270 is a column of device. The raw pixels of a
+ * rect are transposed to framebuffer in tiles, the lines of source and
+ * destination of a tile stay in cache.
+ */
+#define device_ops				(rtgui_graphic_get_device()->device_ops)
+
+/* the tile of framebuffer transpose in pixel */
+#define ROTATION_TILE			16
+/* the pixels reversed or transposed on stack, 4 bytes per pixel at most */
+#define ROTATION_PIECE			64
+#define ROTATION_STACK_TILE		8
+
+static struct rtgui_graphic_driver_ops _rotation_ops;
+
+rt_inline void _rotation_point(int *x, int *y)
+{
+	struct rtgui_graphic_driver *driver = rtgui_graphic_get_device();
+	int t;
+
+	switch (driver->rotation)
+	{
+	case 90:
+		t = *x;
+		*x = driver->device_width - 1 - *y;
+		*y = t;
+		break;
+	case 180:
+		*x = driver->device_width - 1 - *x;
+		*y = driver->device_height - 1 - *y;
+		break;
+	case 270:
+		t = *x;
+		*x = *y;
+		*y = driver->device_height - 1 - t;
+		break;
+	}
+}
+
+/* rotate a logic rect to device, the x2 and y2 are out of rect */
+void rtgui_rotation_rect(const struct rtgui_rect *rect, struct rtgui_rect *device_rect)
+{
+	struct rtgui_graphic_driver *driver = rtgui_graphic_get_device();
+	struct rtgui_rect r = *rect;
+
+	switch (driver->rotation)
+	{
+	case 90:
+		device_rect->x1 = driver->device_width - r.y2;
+		device_rect->x2 = driver->device_width - r.y1;
+		device_rect->y1 = r.x1;
+		device_rect->y2 = r.x2;
+		break;
+	case 180:
+		device_rect->x1 = driver->device_width - r.x2;
+		device_rect->x2 = driver->device_width - r.x1;
+		device_rect->y1 = driver->device_height - r.y2;
+		device_rect->y2 = driver->device_height - r.y1;
+		break;
+	case 270:
+		device_rect->x1 = r.y1;
+		device_rect->x2 = r.y2;
+		device_rect->y1 = driver->device_height - r.x2;
+		device_rect->y2 = driver->device_height - r.x1;
+		break;
+	default:
+		*device_rect = r;
+		break;
+	}
+}
+
+/* the device pixel of a raw line, in the layout of framebuffer_driver.c */
+rt_inline rt_uint32_t _rotation_raw_pixel(const rt_uint8_t *pixels, int index, int bpp)
+{
+	const rt_uint8_t *ptr;
+
+	switch (bpp)
+	{
+	case 1:
+		/* the left one is the least significant bit */
+		return (pixels[index / 8] >> (index % 8)) & 0x01;
+	case 2:
+	case 4:
+		/* the left one is in the most significant bits */
+		return (pixels[index * bpp / 8] >> (8 - bpp - (index * bpp) % 8)) & ((1 << bpp) - 1);
+	case 16:
+		return ((const rt_uint16_t*)pixels)[index];
+	case 24:
+		ptr = pixels + index * 3;
+		return ptr[0] | (ptr[1] << 8) | (ptr[2] << 16);
+	default:
+		return ((const rt_uint32_t*)pixels)[index];
+	}
+}
+
+static void _rotation_set_pixel(rtgui_color_t *c, int x, int y)
+{
+	_rotation_point(&x, &y);
+	device_ops->set_pixel(c, x, y);
+}
+
+static void _rotation_get_pixel(rtgui_color_t *c, int x, int y)
+{
+	_rotation_point(&x, &y);
+	device_ops->get_pixel(c, x, y);
+}
+
+/* a logic hline is a device hline of 180, and a device vline of 90 and 270 */
+static void _rotation_draw_hline(rtgui_color_t *c, int x1, int x2, int y)
+{
+	struct rtgui_rect rect;
+
+	if (x2 <= x1) return;
+
+	rect.x1 = x1; rect.x2 = x2;
+	rect.y1 = y; rect.y2 = y + 1;
+	rtgui_rotation_rect(&rect, &rect);
+	if (rtgui_graphic_get_device()->rotation == 180)
+		device_ops->draw_hline(c, rect.x1, rect.x2, rect.y1);
+	else
+		device_ops->draw_vline(c, rect.x1, rect.y1, rect.y2);
+}
+
+static void _rotation_draw_vline(rtgui_color_t *c, int x, int y1, int y2)
+{
+	struct rtgui_rect rect;
+
+	if (y2 <= y1) return;
+
+	rect.x1 = x; rect.x2 = x + 1;
+	rect.y1 = y1; rect.y2 = y2;
+	rtgui_rotation_rect(&rect, &rect);
+	if (rtgui_graphic_get_device()->rotation == 180)
+		device_ops->draw_vline(c, rect.x1, rect.y1, rect.y2);
+	else
+		device_ops->draw_hline(c, rect.x1, rect.x2, rect.y1);
+}
+
+static void _rotation_set_pixel_native(rt_uint32_t pixel, int x, int y)
+{
+	_rotation_point(&x, &y);
+	device_ops->set_pixel_native(pixel, x, y);
+}
+
+static void _rotation_draw_hline_native(rt_uint32_t pixel, int x1, int x2, int y)
+{
+	struct rtgui_rect rect;
+
+	if (x2 <= x1) return;
+
+	rect.x1 = x1; rect.x2 = x2;
+	rect.y1 = y; rect.y2 = y + 1;
+	rtgui_rotation_rect(&rect, &rect);
+	if (rtgui_graphic_get_device()->rotation == 180)
+		device_ops->draw_hline_native(pixel, rect.x1, rect.x2, rect.y1);
+	else
+		device_ops->draw_vline_native(pixel, rect.x1, rect.y1, rect.y2);
+}
+
+static void _rotation_draw_vline_native(rt_uint32_t pixel, int x, int y1, int y2)
+{
+	struct rtgui_rect rect;
+
+	if (y2 <= y1) return;
+
+	rect.x1 = x; rect.x2 = x + 1;
+	rect.y1 = y1; rect.y2 = y2;
+	rtgui_rotation_rect(&rect, &rect);
+	if (rtgui_graphic_get_device()->rotation == 180)
+		device_ops->draw_vline_native(pixel, rect.x1, rect.y1, rect.y2);
+	else
+		device_ops->draw_hline_native(pixel, rect.x1, rect.x2, rect.y1);
+}
+
+/* draw the raw line in pixel, it's the way of packed pixels */
+static void _rotation_draw_raw_pixels(rt_uint8_t *pixels, int x1, int x2, int y)
+{
+	int x, px, py, bpp;
+
+	bpp = rtgui_graphic_get_device()->bits_per_pixel;
+	for (x = x1; x < x2; x ++)
+	{
+		px = x; py = y;
+		_rotation_point(&px, &py);
+		device_ops->set_pixel_native(_rotation_raw_pixel(pixels, x - x1, bpp), px, py);
+	}
+}
+
+/* copy the column of a raw line to framebuffer, the step is the bytes between device lines */
+rt_inline void _rotation_copy_column(rt_uint8_t *dst, int step, const rt_uint8_t *src, int count, int bytes)
+{
+	for (; count > 0; count --, dst += step, src += bytes)
+	{
+		switch (bytes)
+		{
+		case 2:
+			*(rt_uint16_t*)dst = *(const rt_uint16_t*)src;
+			break;
+		case 3:
+			dst[0] = src[0];
+			dst[1] = src[1];
+			dst[2] = src[2];
+			break;
+		default:
+			*(rt_uint32_t*)dst = *(const rt_uint32_t*)src;
+			break;
+		}
+	}
+}
+
+/* reverse the raw pixels of 1, 2, 3 or 4 bytes */
+static void _rotation_reverse(rt_uint8_t *dst, const rt_uint8_t *src, int count, int bytes)
+{
+	int index;
+
+	src += (count - 1) * bytes;
+	for (; count > 0; count --, dst += bytes, src -= bytes)
+	{
+		for (index = 0; index < bytes; index ++) dst[index] = src[index];
+	}
+}
+
+static void _rotation_draw_raw_hline(rt_uint8_t *pixels, int x1, int x2, int y)
+{
+	struct rtgui_graphic_driver *driver = rtgui_graphic_get_device();
+	struct rtgui_rect rect;
+	int bytes, count;
+
+	if (x2 <= x1) return;
+
+	/* the packed pixels are not in byte */
+	if (driver->bits_per_pixel < 8)
+	{
+		_rotation_draw_raw_pixels(pixels, x1, x2, y);
+		return;
+	}
+
+	bytes = driver->bits_per_pixel / 8;
+	rect.x1 = x1; rect.x2 = x2;
+	rect.y1 = y; rect.y2 = y + 1;
+	rtgui_rotation_rect(&rect, &rect);
+
+	if (driver->rotation == 180)
+	{
+		rt_uint8_t line[ROTATION_PIECE * 4];
+
+		/* the right piece of logic line is the left one of device */
+		for (x1 = rect.x2; x1 > rect.x1; x1 -= count, pixels += count * bytes)
+		{
+			count = x1 - rect.x1;
+			if (count > ROTATION_PIECE) count = ROTATION_PIECE;
+
+			_rotation_reverse(line, pixels, count, bytes);
+			device_ops->draw_raw_hline(line, x1 - count, x1, rect.y1);
+		}
+	}
+	else if (driver->framebuffer != RT_NULL)
+	{
+		rt_uint8_t *dst;
+
+		/* the logic line goes down the column of 90 and up the column of 270 */
+		if (driver->rotation == 90)
+		{
+			dst = (rt_uint8_t*)driver->framebuffer + rect.y1 * driver->pitch + rect.x1 * bytes;
+			_rotation_copy_column(dst, driver->pitch, pixels, x2 - x1, bytes);
+		}
+		else
+		{
+			dst = (rt_uint8_t*)driver->framebuffer + (rect.y2 - 1) * driver->pitch + rect.x1 * bytes;
+			_rotation_copy_column(dst, -driver->pitch, pixels, x2 - x1, bytes);
+		}
+	}
+	else if (device_ops->blit_rect != RT_NULL)
+	{
+		/* a column of one pixel per line */
+		if (driver->rotation == 90)
+			device_ops->blit_rect(pixels, bytes, &rect);
+		else
+			device_ops->blit_rect(pixels + (x2 - x1 - 1) * bytes, -bytes, &rect);
+	}
+	else
+	{
+		_rotation_draw_raw_pixels(pixels, x1, x2, y);
+	}
+}
+
+static void _rotation_fill_rect(rtgui_color_t *c, struct rtgui_rect *rect)
+{
+	struct rtgui_rect device_rect;
+
+	rtgui_rotation_rect(rect, &device_rect);
+	device_ops->fill_rect(c, &device_rect);
+}
+
+/*
+ * transpose the raw pixels of a logic rect to framebuffer in tiles, the
+ * logic x goes along the step_x bytes of device and the logic y goes along
+ * step_y, dst is the device pixel of logic (0, 0).
+ */
+rt_inline void _rotation_transpose(rt_uint8_t *dst, int step_x, int step_y,
+	const rt_uint8_t *pixels, int pitch, int width, int height, int bytes)
+{
+	int tx, ty, x, x_end, y_end;
+
+	for (ty = 0; ty < height; ty += ROTATION_TILE)
+	{
+		y_end = ty + ROTATION_TILE < height? ty + ROTATION_TILE : height;
+		for (tx = 0; tx < width; tx += ROTATION_TILE)
+		{
+			x_end = tx + ROTATION_TILE < width? tx + ROTATION_TILE : width;
+
+			/* a logic column of tile is a part of device line */
+			for (x = tx; x < x_end; x ++)
+			{
+				const rt_uint8_t *src = pixels + ty * pitch + x * bytes;
+				rt_uint8_t *ptr = dst + x * step_x + ty * step_y;
+				int y;
+
+				for (y = ty; y < y_end; y ++, src += pitch, ptr += step_y)
+				{
+					switch (bytes)
+					{
+					case 2:
+						*(rt_uint16_t*)ptr = *(const rt_uint16_t*)src;
+						break;
+					case 3:
+						ptr[0] = src[0];
+						ptr[1] = src[1];
+						ptr[2] = src[2];
+						break;
+					default:
+						*(rt_uint32_t*)ptr = *(const rt_uint32_t*)src;
+						break;
+					}
+				}
+			}
+		}
+	}
+}
+
+/*
+ * transpose the raw pixels of a logic rect in the small tiles on stack, and
+ * draw each tile by the blit_rect of device, it's the way of pixel device.
+ */
+static void _rotation_transpose_blit(const rt_uint8_t *pixels, int pitch, struct rtgui_rect *rect, int bytes)
+{
+	rt_uint8_t tile[ROTATION_STACK_TILE * ROTATION_STACK_TILE * 4];
+	struct rtgui_rect tile_rect, device_rect;
+	int tx, ty, x, y, w, h;
+
+	for (ty = rect->y1; ty < rect->y2; ty += ROTATION_STACK_TILE)
+	{
+		h = rect->y2 - ty < ROTATION_STACK_TILE? rect->y2 - ty : ROTATION_STACK_TILE;
+		for (tx = rect->x1; tx < rect->x2; tx += ROTATION_STACK_TILE)
+		{
+			w = rect->x2 - tx < ROTATION_STACK_TILE? rect->x2 - tx : ROTATION_STACK_TILE;
+
+			tile_rect.x1 = tx; tile_rect.x2 = tx + w;
+			tile_rect.y1 = ty; tile_rect.y2 = ty + h;
+			rtgui_rotation_rect(&tile_rect, &device_rect);
+
+			/* the device tile has h pixels in w lines */
+			for (x = 0; x < w; x ++)
+			{
+				for (y = 0; y < h; y ++)
+				{
+					const rt_uint8_t *src = pixels + (ty - rect->y1 + y) * pitch + (tx - rect->x1 + x) * bytes;
+					int row, column, index;
+
+					if (rtgui_graphic_get_device()->rotation == 90)
+					{
+						row = x; column = h - 1 - y;
+					}
+					else
+					{
+						row = w - 1 - x; column = y;
+					}
+					for (index = 0; index < bytes; index ++)
+						tile[(row * h + column) * bytes + index] = src[index];
+				}
+			}
+			device_ops->blit_rect(tile, h * bytes, &device_rect);
+		}
+	}
+}
+
+static void _rotation_blit_rect(rt_uint8_t *pixels, int pitch, struct rtgui_rect *rect)
+{
+	struct rtgui_graphic_driver *driver = rtgui_graphic_get_device();
+	struct rtgui_rect device_rect;
+	rt_uint8_t *dst;
+	int y, bytes;
+
+	if (rect->x2 <= rect->x1 || rect->y2 <= rect->y1) return;
+
+	/* the packed lines and the lines of 180 are reversed in line */
+	if (driver->bits_per_pixel < 8 || driver->rotation == 180)
+	{
+		for (y = rect->y1; y < rect->y2; y ++, pixels += pitch)
+			_rotation_draw_raw_hline(pixels, rect->x1, rect->x2, y);
+		return;
+	}
+
+	bytes = driver->bits_per_pixel / 8;
+	if (driver->framebuffer == RT_NULL)
+	{
+		_rotation_transpose_blit(pixels, pitch, rect, bytes);
+		return;
+	}
+
+	rtgui_rotation_rect(rect, &device_rect);
+	if (driver->rotation == 90)
+	{
+		/* logic (0, 0) is the right top of device rect */
+		dst = (rt_uint8_t*)driver->framebuffer + device_rect.y1 * driver->pitch + (device_rect.x2 - 1) * bytes;
+		switch (bytes)
+		{
+		case 2: _rotation_transpose(dst, driver->pitch, -2, pixels, pitch, rtgui_rect_width(*rect), rtgui_rect_height(*rect), 2); break;
+		case 3: _rotation_transpose(dst, driver->pitch, -3, pixels, pitch, rtgui_rect_width(*rect), rtgui_rect_height(*rect), 3); break;
+		case 4: _rotation_transpose(dst, driver->pitch, -4, pixels, pitch, rtgui_rect_width(*rect), rtgui_rect_height(*rect), 4); break;
+		}
+	}
+	else
+	{
+		/* logic (0, 0) is the left bottom of device rect */
+		dst = (rt_uint8_t*)driver->framebuffer + (device_rect.y2 - 1) * driver->pitch + device_rect.x1 * bytes;
+		switch (bytes)
+		{
+		case 2: _rotation_transpose(dst, -driver->pitch, 2, pixels, pitch, rtgui_rect_width(*rect), rtgui_rect_height(*rect), 2); break;
+		case 3: _rotation_transpose(dst, -driver->pitch, 3, pixels, pitch, rtgui_rect_width(*rect), rtgui_rect_height(*rect), 3); break;
+		case 4: _rotation_transpose(dst, -driver->pitch, 4, pixels, pitch, rtgui_rect_width(*rect), rtgui_rect_height(*rect), 4); break;
+		}
+	}
+}
+
+static void _rotation_copy_area(struct rtgui_rect *rect, int x, int y)
+{
+	struct rtgui_rect device_rect, dest_rect;
+
+	dest_rect.x1 = x; dest_rect.x2 = x + rtgui_rect_width(*rect);
+	dest_rect.y1 = y; dest_rect.y2 = y + rtgui_rect_height(*rect);
+
+	rtgui_rotation_rect(rect, &device_rect);
+	rtgui_rotation_rect(&dest_rect, &dest_rect);
+	device_ops->copy_area(&device_rect, dest_rect.x1, dest_rect.y1);
+}
+
+static void _rotation_blend_hline(rt_uint8_t *pixels, int mode, int x1, int x2, int y)
+{
+	struct rtgui_rect rect;
+	int x, px, py;
+
+	if (x2 <= x1) return;
+
+	if (rtgui_graphic_get_device()->rotation == 180)
+	{
+		rt_uint8_t line[ROTATION_PIECE * sizeof(rtgui_color_t)];
+		int count;
+
+		rect.x1 = x1; rect.x2 = x2;
+		rect.y1 = y; rect.y2 = y + 1;
+		rtgui_rotation_rect(&rect, &rect);
+		for (x = rect.x2; x > rect.x1; x -= count, pixels += count * sizeof(rtgui_color_t))
+		{
+			count = x - rect.x1;
+			if (count > ROTATION_PIECE) count = ROTATION_PIECE;
+
+			_rotation_reverse(line, pixels, count, sizeof(rtgui_color_t));
+			device_ops->blend_hline(line, mode, x - count, x, rect.y1);
+		}
+		return;
+	}
+
+	/* a pixel per device line */
+	for (x = x1; x < x2; x ++, pixels += sizeof(rtgui_color_t))
+	{
+		px = x; py = y;
+		_rotation_point(&px, &py);
+		device_ops->blend_hline(pixels, mode, px, px + 1, py);
+	}
+}
+
+/*
+ * get the operations of the rotated screen, the optional operations are
+ * RT_NULL when the device doesn't have them.
+ */
+const struct rtgui_graphic_driver_ops *rtgui_rotation_get_ops(const struct rtgui_graphic_driver_ops *ops, int rotation)
+{
+	if (rotation == 0 || ops == RT_NULL) return ops;
+
+#define ROTATION_OP(name, func)	_rotation_ops.name = (ops->name != RT_NULL)? func : RT_NULL
+	ROTATION_OP(set_pixel, _rotation_set_pixel);
+	ROTATION_OP(get_pixel, _rotation_get_pixel);
+	ROTATION_OP(draw_hline, _rotation_draw_hline);
+	ROTATION_OP(draw_vline, _rotation_draw_vline);
+	ROTATION_OP(draw_raw_hline, _rotation_draw_raw_hline);
+	ROTATION_OP(fill_rect, _rotation_fill_rect);
+	ROTATION_OP(blit_rect, _rotation_blit_rect);
+	ROTATION_OP(copy_area, _rotation_copy_area);
+	ROTATION_OP(set_pixel_native, _rotation_set_pixel_native);
+	ROTATION_OP(draw_hline_native, _rotation_draw_hline_native);
+	ROTATION_OP(draw_vline_native, _rotation_draw_vline_native);
+	ROTATION_OP(blend_hline, _rotation_blend_hline);
+#undef ROTATION_OP
+
+	/* the same in any orientation */
+	_rotation_ops.flush = ops->flush;
+	_rotation_ops.map_color = ops->map_color;
+
+	return &_rotation_ops;
+}
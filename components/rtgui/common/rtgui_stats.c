@@ -0,0 +1,226 @@
+/*
+ * File      : rtgui_stats.c
+ * This file is part of RTGUI in RT-Thread RTOS
+ * COPYRIGHT (C) 2006 - 2012, RT-Thread Development Team
+ *
+ * The license and distribution terms for this file may be
+ * found in the file LICENSE in this distribution or at
+ * http://www.rt-thread.org/license/LICENSE
+ */
+
+#include <rtgui/rtgui.h>
+#include <rtgui/rtgui_system.h>
+#include <rtgui/rtgui_application.h>
+#include <rtgui/rtgui_stats.h>
+
+#ifdef RTGUI_USING_STATS
+struct rtgui_stats rtgui_stats =
+{
+	{0}, {0},
+	0, 0, 0, 0,
+	0, 0,
+	0, 0, 0,
+	{{RT_NULL}, "others"},
+};
+
+/* the registered GUI threads */
+static rtgui_list_t _stats_list = {RT_NULL};
+
+static const char* _stats_dc_name[RTGUI_STATS_DC_MAX] =
+{
+	"draw_point", "draw_color_point", "draw_vline", "draw_hline",
+	"fill_rect", "blit_line", "blit", "draw_points",
+	"draw_color_points", "draw_spans"
+};
+
+static const char* _stats_region_name[RTGUI_STATS_REGION_MAX] =
+{
+	"union", "union_rect", "subtract", "subtract_rect",
+	"intersect", "intersect_rect", "inverse", "translate", "contains_point"
+};
+
+void rtgui_stats_thread_init(struct rtgui_stats_thread* stats, const char* name)
+{
+	RT_ASSERT(stats != RT_NULL);
+
+	rt_memset(stats, 0, sizeof(struct rtgui_stats_thread));
+	stats->name = name;
+
+	rtgui_enter_critical();
+	rtgui_list_append(&_stats_list, &(stats->list));
+	rtgui_exit_critical();
+}
+
+void rtgui_stats_thread_detach(struct rtgui_stats_thread* stats)
+{
+	RT_ASSERT(stats != RT_NULL);
+
+	rtgui_enter_critical();
+	rtgui_list_remove(&_stats_list, &(stats->list));
+	rtgui_exit_critical();
+}
+
+void rtgui_stats_dc(int entry, rt_uint32_t pixels)
+{
+	struct rtgui_application* app;
+	struct rtgui_stats_thread* stats;
+
+	app = rtgui_application_self();
+	stats = app != RT_NULL? &(app->stats) : &(rtgui_stats.others);
+
+	stats->dc_calls[entry] ++;
+	stats->dc_pixels[entry] += pixels;
+}
+
+/* an empty or inverted rect, which the engines ignore, has no pixel */
+rt_inline rt_uint32_t _stats_rect_area(rtgui_rect_t* rect)
+{
+	if (rect->x2 <= rect->x1 || rect->y2 <= rect->y1) return 0;
+
+	return (rt_uint32_t)(rtgui_rect_width(*rect) * rtgui_rect_height(*rect));
+}
+
+void rtgui_stats_dc_rect(int entry, rtgui_rect_t* rect)
+{
+	rtgui_stats_dc(entry, _stats_rect_area(rect));
+}
+
+void rtgui_stats_dc_spans(int entry, struct rtgui_span* spans, int count)
+{
+	rt_uint32_t pixels = 0;
+
+	for (; count > 0; count --, spans ++)
+		pixels += spans->x2 > spans->x1? spans->x2 - spans->x1 : spans->x1 - spans->x2;
+
+	rtgui_stats_dc(entry, pixels);
+}
+
+void rtgui_stats_update(rtgui_rect_t* rect)
+{
+	rtgui_stats.update_rects ++;
+	rtgui_stats.update_area += _stats_rect_area(rect);
+}
+
+void rtgui_stats_flush(rt_uint32_t bytes)
+{
+	rtgui_stats.flush_frames ++;
+	rtgui_stats.flush_bytes += bytes;
+	if (bytes > rtgui_stats.flush_max_bytes) rtgui_stats.flush_max_bytes = bytes;
+}
+
+/* rt_kprintf has no long long format */
+static const char* _stats_ull(char* buffer, rt_size_t size, unsigned long long value)
+{
+	char* ptr;
+
+	ptr = buffer + size - 1;
+	*ptr = '\0';
+	do
+	{
+		*--ptr = '0' + (char)(value % 10);
+		value /= 10;
+	} while (value != 0 && ptr > buffer);
+
+	return ptr;
+}
+
+static void _stats_thread_dump(struct rtgui_stats_thread* stats)
+{
+	char buffer[24];
+	int entry;
+
+	for (entry = 0; entry < RTGUI_STATS_DC_MAX; entry ++)
+	{
+		if (stats->dc_calls[entry] == 0) continue;
+
+		rt_kprintf("%-12.12s %-16s %10u %16s\n", stats->name, _stats_dc_name[entry],
+			stats->dc_calls[entry],
+			_stats_ull(buffer, sizeof(buffer), stats->dc_pixels[entry]));
+	}
+}
+
+void rtgui_stats_dump(void)
+{
+	struct rtgui_list_node* node;
+	struct rtgui_stats_thread* stats;
+	char buffer[24];
+	int op;
+
+	rt_kprintf("%-12s %-16s %10s %16s\n", "thread", "dc entry", "calls", "pixels");
+	rtgui_enter_critical();
+	rtgui_list_foreach(node, &_stats_list)
+	{
+		stats = rtgui_list_entry(node, struct rtgui_stats_thread, list);
+		_stats_thread_dump(stats);
+	}
+	_stats_thread_dump(&(rtgui_stats.others));
+
+	rt_kprintf("%-12s %10s %10s %10s\n", "thread", "sent", "received", "dropped");
+	rtgui_list_foreach(node, &_stats_list)
+	{
+		stats = rtgui_list_entry(node, struct rtgui_stats_thread, list);
+		rt_kprintf("%-12.12s %10u %10u %10u\n", stats->name,
+			stats->event_sent, stats->event_received, stats->event_dropped);
+	}
+	rtgui_exit_critical();
+
+	rt_kprintf("%-16s %10s %16s\n", "region op", "calls", "rects");
+	for (op = 0; op < RTGUI_STATS_REGION_MAX; op ++)
+	{
+		rt_kprintf("%-16s %10u %16s\n", _stats_region_name[op], rtgui_stats.region_calls[op],
+			_stats_ull(buffer, sizeof(buffer), rtgui_stats.region_rects[op]));
+	}
+
+	rt_kprintf("memory: malloc %u, realloc %u, free %u, bytes %s\n",
+		rtgui_stats.malloc_calls, rtgui_stats.realloc_calls, rtgui_stats.free_calls,
+		_stats_ull(buffer, sizeof(buffer), rtgui_stats.malloc_bytes));
+	rt_kprintf("screen update: %u rects, area %s\n", rtgui_stats.update_rects,
+		_stats_ull(buffer, sizeof(buffer), rtgui_stats.update_area));
+	if (rtgui_stats.flush_frames != 0)
+	{
+		rt_kprintf("shadow flush: %u frames, bytes %s, %u per frame, max %u\n", rtgui_stats.flush_frames,
+			_stats_ull(buffer, sizeof(buffer), rtgui_stats.flush_bytes),
+			(rt_uint32_t)(rtgui_stats.flush_bytes / rtgui_stats.flush_frames), rtgui_stats.flush_max_bytes);
+	}
+}
+
+static void _stats_thread_reset(struct rtgui_stats_thread* stats)
+{
+	rt_memset(stats->dc_calls, 0, sizeof(stats->dc_calls));
+	rt_memset(stats->dc_pixels, 0, sizeof(stats->dc_pixels));
+	stats->event_sent = 0;
+	stats->event_received = 0;
+	stats->event_dropped = 0;
+}
+
+void rtgui_stats_reset(void)
+{
+	struct rtgui_list_node* node;
+
+	rtgui_enter_critical();
+	rtgui_list_foreach(node, &_stats_list)
+	{
+		_stats_thread_reset(rtgui_list_entry(node, struct rtgui_stats_thread, list));
+	}
+	rtgui_exit_critical();
+	_stats_thread_reset(&(rtgui_stats.others));
+
+	rt_memset(rtgui_stats.region_calls, 0, sizeof(rtgui_stats.region_calls));
+	rt_memset(rtgui_stats.region_rects, 0, sizeof(rtgui_stats.region_rects));
+	rtgui_stats.malloc_calls = 0;
+	rtgui_stats.realloc_calls = 0;
+	rtgui_stats.free_calls = 0;
+	rtgui_stats.malloc_bytes = 0;
+	rtgui_stats.update_rects = 0;
+	rtgui_stats.update_area = 0;
+	rtgui_stats.flush_frames = 0;
+	rtgui_stats.flush_max_bytes = 0;
+	rtgui_stats.flush_bytes = 0;
+}
+
+#ifdef RT_USING_FINSH
+#include <finsh.h>
+FINSH_FUNCTION_EXPORT(rtgui_stats_dump, dump the statistics of rtgui);
+FINSH_FUNCTION_EXPORT(rtgui_stats_reset, reset the statistics of rtgui);
+#endif
+#endif
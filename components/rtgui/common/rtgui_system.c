@@ -21,6 +21,7 @@
 #include <rtgui/rtgui_system.h>
 #include <rtgui/widgets/window.h>
 #include <rtgui/rtgui_theme.h>
+#include <rtgui/rtgui_stats.h>
 
 #ifdef _WIN32
 #define RTGUI_MEM_TRACE
@@ -62,7 +63,7 @@ static void rtgui_time_out(void* parameter)
 	rtgui_application_send(timer->tid, &(event.parent), sizeof(rtgui_event_timer_t));
 }
 
-rtgui_timer_t* rtgui_timer_create(rt_int32_t time, rt_int32_t flag, rtgui_timeout_func timeout, void* parameter)
+rtgui_timer_t* rtgui_timer_create(rt_int32_t time, rt_base_t flag, rtgui_timeout_func timeout, void* parameter)
 {
 	rtgui_timer_t* timer;
 
@@ -172,7 +173,7 @@ void rti_malloc_hook(void* ptr, rt_uint32_t len)
 	item->next   = RT_NULL;
 
 	/* get hash item index */
-	index = ((rt_uint32_t)ptr) % MEMTRACE_HASH_SIZE;
+	index = ((rt_ubase_t)ptr) % MEMTRACE_HASH_SIZE;
 	if (item_hash[index] != RT_NULL)
 	{
 		/* add to list */
@@ -193,7 +194,7 @@ void rti_free_hook(void* ptr)
 	struct rti_memtrace_item *item;
 
 	/* get hash item index */
-	index = ((rt_uint32_t)ptr) % MEMTRACE_HASH_SIZE;
+	index = ((rt_ubase_t)ptr) % MEMTRACE_HASH_SIZE;
 	if (item_hash[index] != RT_NULL)
 	{
 		item = item_hash[index];
@@ -238,11 +239,44 @@ void rti_free_hook(void* ptr)
 }
 #endif
 
+#ifdef RTGUI_USING_HOOK
+static void (*rtgui_malloc_hook)(void* ptr, rt_size_t size);
+static void (*rtgui_free_hook)(void* ptr);
+
+/**
+ * This function will set a hook function, which will be invoked when a memory
+ * block is allocated (or re-allocated) by RTGUI.
+ *
+ * @param hook the hook function
+ */
+void rtgui_malloc_sethook(void (*hook)(void* ptr, rt_size_t size))
+{
+	rtgui_malloc_hook = hook;
+}
+
+/**
+ * This function will set a hook function, which will be invoked when a memory
+ * block is released by RTGUI.
+ *
+ * @param hook the hook function
+ */
+void rtgui_free_sethook(void (*hook)(void* ptr))
+{
+	rtgui_free_hook = hook;
+}
+#endif
+
 void* rtgui_malloc(rt_size_t size)
 {
 	void* ptr;
 
 	ptr = rt_malloc(size);
+	RTGUI_STATS_INC(malloc_calls);
+	RTGUI_STATS_ADD(malloc_bytes, size);
+#ifdef RTGUI_USING_HOOK
+	if (ptr != RT_NULL && rtgui_malloc_hook != RT_NULL)
+		rtgui_malloc_hook(ptr, size);
+#endif
 #ifdef RTGUI_MEM_TRACE
 	if (rti_memtrace_inited == 0)
 	{
@@ -270,6 +304,12 @@ void* rtgui_realloc(void* ptr, rt_size_t size)
 	}
 #else
 	new_ptr = rt_realloc(ptr, size);
+	RTGUI_STATS_INC(realloc_calls);
+	RTGUI_STATS_ADD(malloc_bytes, size);
+#ifdef RTGUI_USING_HOOK
+	if (new_ptr != RT_NULL && rtgui_malloc_hook != RT_NULL)
+		rtgui_malloc_hook(new_ptr, size);
+#endif
 #endif
 
 	return new_ptr;
@@ -277,6 +317,11 @@ void* rtgui_realloc(void* ptr, rt_size_t size)
 
 void rtgui_free(void* ptr)
 {
+	RTGUI_STATS_INC(free_calls);
+#ifdef RTGUI_USING_HOOK
+	if (ptr != RT_NULL && rtgui_free_hook != RT_NULL)
+		rtgui_free_hook(ptr);
+#endif
 #ifdef RTGUI_MEM_TRACE
 	if (ptr != RT_NULL)
 		rti_free_hook(ptr);
@@ -4,6 +4,35 @@
 #include <rtgui/rtgui.h>
 
 typedef void (*rtgui_blit_line_func)(rt_uint8_t* dst, rt_uint8_t* src, int line);
+/* the converter in byte per pixel, the line is the bytes of source */
 rtgui_blit_line_func rtgui_blit_line_get(int dst_bpp, int src_bpp);
 
+/*
+ * the converter between RTGRAPHIC_PIXEL_FORMAT_xxx in the layout of raw line
+ * of framebuffer, the line is the count of pixels. RT_NULL if the format is
+ * not supported.
+ */
+rtgui_blit_line_func rtgui_blit_line_get_format(int dst_format, int src_format);
+/* the same but the transparent pixels of ARGB888 source (alpha 255) are skipped */
+rtgui_blit_line_func rtgui_blit_line_get_format_key(int dst_format, int src_format);
+
+/*
+ * The blend modes of ARGB888 source, whose alpha byte is the opacity (255 is
+ * opaque):
+ *  NONE:  dst = src
+ *  BLEND: dst = src * alpha + dst * (1 - alpha), dstA = alpha + dstA * (1 - alpha)
+ *  ADD:   dst = dst + src * alpha, dstA = dstA
+ *  MOD:   dst = src * dst, dstA = dstA
+ */
+#define RTGUI_BLENDMODE_NONE	0x00
+#define RTGUI_BLENDMODE_BLEND	0x01
+#define RTGUI_BLENDMODE_ADD		0x02
+#define RTGUI_BLENDMODE_MOD		0x03
+
+/*
+ * blend a line of ARGB888 source on the raw line of dst_format in place, the
+ * line is the count of pixels. RT_NULL if the format is not supported.
+ */
+rtgui_blit_line_func rtgui_blend_line_get(int dst_format, int mode);
+
 #endif
@@ -110,5 +110,17 @@ rt_inline rtgui_color_t rtgui_color_from_888(rt_uint32_t pixel)
 	return color;
 }
 
+/* convert rtgui color to a gray level of 8 bits, 0 is black */
+rt_inline rt_uint8_t rtgui_color_to_gray(rtgui_color_t c)
+{
+	/* ITU-R BT.601 luma */
+	return (rt_uint8_t)((RTGUI_RGB_R(c) * 77 + RTGUI_RGB_G(c) * 150 + RTGUI_RGB_B(c) * 29) >> 8);
+}
+
+rt_inline rtgui_color_t rtgui_color_from_gray(rt_uint8_t level)
+{
+	return RTGUI_RGB(level, level, level);
+}
+
 #endif
 
@@ -17,6 +17,8 @@
 #include <rtgui/rtgui.h>
 #include <rtgui/font.h>
 #include <rtgui/driver.h>
+#include <rtgui/blit.h>
+#include <rtgui/rtgui_stats.h>
 #include <rtgui/widgets/widget.h>
 
 enum rtgui_dc_type
@@ -37,6 +39,11 @@ struct rtgui_dc_engine
 	void (*blit_line) (struct rtgui_dc* dc, int x1, int x2, int y, rt_uint8_t* line_data);
 	void (*blit		 )(struct rtgui_dc* dc, struct rtgui_point* dc_point, struct rtgui_dc* dest, rtgui_rect_t* rect);
 
+	/* batch interface, the points and spans are clipped and drawn at once */
+	void (*draw_points)(struct rtgui_dc* dc, struct rtgui_point* points, int count);
+	void (*draw_color_points)(struct rtgui_dc* dc, struct rtgui_point* points, rtgui_color_t* colors, int count);
+	void (*draw_spans)(struct rtgui_dc* dc, struct rtgui_span* spans, int count);
+
 	/* set and get graphic context */
 	void (*set_gc)(struct rtgui_dc* dc, struct rtgui_gc *gc);
 	struct rtgui_gc* (*get_gc)(struct rtgui_dc* dc);
@@ -65,9 +72,29 @@ struct rtgui_dc
 #define RTGUI_DC_FONT(dc)		(rtgui_dc_get_gc(dc)->font)
 #define RTGUI_DC_TEXTALIGN(dc)	(rtgui_dc_get_gc(dc)->textalign)
 
-/* create a buffer dc */
+/* create a buffer dc in the pixel format of driver */
 struct rtgui_dc* rtgui_dc_buffer_create(int width, int height);
+/*
+ * create a buffer dc in a RTGRAPHIC_PIXEL_FORMAT_xxx, whose pixels are in the
+ * raw line of blit.h. RT_NULL if the format is not supported.
+ */
+struct rtgui_dc* rtgui_dc_buffer_create_pixformat(rt_uint8_t pixel_format, int width, int height);
 rt_uint8_t* rtgui_dc_buffer_get_pixel(struct rtgui_dc* dc);
+rt_uint8_t rtgui_dc_buffer_get_pixel_format(struct rtgui_dc* dc);
+/*
+ * set the RTGUI_BLENDMODE_xxx of blit.h used when the buffer dc is blitted,
+ * the alpha byte of its pixels is the opacity then, so the buffer must be in
+ * ARGB888. It's NONE by default.
+ */
+void rtgui_dc_buffer_set_blend_mode(struct rtgui_dc* dc, rt_uint8_t mode);
+/*
+ * set the color key of buffer dc, its pixels of the key color keep the
+ * destination when it's blitted without blend mode. The alpha isn't compared.
+ */
+void rtgui_dc_buffer_set_color_key(struct rtgui_dc* dc, rt_bool_t enable, rtgui_color_t key);
+/* blend the ARGB888 pixels of a rect on dc, the lines of pixels are pitch bytes apart */
+void rtgui_dc_blend_pixels(struct rtgui_dc* dc, rt_uint8_t* pixels, int pitch,
+	rtgui_rect_t* rect, rt_uint8_t mode);
 
 /* begin and end a drawing */
 struct rtgui_dc* rtgui_dc_begin_drawing(rtgui_widget_t* owner);
@@ -88,6 +115,15 @@ void rtgui_dc_fill_sector(struct rtgui_dc *dc, rt_int16_t x, rt_int16_t y, rt_in
 void rtgui_dc_draw_text (struct rtgui_dc* dc, const char* text, struct rtgui_rect* rect);
 
 void rtgui_dc_draw_mono_bmp(struct rtgui_dc* dc, int x, int y, int w, int h, const rt_uint8_t* data);
+/*
+ * draw w pixels of each line of a monochrome bitmap, the lines are pitch bytes
+ * apart and the left pixel is in the most significant bit. The set bits are
+ * drawn in foreground, and the cleared ones in background if it's drawn.
+ */
+void rtgui_dc_draw_mono_bits(struct rtgui_dc* dc, int x, int y, int w, int h, int pitch,
+	const rt_uint8_t* data, rt_bool_t background);
+/* draw a line of colors from (x, y), the transparent ones (alpha 255) are skipped */
+void rtgui_dc_draw_color_line(struct rtgui_dc* dc, int x, int y, const rtgui_color_t* colors, int count);
 void rtgui_dc_draw_byte(struct rtgui_dc*dc, int x, int y, int h, const rt_uint8_t* data);
 void rtgui_dc_draw_word(struct rtgui_dc*dc, int x, int y, int h, const rt_uint8_t* data);
 
@@ -118,6 +154,7 @@ void rtgui_dc_fill_ellipse(struct rtgui_dc *dc, rt_int16_t x, rt_int16_t y, rt_i
  */
 rt_inline void rtgui_dc_draw_point(struct rtgui_dc* dc, int x, int y)
 {
+	RTGUI_STATS_DC(RTGUI_STATS_DC_DRAW_POINT, 1);
 	dc->engine->draw_point(dc, x, y);
 }
 
@@ -126,6 +163,7 @@ rt_inline void rtgui_dc_draw_point(struct rtgui_dc* dc, int x, int y)
  */
 rt_inline void rtgui_dc_draw_color_point(struct rtgui_dc* dc, int x, int y, rtgui_color_t color)
 {
+	RTGUI_STATS_DC(RTGUI_STATS_DC_DRAW_COLOR_POINT, 1);
 	dc->engine->draw_color_point(dc, x, y, color);
 }
 
@@ -134,6 +172,7 @@ rt_inline void rtgui_dc_draw_color_point(struct rtgui_dc* dc, int x, int y, rtgu
  */
 rt_inline void rtgui_dc_draw_vline(struct rtgui_dc* dc, int x, int y1, int y2)
 {
+	RTGUI_STATS_DC(RTGUI_STATS_DC_DRAW_VLINE, y2 > y1? y2 - y1 : y1 - y2);
 	dc->engine->draw_vline(dc, x, y1, y2);
 }
 
@@ -142,14 +181,54 @@ rt_inline void rtgui_dc_draw_vline(struct rtgui_dc* dc, int x, int y1, int y2)
  */
 rt_inline void rtgui_dc_draw_hline(struct rtgui_dc* dc, int x1, int x2, int y)
 {
+	RTGUI_STATS_DC(RTGUI_STATS_DC_DRAW_HLINE, x2 > x1? x2 - x1 : x1 - x2);
 	dc->engine->draw_hline(dc, x1, x2, y);
 }
 
+/*
+ * draw a line of raw pixels, which are in the pixel format of dc
+ */
+rt_inline void rtgui_dc_blit_line(struct rtgui_dc* dc, int x1, int x2, int y, rt_uint8_t* line_data)
+{
+	RTGUI_STATS_DC(RTGUI_STATS_DC_BLIT_LINE, x2 > x1? x2 - x1 : x1 - x2);
+	dc->engine->blit_line(dc, x1, x2, y, line_data);
+}
+
+/*
+ * draw the points on dc in foreground color
+ */
+rt_inline void rtgui_dc_draw_points(struct rtgui_dc* dc, struct rtgui_point* points, int count)
+{
+	RTGUI_STATS_DC(RTGUI_STATS_DC_DRAW_POINTS, count);
+	dc->engine->draw_points(dc, points, count);
+}
+
+/*
+ * draw the points on dc in the color of each one
+ */
+rt_inline void rtgui_dc_draw_color_points(struct rtgui_dc* dc, struct rtgui_point* points,
+	rtgui_color_t* colors, int count)
+{
+	RTGUI_STATS_DC(RTGUI_STATS_DC_DRAW_COLOR_POINTS, count);
+	dc->engine->draw_color_points(dc, points, colors, count);
+}
+
+/*
+ * draw the horizontal spans on dc in foreground color, x2 of span is excluded
+ * and a span with x1 > x2 is drawn as [x2, x1)
+ */
+rt_inline void rtgui_dc_draw_spans(struct rtgui_dc* dc, struct rtgui_span* spans, int count)
+{
+	RTGUI_STATS_DC_SPANS(RTGUI_STATS_DC_DRAW_SPANS, spans, count);
+	dc->engine->draw_spans(dc, spans, count);
+}
+
 /*
  * fill a rect with background color 
  */
 rt_inline void rtgui_dc_fill_rect (struct rtgui_dc* dc, struct rtgui_rect* rect)
 {
+	RTGUI_STATS_DC_RECT(RTGUI_STATS_DC_FILL_RECT, rect);
 	dc->engine->fill_rect(dc, rect);
 }
 
@@ -158,6 +237,7 @@ rt_inline void rtgui_dc_fill_rect (struct rtgui_dc* dc, struct rtgui_rect* rect)
  */
 rt_inline void rtgui_dc_blit(struct rtgui_dc* dc, struct rtgui_point* dc_point, struct rtgui_dc* dest, rtgui_rect_t* rect)
 {
+	RTGUI_STATS_DC_RECT(RTGUI_STATS_DC_BLIT, rect);
 	dc->engine->blit(dc, dc_point, dest, rect);
 }
 
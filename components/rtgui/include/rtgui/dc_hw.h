@@ -16,8 +16,12 @@
 #define __RTGUI_DC_HW_H__
 
 #include <rtgui/dc.h>
+#include <rtgui/driver.h>
 
-/* create a hardware dc */
+/*
+ * create a hardware dc, which is the dc embedded in owner. The owner of a dc
+ * is got by RTGUI_CONTAINER_OF(dc, struct rtgui_widget, dc_type).
+ */
 struct rtgui_dc* rtgui_dc_hw_create(rtgui_widget_t* owner);
 
 #endif
@@ -10,6 +10,8 @@
  * Change Logs:
  * Date           Author       Notes
  * 2009-10-04     Bernard      first version
+ * 2026-10-17     agent        the mono framebuffer is in continuous pages, it
+ *                             was a table of page pointers
  */
 #ifndef __RTGUI_DRIVER_H__
 #define __RTGUI_DRIVER_H__
@@ -28,6 +30,73 @@ struct rtgui_graphic_driver_ops
 
 	/* draw raw hline */
 	void (*draw_raw_hline)(rt_uint8_t *pixels, int x1, int x2, int y);
+
+	/*
+	 * The optional 2D operations, RT_NULL if not supported. The rect is in
+	 * device coordinate and inside of screen. blit_rect draws the raw pixels
+	 * whose lines are pitch bytes apart, copy_area copies the rect to (x, y)
+	 * and the areas can overlap.
+	 */
+	void (*fill_rect)(rtgui_color_t *c, struct rtgui_rect *rect);
+	void (*blit_rect)(rt_uint8_t *pixels, int pitch, struct rtgui_rect *rect);
+	void (*copy_area)(struct rtgui_rect *rect, int x, int y);
+
+	/* write the buffered pixels to device, RT_NULL if nothing is buffered */
+	void (*flush)(void);
+
+	/*
+	 * The optional operations in device pixel, which is mapped from color by
+	 * map_color. They are RT_NULL if map_color is RT_NULL.
+	 */
+	rt_uint32_t (*map_color)(rtgui_color_t c);
+	void (*set_pixel_native)(rt_uint32_t pixel, int x, int y);
+	void (*draw_hline_native)(rt_uint32_t pixel, int x1, int x2, int y);
+	void (*draw_vline_native)(rt_uint32_t pixel, int x, int y1, int y2);
+
+	/*
+	 * blend a line of ARGB888 pixels on the device in place by the
+	 * RTGUI_BLENDMODE_xxx of blit.h, RT_NULL if it's not supported.
+	 */
+	void (*blend_hline)(rt_uint8_t *pixels, int mode, int x1, int x2, int y);
+};
+
+#ifdef RTGUI_USING_PIXEL_SPAN
+/*
+ * The adjacent pixels of set_pixel in a line are buffered in a span of each
+ * GUI thread, and written to pixel device by one blit_line.
+ */
+#ifndef RTGUI_PIXEL_SPAN_SIZE
+#ifdef RTGUI_USING_SMALL_SIZE
+#define RTGUI_PIXEL_SPAN_SIZE		64
+#else
+#define RTGUI_PIXEL_SPAN_SIZE		256
+#endif
+#endif
+
+struct rtgui_pixel_span
+{
+	rt_uint16_t x, y;
+	rt_uint16_t count;
+
+	/* in device format, 4 bytes at most */
+	rt_uint8_t pixels[RTGUI_PIXEL_SPAN_SIZE * 4];
+};
+#endif
+
+/*
+ * The 2D accelerator of device (DMA or 2D engine), which is got by the
+ * RTGRAPHIC_CTRL_GET_EXT control command. The pixels are in device format,
+ * any entry can be RT_NULL.
+ */
+#ifndef RTGRAPHIC_CTRL_GET_EXT
+#define RTGRAPHIC_CTRL_GET_EXT		5
+#endif
+
+struct rtgui_graphic_ext_ops
+{
+	void (*fill_rect)(const char *pixel, struct rt_device_rect_info *rect);
+	void (*blit_rect)(const char *pixels, int pitch, struct rt_device_rect_info *rect);
+	void (*copy_area)(struct rt_device_rect_info *rect, int x, int y);
 };
 
 struct rtgui_graphic_driver
@@ -37,7 +106,7 @@ struct rtgui_graphic_driver
 	rt_uint8_t bits_per_pixel;
 	rt_uint16_t pitch;
 
-	/* screen width and height */
+	/* screen width and height, which are swapped by the rotation of 90 and 270 */
 	rt_uint16_t width;
 	rt_uint16_t height;
 
@@ -45,8 +114,55 @@ struct rtgui_graphic_driver
 	volatile rt_uint8_t *framebuffer;
 	rt_device_t device;
 	const struct rtgui_graphic_driver_ops *ops;
+	/* RT_NULL if the device has no 2D accelerator */
+	const struct rtgui_graphic_ext_ops *ext_ops;
+
+	/*
+	 * The clockwise rotation of screen on device: 0, 90, 180 or 270. The
+	 * ops draw the rotated screen by the device_ops, and the pitch and
+	 * framebuffer are of device in its native orientation.
+	 */
+	rt_uint16_t rotation;
+	rt_uint16_t device_width;
+	rt_uint16_t device_height;
+	const struct rtgui_graphic_driver_ops *device_ops;
+
+	/*
+	 * The framebuffer of device, the framebuffer is a shadow of it in RAM
+	 * when they are not the same, and the updated rect is written to device.
+	 */
+	volatile rt_uint8_t *device_framebuffer;
 };
 
+/* get the device pixel of foreground or background of gc, ops->map_color must not be RT_NULL */
+rt_inline void _rtgui_gc_check_map(rtgui_gc_t *gc, const struct rtgui_graphic_driver_ops *ops)
+{
+	if (gc->map_color != ops->map_color)
+	{
+		gc->map_color = ops->map_color;
+		gc->fc_pixel = ops->map_color(gc->fc_mapped = gc->foreground);
+		gc->bc_pixel = ops->map_color(gc->bc_mapped = gc->background);
+	}
+}
+
+rt_inline rt_uint32_t rtgui_gc_fc_pixel(rtgui_gc_t *gc, const struct rtgui_graphic_driver_ops *ops)
+{
+	_rtgui_gc_check_map(gc, ops);
+	if (gc->fc_mapped != gc->foreground)
+		gc->fc_pixel = ops->map_color(gc->fc_mapped = gc->foreground);
+
+	return gc->fc_pixel;
+}
+
+rt_inline rt_uint32_t rtgui_gc_bc_pixel(rtgui_gc_t *gc, const struct rtgui_graphic_driver_ops *ops)
+{
+	_rtgui_gc_check_map(gc, ops);
+	if (gc->bc_mapped != gc->background)
+		gc->bc_pixel = ops->map_color(gc->bc_mapped = gc->background);
+
+	return gc->bc_pixel;
+}
+
 void rtgui_graphic_driver_add(const struct rtgui_graphic_driver* driver);
 
 struct rtgui_graphic_driver* rtgui_graphic_driver_get_default(void);
@@ -54,8 +170,53 @@ struct rtgui_graphic_driver* rtgui_graphic_driver_get_default(void);
 void rtgui_graphic_driver_get_rect(const struct rtgui_graphic_driver *driver, rtgui_rect_t *rect);
 void rtgui_graphic_driver_screen_update(const struct rtgui_graphic_driver* driver, rtgui_rect_t *rect);
 rt_uint8_t* rtgui_graphic_driver_get_framebuffer(const struct rtgui_graphic_driver* driver);
+void rtgui_graphic_driver_copy_area(const struct rtgui_graphic_driver* driver, rtgui_rect_t *rect, int x, int y);
 
+/*
+ * set the graphic device of screen, whose rt_device_graphic_info of
+ * RTGRAPHIC_CTRL_GET_INFO gives the framebuffer, or RT_NULL if the device
+ * is drawn by set_pixel and blit_line. The framebuffer has the lines from top
+ * to bottom, each of them has the pixels from left to right:
+ *
+ * - RGB565, RGB565P, RGB888 and ARGB888 are (width * bits_per_pixel / 8)
+ *   bytes per line.
+ * - GRAY4 and GRAY16 are packed in (width * bits_per_pixel + 7) / 8 bytes
+ *   per line, the left pixel is in the most significant bits.
+ * - MONO is in pages of 8 lines, and the pages are continuous, width bytes
+ *   apart. The byte x of page (y / 8) is the column x of the 8 lines and
+ *   the line (y % 8) is the bit (1 << (y % 8)). A set bit is black.
+ *
+ * The mono framebuffer was a table of page pointers, which was indexed as
+ * ((rt_uint8_t**)framebuffer)[y / 8][x]. A mono driver giving such a table
+ * must give its continuous pages now, or no framebuffer.
+ *
+ * The raw line of draw_raw_hline and blit_line starts at x1. MONO has one bit
+ * per pixel and the pixel x1 is the least significant bit of the first byte.
+ */
 rt_err_t rtgui_graphic_set_device(rt_device_t device);
+/* set the clockwise rotation of screen: 0, 90, 180 or 270 */
+rt_err_t rtgui_graphic_set_rotation(int rotation);
+
+#ifdef RTGUI_USING_SHADOW_FRAMEBUFFER
+/* the bytes of a burst to device memory, which is power of 2 */
+#ifndef RTGUI_SHADOW_BURST
+#define RTGUI_SHADOW_BURST			32
+#endif
+/*
+ * draw in a shadow of the framebuffer in RAM, which is written to device on
+ * the screen update. It must be set before the server is initialized.
+ */
+rt_err_t rtgui_graphic_set_shadow(rt_bool_t enable);
+#endif
+
+#ifdef RTGUI_USING_ASYNC_FLUSH
+/*
+ * send the screen update to device in a flush thread, the caller of screen
+ * update doesn't wait for the device unless it overwrites the pixels being
+ * sent. It must be set before the server is initialized.
+ */
+rt_err_t rtgui_graphic_set_async_flush(rt_bool_t enable);
+#endif
 
 rt_inline struct rtgui_graphic_driver* rtgui_graphic_get_device()
 {
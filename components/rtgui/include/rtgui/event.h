@@ -82,6 +82,12 @@ struct rtgui_event
 
 	/* mailbox to acknowledge request */
 	rt_mailbox_t ack;
+
+#ifdef RTGUI_USING_EVENT_TRACE
+	/* the id and time of send, set by rtgui_application_send* */
+	rt_uint32_t trace_id;
+	rt_uint32_t trace_time;
+#endif
 };
 typedef struct rtgui_event rtgui_event_t;
 #define RTGUI_EVENT(e)	((struct rtgui_event*)(e))
@@ -71,6 +71,11 @@ rtgui_rect_t* rtgui_region_rects (rtgui_region_t *region);
 #define RTGUI_REGION_PART	2
 
 int rtgui_region_contains_point (rtgui_region_t *region, int x, int y, rtgui_rect_t *box);
+/*
+ * the first rect of the band which contains y or is below it, and the end of
+ * rects. The band goes on while the y1 of rect is the same.
+ */
+rtgui_rect_t *rtgui_region_find_band(rtgui_region_t *region, int y, rtgui_rect_t **end);
 int rtgui_region_contains_rectangle (rtgui_region_t *rtgui_region_t, rtgui_rect_t *prect);
 
 int rtgui_region_not_empty (rtgui_region_t *region);
@@ -48,7 +48,14 @@ typedef struct rtgui_rect rtgui_rect_t;
 #define rtgui_rect_width(r)		((r).x2 - (r).x1)
 #define rtgui_rect_height(r)	((r).y2 - (r).y1)
 
-typedef unsigned long rtgui_color_t;
+/* the horizontal run of pixels [x1, x2) in line y */
+struct rtgui_span
+{
+	rt_int16_t x1, x2, y;
+};
+typedef struct rtgui_span rtgui_span_t;
+
+typedef rt_uint32_t rtgui_color_t;
 
 struct rtgui_gc
 {
@@ -62,6 +69,15 @@ struct rtgui_gc
 
 	/* font */
 	struct rtgui_font* font;
+
+	/*
+	 * the device pixels of foreground and background, which are mapped by
+	 * map_color from fc_mapped and bc_mapped. They are mapped again when the
+	 * color or the map_color of driver is changed.
+	 */
+	rt_uint32_t (*map_color)(rtgui_color_t c);
+	rtgui_color_t fc_mapped, bc_mapped;
+	rt_uint32_t fc_pixel, bc_pixel;
 };
 typedef struct rtgui_gc rtgui_gc_t;
 
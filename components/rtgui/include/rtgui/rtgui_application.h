@@ -18,6 +18,9 @@
 #include <rtgui/rtgui.h>
 #include <rtgui/event.h>
 #include <rtgui/rtgui_system.h>
+#include <rtgui/rtgui_stats.h>
+#include <rtgui/rtgui_trace.h>
+#include <rtgui/driver.h>
 
 DECLARE_CLASS_TYPE(application);
 
@@ -63,6 +66,20 @@ struct rtgui_application
 
 	/* on idle event handler */
 	rtgui_idle_func on_idle;
+
+#ifdef RTGUI_USING_STATS
+	struct rtgui_stats_thread stats;
+#endif
+#ifdef RTGUI_USING_EVENT_TRACE
+	struct rtgui_trace_ring trace;
+#endif
+#ifdef RTGUI_USING_PIXEL_SPAN
+	struct rtgui_pixel_span span;
+#endif
+
+	/* the scratch line of drawing, it grows to the longest one */
+	rt_uint8_t *scratch;
+	rt_size_t scratch_size;
 };
 
 /**
@@ -82,6 +99,14 @@ void rtgui_application_set_onidle(rtgui_idle_func onidle);
 rtgui_idle_func rtgui_application_get_onidle(void);
 struct rtgui_application* rtgui_application_self(void);
 
+/*
+ * get a scratch line of size bytes, which is kept in the application of
+ * thread and reused by the next one. The thread without application gets a
+ * new line. Release it by rtgui_application_put_scratch.
+ */
+rt_uint8_t* rtgui_application_get_scratch(rt_size_t size);
+void rtgui_application_put_scratch(rt_uint8_t* scratch);
+
 rt_thread_t rtgui_application_get_server(void);
 
 void rtgui_application_set_root_object(struct rtgui_object* object);
@@ -64,6 +64,27 @@
 #define RTGUI_SVR_THREAD_STACK_SIZE		2048
 #endif
 
+/*
+ * RTGUI_SVR_FRAME_TICK is the ticks between the flushes of screen update, the
+ * update is flushed at once when it's not defined or 0.
+ */
+/* the rects of screen damage in a frame */
+#ifndef RTGUI_SVR_DAMAGE_MAX
+#define RTGUI_SVR_DAMAGE_MAX			8
+#endif
+/* the pixels of a transfer to panel, rects wasting less are merged */
+#ifndef RTGUI_SVR_DAMAGE_COST
+#define RTGUI_SVR_DAMAGE_COST			256
+#endif
+
+/* the thread sending the screen update to device, see RTGUI_USING_ASYNC_FLUSH */
+#define RTGUI_FLUSH_THREAD_PRIORITY		20
+#define RTGUI_FLUSH_THREAD_TIMESLICE	5
+#define RTGUI_FLUSH_THREAD_STACK_SIZE	1024
+#ifndef RTGUI_FLUSH_DAMAGE_MAX
+#define RTGUI_FLUSH_DAMAGE_MAX			RTGUI_SVR_DAMAGE_MAX
+#endif
+
 #define RTGUI_APP_THREAD_PRIORITY		25
 #define RTGUI_APP_THREAD_TIMESLICE		5
 #ifdef RTGUI_USING_SMALL_SIZE
@@ -76,6 +97,8 @@
 
 //#define RTGUI_USING_DESKTOP_WINDOW
 
-#define  RTGUI_EVENT_DEBUG
+/* dump each event to console, it serializes the GUI threads on console.
+ * Use RTGUI_USING_EVENT_TRACE to trace the events without perturbing them. */
+//#define RTGUI_EVENT_DEBUG
 
 #endif
@@ -0,0 +1,83 @@
+/*
+ * File      : rtgui_recorder.h
+ * This file is part of RTGUI in RT-Thread RTOS
+ * COPYRIGHT (C) 2006 - 2012, RT-Thread Development Team
+ *
+ * The license and distribution terms for this file may be
+ * found in the file LICENSE in this distribution or at
+ * http://www.rt-thread.org/license/LICENSE
+ */
+#ifndef __RTGUI_RECORDER_H__
+#define __RTGUI_RECORDER_H__
+
+#include <rtgui/rtgui.h>
+#include <rtgui/event.h>
+
+#ifdef RTGUI_USING_RECORDER
+/*
+ * The record file is a header followed by the records of input event, which
+ * are received by server in the order.
+ */
+#define RTGUI_RECORDER_MAGIC		0x52475452	/* "RTGR" */
+#define RTGUI_RECORDER_VERSION		1
+
+/*
+ * An injected event is counted when a screen update is made before the server
+ * takes the next injected event and in RTGUI_RECORDER_TIMEOUT.
+ */
+#ifndef RTGUI_RECORDER_TIMEOUT
+#define RTGUI_RECORDER_TIMEOUT		1000000		/* microsecond */
+#endif
+/* in max speed, the time to wait for an event which makes no screen update */
+#ifndef RTGUI_RECORDER_SETTLE
+#define RTGUI_RECORDER_SETTLE		20000		/* microsecond */
+#endif
+
+struct rtgui_recorder_header
+{
+	rt_uint32_t magic;
+	rt_uint32_t version;
+};
+
+struct rtgui_record
+{
+	rt_uint32_t timestamp;	/* microseconds since the recording started */
+	rt_uint16_t type;		/* RTGUI_EVENT_MOUSE_MOTION, RTGUI_EVENT_MOUSE_BUTTON or RTGUI_EVENT_KBD */
+	rt_uint16_t reserved;
+
+	/* x, y, button of mouse event or type, key, mod, unicode of keyboard event */
+	rt_uint16_t param[4];
+};
+
+/* the latency from the injection to the screen update, in microsecond */
+struct rtgui_replay_stat
+{
+	rt_uint32_t events;		/* injected events */
+	rt_uint32_t updated;	/* events followed by a screen update */
+
+	rt_uint32_t min, max;
+	rt_uint32_t p50, p90, p99;
+};
+
+/* set a microsecond clock, the default one is based on OS tick */
+void rtgui_recorder_set_clock(rt_uint32_t (*clock)(void));
+
+/* record the input events received by server to a file */
+rt_err_t rtgui_recorder_start(const char* filename);
+void rtgui_recorder_stop(void);
+
+/*
+ * re-inject the recorded events to server, it returns after all of the events
+ * are handled. In max speed, an event is injected once the previous one made a
+ * screen update or settled (the first one still waits for its recorded time),
+ * otherwise it's injected at recorded time.
+ */
+rt_err_t rtgui_recorder_replay(const char* filename, rt_bool_t max_speed,
+	struct rtgui_replay_stat* stat);
+
+/* invoked by server */
+void rtgui_recorder_input(struct rtgui_event* event);
+void rtgui_recorder_update(void);
+#endif
+
+#endif
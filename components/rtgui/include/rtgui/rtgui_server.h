@@ -80,5 +80,11 @@ void rtgui_server_init(void);
 void rtgui_server_post_event(struct rtgui_event* event, rt_size_t size);
 rt_err_t rtgui_server_post_event_sync(struct rtgui_event* event, rt_size_t size);
 
+/*
+ * set the ticks between the flushes of screen update, 0 flushes on every
+ * update. It must be set before the server is initialized.
+ */
+void rtgui_server_set_frame_tick(rt_int32_t tick);
+
 #endif
 
@@ -0,0 +1,129 @@
+/*
+ * File      : rtgui_stats.h
+ * This file is part of RTGUI in RT-Thread RTOS
+ * COPYRIGHT (C) 2006 - 2012, RT-Thread Development Team
+ *
+ * The license and distribution terms for this file may be
+ * found in the file LICENSE in this distribution or at
+ * http://www.rt-thread.org/license/LICENSE
+ */
+#ifndef __RTGUI_STATS_H__
+#define __RTGUI_STATS_H__
+
+#include <rtgui/rtgui.h>
+#include <rtgui/list.h>
+
+/*
+ * The statistics are simple counters without lock, they are cheap enough to
+ * be enabled in production. When RTGUI_USING_STATS is not defined, all of the
+ * RTGUI_STATS_* macros are empty.
+ */
+#ifdef RTGUI_USING_STATS
+/* the entries of dc engine */
+enum rtgui_stats_dc_entry
+{
+	RTGUI_STATS_DC_DRAW_POINT,
+	RTGUI_STATS_DC_DRAW_COLOR_POINT,
+	RTGUI_STATS_DC_DRAW_VLINE,
+	RTGUI_STATS_DC_DRAW_HLINE,
+	RTGUI_STATS_DC_FILL_RECT,
+	RTGUI_STATS_DC_BLIT_LINE,
+	RTGUI_STATS_DC_BLIT,
+	RTGUI_STATS_DC_DRAW_POINTS,
+	RTGUI_STATS_DC_DRAW_COLOR_POINTS,
+	RTGUI_STATS_DC_DRAW_SPANS,
+
+	RTGUI_STATS_DC_MAX
+};
+
+/* the region operations, a _rect operation is counted in its region one too */
+enum rtgui_stats_region_op
+{
+	RTGUI_STATS_REGION_UNION,
+	RTGUI_STATS_REGION_UNION_RECT,
+	RTGUI_STATS_REGION_SUBTRACT,
+	RTGUI_STATS_REGION_SUBTRACT_RECT,
+	RTGUI_STATS_REGION_INTERSECT,
+	RTGUI_STATS_REGION_INTERSECT_RECT,
+	RTGUI_STATS_REGION_INVERSE,
+	RTGUI_STATS_REGION_TRANSLATE,
+	RTGUI_STATS_REGION_CONTAINS_POINT,
+
+	RTGUI_STATS_REGION_MAX
+};
+
+/* the statistics of a GUI thread, which is embedded in rtgui_application */
+struct rtgui_stats_thread
+{
+	rtgui_list_t list;
+	const char* name;
+
+	/* calls and pixels (before clipping) of each dc engine entry */
+	rt_uint32_t dc_calls[RTGUI_STATS_DC_MAX];
+	unsigned long long dc_pixels[RTGUI_STATS_DC_MAX];
+
+	/* events on the message queue of thread */
+	rt_uint32_t event_sent;
+	rt_uint32_t event_received;
+	rt_uint32_t event_dropped;
+};
+
+struct rtgui_stats
+{
+	/* calls and rects of the operands of each region operation */
+	rt_uint32_t region_calls[RTGUI_STATS_REGION_MAX];
+	unsigned long long region_rects[RTGUI_STATS_REGION_MAX];
+
+	/* rtgui_malloc, rtgui_realloc and rtgui_free */
+	rt_uint32_t malloc_calls;
+	rt_uint32_t realloc_calls;
+	rt_uint32_t free_calls;
+	unsigned long long malloc_bytes;
+
+	/* rect updates of screen */
+	rt_uint32_t update_rects;
+	unsigned long long update_area;
+
+	/* the bytes written from shadow framebuffer, a frame is a screen update */
+	rt_uint32_t flush_frames;
+	rt_uint32_t flush_max_bytes;
+	unsigned long long flush_bytes;
+
+	/* the drawing in the threads without rtgui_application */
+	struct rtgui_stats_thread others;
+};
+extern struct rtgui_stats rtgui_stats;
+
+void rtgui_stats_thread_init(struct rtgui_stats_thread* stats, const char* name);
+void rtgui_stats_thread_detach(struct rtgui_stats_thread* stats);
+
+void rtgui_stats_dc(int entry, rt_uint32_t pixels);
+void rtgui_stats_dc_rect(int entry, rtgui_rect_t* rect);
+void rtgui_stats_dc_spans(int entry, struct rtgui_span* spans, int count);
+void rtgui_stats_update(rtgui_rect_t* rect);
+void rtgui_stats_flush(rt_uint32_t bytes);
+
+/* dump the statistics to console, or clear them */
+void rtgui_stats_dump(void);
+void rtgui_stats_reset(void);
+
+#define RTGUI_STATS_DC(entry, pixels)		rtgui_stats_dc(entry, pixels)
+#define RTGUI_STATS_DC_RECT(entry, rect)	rtgui_stats_dc_rect(entry, rect)
+#define RTGUI_STATS_DC_SPANS(entry, spans, count)	rtgui_stats_dc_spans(entry, spans, count)
+#define RTGUI_STATS_REGION(op, rects)		do { rtgui_stats.region_calls[op] ++; rtgui_stats.region_rects[op] += (rects); } while (0)
+#define RTGUI_STATS_INC(counter)			(rtgui_stats.counter ++)
+#define RTGUI_STATS_ADD(counter, value)		(rtgui_stats.counter += (value))
+#define RTGUI_STATS_UPDATE(rect)			rtgui_stats_update(rect)
+#define RTGUI_STATS_FLUSH(bytes)			rtgui_stats_flush(bytes)
+#else
+#define RTGUI_STATS_DC(entry, pixels)
+#define RTGUI_STATS_DC_RECT(entry, rect)
+#define RTGUI_STATS_DC_SPANS(entry, spans, count)
+#define RTGUI_STATS_REGION(op, rects)
+#define RTGUI_STATS_INC(counter)
+#define RTGUI_STATS_ADD(counter, value)
+#define RTGUI_STATS_UPDATE(rect)
+#define RTGUI_STATS_FLUSH(bytes)
+#endif
+
+#endif
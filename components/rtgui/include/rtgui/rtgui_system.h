@@ -50,6 +50,11 @@ void* rtgui_malloc(rt_size_t size);
 void rtgui_free(void* ptr);
 void* rtgui_realloc(void* ptr, rt_size_t size);
 
+#ifdef RTGUI_USING_HOOK
+void rtgui_malloc_sethook(void (*hook)(void* ptr, rt_size_t size));
+void rtgui_free_sethook(void (*hook)(void* ptr));
+#endif
+
 #define rtgui_enter_critical	rt_enter_critical
 #define rtgui_exit_critical		rt_exit_critical
 
@@ -0,0 +1,100 @@
+/*
+ * File      : rtgui_trace.h
+ * This file is part of RTGUI in RT-Thread RTOS
+ * COPYRIGHT (C) 2006 - 2012, RT-Thread Development Team
+ *
+ * The license and distribution terms for this file may be
+ * found in the file LICENSE in this distribution or at
+ * http://www.rt-thread.org/license/LICENSE
+ */
+#ifndef __RTGUI_TRACE_H__
+#define __RTGUI_TRACE_H__
+
+#include <rtgui/rtgui.h>
+#include <rtgui/list.h>
+
+#ifdef RTGUI_USING_EVENT_TRACE
+/*
+ * Each GUI thread writes the trace records of the events it sends and handles
+ * to its own ring, so there is no lock on the record path. The threads without
+ * rtgui_application (input drivers, timer) share one ring in critical section.
+ * The oldest records are overwritten when a ring is full.
+ */
+#ifndef RTGUI_TRACE_RING_SIZE
+#ifdef RTGUI_USING_SMALL_SIZE
+#define RTGUI_TRACE_RING_SIZE		256
+#else
+#define RTGUI_TRACE_RING_SIZE		1024
+#endif
+#endif
+
+/* the kind of a trace record */
+enum rtgui_trace_kind
+{
+	RTGUI_TRACE_SEND,			/* rtgui_application_send */
+	RTGUI_TRACE_SEND_URGENT,	/* rtgui_application_send_urgent */
+	RTGUI_TRACE_SEND_SYNC,		/* rtgui_application_send_sync, the duration includes the ack */
+	RTGUI_TRACE_HANDLE,			/* event handler of application */
+};
+
+/* the record is dropped when the message queue of receiver is full */
+#define RTGUI_TRACE_FLAG_DROPPED	0x01
+
+struct rtgui_trace_record
+{
+	rt_uint32_t timestamp;		/* the start of send or handler, in microsecond */
+	rt_uint32_t duration;		/* in microsecond */
+	rt_uint32_t queued;			/* the timestamp of send for a handler record */
+	rt_uint32_t id;				/* the id of send, which links the handler record */
+
+	rt_thread_t sender;
+	rt_thread_t receiver;
+	struct rtgui_win* wid;		/* RT_NULL if the event has no window */
+
+	rt_uint16_t type;			/* event type */
+	rt_uint8_t  kind;
+	rt_uint8_t  flag;
+};
+
+/* the trace ring of a GUI thread, which is embedded in rtgui_application */
+struct rtgui_trace_ring
+{
+	rtgui_list_t list;
+	const char* name;
+	rt_thread_t tid;
+
+	/* the id of send is made of the index of ring and the count of sends */
+	rt_uint32_t index;
+	rt_uint32_t sent;
+	/* the count of records written, only updated by the owner thread */
+	volatile rt_uint32_t head;
+	struct rtgui_trace_record* records;
+};
+
+/* set a microsecond clock, the default one is based on OS tick */
+void rtgui_trace_set_clock(rt_uint32_t (*clock)(void));
+
+void rtgui_trace_thread_init(struct rtgui_trace_ring* ring, const char* name, rt_thread_t tid);
+void rtgui_trace_thread_detach(struct rtgui_trace_ring* ring);
+
+/* clear the rings and start to trace, or stop it */
+void rtgui_trace_start(void);
+void rtgui_trace_stop(void);
+
+/*
+ * write the records in the rings to a file in the JSON format of Chrome
+ * trace_event, which can be loaded by chrome://tracing or Perfetto. Stop the
+ * trace before export to get a consistent snapshot.
+ */
+rt_err_t rtgui_trace_export(const char* filename);
+
+/* invoked by rtgui_application */
+void rtgui_trace_stamp(struct rtgui_event* event);
+void rtgui_trace_send(struct rtgui_event* event, rt_thread_t receiver, int kind, rt_err_t result);
+void rtgui_trace_begin(struct rtgui_trace_record* record, struct rtgui_event* event);
+void rtgui_trace_end(struct rtgui_trace_ring* ring, struct rtgui_trace_record* record);
+
+extern volatile rt_bool_t rtgui_trace_enabled;
+#endif
+
+#endif
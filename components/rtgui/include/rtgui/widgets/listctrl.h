@@ -34,7 +34,7 @@ struct rtgui_listctrl
 
 	/* widget private data */
 	/* listctrl items */
-    rt_uint32_t items;
+    rt_ubase_t items;
 
 	/* total number of items */
 	rt_uint16_t items_count;
@@ -51,13 +51,13 @@ typedef struct rtgui_listctrl rtgui_listctrl_t;
 
 typedef void (*rtgui_onitem_draw_t)(struct rtgui_listctrl *list, struct rtgui_dc* dc, rtgui_rect_t* rect, rt_uint16_t index);
 
-rtgui_listctrl_t* rtgui_listctrl_create(rt_uint32_t items, rt_uint16_t count,
+rtgui_listctrl_t* rtgui_listctrl_create(rt_ubase_t items, rt_uint16_t count,
     rtgui_rect_t *rect, rtgui_onitem_draw_t ondraw);
 void rtgui_listctrl_destroy(rtgui_listctrl_t* ctrl);
 
 rt_bool_t rtgui_listctrl_event_handler(struct rtgui_object* object, struct rtgui_event* event);
 void rtgui_listctrl_set_onitem(rtgui_listctrl_t* ctrl, rtgui_event_handler_ptr func);
-void rtgui_listctrl_set_items(rtgui_listctrl_t* ctrl, rt_uint32_t items, rt_uint16_t count);
+void rtgui_listctrl_set_items(rtgui_listctrl_t* ctrl, rt_ubase_t items, rt_uint16_t count);
 rt_bool_t rtgui_listctrl_get_item_rect(rtgui_listctrl_t* ctrl, rt_uint16_t item, rtgui_rect_t* item_rect);
 
 #endif
@@ -33,8 +33,16 @@ extern "C" {
 #define RTGUI_WIDGET_FLAG_FOCUSABLE		0x0010
 #define RTGUI_WIDGET_FLAG_DC_VISIBLE	0x0100
 
-#define RTGUI_WIDGET_UNHIDE(w)			(w)->flag &= ~RTGUI_WIDGET_FLAG_HIDE
-#define RTGUI_WIDGET_HIDE(w)			(w)->flag |= RTGUI_WIDGET_FLAG_HIDE
+/*
+ * the serial of the shown state of widgets, which is changed when a widget is
+ * hidden, shown or moved to another parent. The visible of dc cached in widget
+ * is checked again then.
+ */
+extern volatile rt_uint32_t rtgui_widget_visible_serial;
+#define RTGUI_WIDGET_VISIBLE_CHANGED()	(rtgui_widget_visible_serial ++)
+
+#define RTGUI_WIDGET_UNHIDE(w)			((w)->flag &= ~RTGUI_WIDGET_FLAG_HIDE, RTGUI_WIDGET_VISIBLE_CHANGED())
+#define RTGUI_WIDGET_HIDE(w)			((w)->flag |= RTGUI_WIDGET_FLAG_HIDE, RTGUI_WIDGET_VISIBLE_CHANGED())
 #define RTGUI_WIDGET_IS_HIDE(w)			((w)->flag & RTGUI_WIDGET_FLAG_HIDE)
 
 #define RTGUI_WIDGET_ENABLE(w)			(w)->flag &= ~RTGUI_WIDGET_FLAG_DISABLE
@@ -83,13 +91,15 @@ struct rtgui_widget
 	/* the widget children and sibling */
 	rtgui_list_t sibling;
 
-	/* widget flag */
-	rt_int32_t flag;
-
-	/* hardware device context */
+	/* hardware device context, keep the same layout as struct rtgui_dc */
 	rt_uint32_t dc_type;
 	const struct rtgui_dc_engine* dc_engine;
 
+	/* widget flag */
+	rt_int32_t flag;
+	/* the visible serial when the DC_VISIBLE flag is checked */
+	rt_uint32_t visible_serial;
+
 	/* the graphic context of widget */
 	rtgui_gc_t gc;
 
@@ -130,7 +140,7 @@ struct rtgui_widget
 #endif
 
 	/* user private data */
-	rt_uint32_t user_data;
+	rt_ubase_t user_data;
 };
 typedef struct rtgui_widget rtgui_widget_t;
 
@@ -190,6 +200,11 @@ struct rtgui_win* rtgui_widget_get_toplevel(rtgui_widget_t* widget);
 
 void rtgui_widget_show(rtgui_widget_t* widget);
 void rtgui_widget_hide(rtgui_widget_t* widget);
+/*
+ * check whether the widget and all of its parents are shown, the result is
+ * kept in the DC_VISIBLE flag until the visible serial is changed.
+ */
+rt_bool_t rtgui_widget_check_dc_visible(rtgui_widget_t* widget);
 void rtgui_widget_update(rtgui_widget_t* widget);
 
 /* get parent color */
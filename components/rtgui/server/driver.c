@@ -13,11 +13,16 @@
  */
 #include <rtthread.h>
 #include <rtgui/driver.h>
+#include <rtgui/region.h>
+#include <rtgui/rtgui_system.h>
+#include <rtgui/rtgui_stats.h>
 
 struct rtgui_graphic_driver _driver;
 
 extern const struct rtgui_graphic_driver_ops *rtgui_pixel_device_get_ops(int pixel_format);
 extern const struct rtgui_graphic_driver_ops *rtgui_framebuffer_get_ops(int pixel_format);
+extern const struct rtgui_graphic_driver_ops *rtgui_rotation_get_ops(const struct rtgui_graphic_driver_ops *ops, int rotation);
+extern void rtgui_rotation_rect(const struct rtgui_rect *rect, struct rtgui_rect *device_rect);
 
 /* get default driver */
 struct rtgui_graphic_driver* rtgui_graphic_driver_get_default()
@@ -35,6 +40,313 @@ void rtgui_graphic_driver_get_rect(const struct rtgui_graphic_driver *driver, rt
 	rect->y2 = driver->height;
 }
 
+/* keep a rect of device in device, an empty rect has x1 >= x2 or y1 >= y2 */
+static void _graphic_device_clip(rtgui_rect_t *rect)
+{
+	rtgui_rect_t device_rect;
+
+	device_rect.x1 = device_rect.y1 = 0;
+	device_rect.x2 = _driver.device_width;
+	device_rect.y2 = _driver.device_height;
+	rtgui_rect_intersect(&device_rect, rect);
+}
+
+#ifdef RTGUI_USING_SHADOW_FRAMEBUFFER
+static rt_bool_t _shadow_enabled = RT_FALSE;
+
+/* the lines of framebuffer, a line of mono panel is a page of 8 lines */
+static int _graphic_fb_lines(void)
+{
+	if (_driver.pixel_format == RTGRAPHIC_PIXEL_FORMAT_MONO)
+		return (_driver.device_height + 7)/8;
+	return _driver.device_height;
+}
+
+/*
+ * All of the drawing goes to the shadow in RAM, the 2D accelerator of device
+ * is not used for it only works on the memory of device.
+ */
+static void _graphic_apply_shadow(void)
+{
+	rt_size_t size;
+
+	if (_driver.framebuffer != _driver.device_framebuffer)
+	{
+		rtgui_free((void*)_driver.framebuffer);
+		_driver.framebuffer = _driver.device_framebuffer;
+	}
+	if (_shadow_enabled == RT_FALSE || _driver.device_framebuffer == RT_NULL) return;
+
+	size = _driver.pitch * _graphic_fb_lines();
+	_driver.framebuffer = rtgui_malloc(size);
+	if (_driver.framebuffer == RT_NULL)
+	{
+		/* draw on device directly */
+		_driver.framebuffer = _driver.device_framebuffer;
+		return;
+	}
+	rt_memcpy((void*)_driver.framebuffer, (void*)_driver.device_framebuffer, size);
+	_driver.ext_ops = RT_NULL;
+}
+
+/*
+ * Write a rect of device from shadow in bursts: the bytes of line are aligned
+ * to RTGUI_SHADOW_BURST, and the lines are written in one burst when the
+ * aligned bytes cover the whole pitch.
+ */
+static void _graphic_flush_shadow(const rtgui_rect_t *rect)
+{
+	int y1, y2, start, end;
+	rt_size_t offset, bytes;
+
+	if (_driver.pixel_format == RTGRAPHIC_PIXEL_FORMAT_MONO)
+	{
+		y1 = rect->y1 / 8;
+		y2 = (rect->y2 + 7) / 8;
+		start = rect->x1;
+		end = rect->x2;
+	}
+	else
+	{
+		y1 = rect->y1;
+		y2 = rect->y2;
+		start = rect->x1 * _driver.bits_per_pixel / 8;
+		end = (rect->x2 * _driver.bits_per_pixel + 7) / 8;
+	}
+	if (y2 <= y1 || end <= start) return;
+
+	start &= ~(RTGUI_SHADOW_BURST - 1);
+	end = (end + RTGUI_SHADOW_BURST - 1) & ~(RTGUI_SHADOW_BURST - 1);
+	if (end > _driver.pitch) end = _driver.pitch;
+
+	offset = y1 * _driver.pitch + start;
+	if (start == 0 && end == _driver.pitch)
+	{
+		bytes = (y2 - y1) * _driver.pitch;
+		rt_memcpy((void*)(_driver.device_framebuffer + offset), (void*)(_driver.framebuffer + offset), bytes);
+	}
+	else
+	{
+		bytes = (y2 - y1) * (end - start);
+		for (; y1 < y2; y1 ++, offset += _driver.pitch)
+		{
+			rt_memcpy((void*)(_driver.device_framebuffer + offset), (void*)(_driver.framebuffer + offset),
+				end - start);
+		}
+	}
+
+	RTGUI_STATS_FLUSH(bytes);
+}
+
+#ifdef RTGUI_USING_ASYNC_FLUSH
+/* the pixels of device written by the flush of shadow, which covers the burst */
+static void _graphic_shadow_extent(const rtgui_rect_t *rect, rtgui_rect_t *extent)
+{
+	int bits, start, end;
+
+	/* the byte of mono panel is a column of 8 lines */
+	*extent = *rect;
+	if (_driver.pixel_format == RTGRAPHIC_PIXEL_FORMAT_MONO)
+	{
+		bits = 8;
+		extent->y1 = rect->y1 & ~7;
+		extent->y2 = (rect->y2 + 7) & ~7;
+	}
+	else bits = _driver.bits_per_pixel;
+
+	start = (rect->x1 * bits / 8) & ~(RTGUI_SHADOW_BURST - 1);
+	end = ((rect->x2 * bits + 7) / 8 + RTGUI_SHADOW_BURST - 1) & ~(RTGUI_SHADOW_BURST - 1);
+	extent->x1 = start * 8 / bits;
+	extent->x2 = (end * 8 + bits - 1) / bits;
+	_graphic_device_clip(extent);
+}
+#endif
+
+rt_err_t rtgui_graphic_set_shadow(rt_bool_t enable)
+{
+	/* it's kept for the device set later */
+	_shadow_enabled = enable;
+	if (_driver.device != RT_NULL)
+	{
+		_graphic_apply_shadow();
+		if (enable == RT_TRUE && _driver.framebuffer == _driver.device_framebuffer &&
+			_driver.device_framebuffer != RT_NULL)
+			return -RT_ERROR;
+	}
+
+	return RT_EOK;
+}
+#endif
+
+#ifdef RTGUI_USING_ASYNC_FLUSH
+/*
+ * The flush thread sends the front damage to device, while the back damage
+ * is collected by screen update and swapped in when the thread is idle. An
+ * updated rect is copied from shadow to device memory at once, and the copy
+ * waits for the front damage it overlaps, so the pixels being sent are never
+ * written (copy-on-write). Without shadow the drawing is not protected.
+ */
+struct rtgui_flush_damage
+{
+	rtgui_rect_t rects[RTGUI_FLUSH_DAMAGE_MAX];
+	int count;
+};
+
+static struct rtgui_flush_damage _flush_damage[2];
+static struct rtgui_flush_damage *_flush_back = &_flush_damage[0];
+static struct rtgui_flush_damage *_flush_front = &_flush_damage[1];
+static struct rt_mutex _flush_lock;
+/* the back damage is not empty, and the front damage is sent */
+static struct rt_semaphore _flush_back_sem, _flush_front_sem;
+static rt_uint16_t _flush_waiters = 0;
+static rt_thread_t _flush_tid = RT_NULL;
+static rt_bool_t _flush_async = RT_FALSE;
+
+static rt_bool_t _flush_damage_intersect(const struct rtgui_flush_damage *damage, const rtgui_rect_t *rect)
+{
+	int index;
+
+	for (index = 0; index < damage->count; index ++)
+	{
+		if (rtgui_rect_is_intersect(&(damage->rects[index]), rect) == RT_EOK) return RT_TRUE;
+	}
+
+	return RT_FALSE;
+}
+
+/* a full damage merges the rect into the one growing least */
+static void _flush_damage_add(struct rtgui_flush_damage *damage, const rtgui_rect_t *rect)
+{
+	rtgui_rect_t *item;
+	int index, best;
+	rt_int32_t grow, best_grow;
+
+	if (damage->count < RTGUI_FLUSH_DAMAGE_MAX)
+	{
+		damage->rects[damage->count ++] = *rect;
+		return;
+	}
+
+	best = 0;
+	best_grow = 0;
+	for (index = 0; index < damage->count; index ++)
+	{
+		item = &(damage->rects[index]);
+		grow = ((item->x2 > rect->x2? item->x2 : rect->x2) - (item->x1 < rect->x1? item->x1 : rect->x1)) *
+			((item->y2 > rect->y2? item->y2 : rect->y2) - (item->y1 < rect->y1? item->y1 : rect->y1)) -
+			rtgui_rect_width(*item) * rtgui_rect_height(*item);
+		if (index == 0 || grow < best_grow)
+		{
+			best = index;
+			best_grow = grow;
+		}
+	}
+
+	item = &(damage->rects[best]);
+	if (rect->x1 < item->x1) item->x1 = rect->x1;
+	if (rect->y1 < item->y1) item->y1 = rect->y1;
+	if (rect->x2 > item->x2) item->x2 = rect->x2;
+	if (rect->y2 > item->y2) item->y2 = rect->y2;
+}
+
+static void _flush_entry(void* parameter)
+{
+	struct rt_device_rect_info rect_info;
+	struct rtgui_flush_damage *damage;
+	int index;
+
+	while (1)
+	{
+		rt_sem_take(&_flush_back_sem, RT_WAITING_FOREVER);
+
+		rt_mutex_take(&_flush_lock, RT_WAITING_FOREVER);
+		damage = _flush_back;
+		_flush_back = _flush_front;
+		_flush_front = damage;
+		rt_mutex_release(&_flush_lock);
+
+		for (index = 0; index < damage->count; index ++)
+		{
+			rect_info.x = damage->rects[index].x1;
+			rect_info.y = damage->rects[index].y1;
+			rect_info.width = rtgui_rect_width(damage->rects[index]);
+			rect_info.height = rtgui_rect_height(damage->rects[index]);
+			rt_device_control(_driver.device, RTGRAPHIC_CTRL_RECT_UPDATE, &rect_info);
+		}
+
+		rt_mutex_take(&_flush_lock, RT_WAITING_FOREVER);
+		damage->count = 0;
+		for (; _flush_waiters > 0; _flush_waiters --) rt_sem_release(&_flush_front_sem);
+		rt_mutex_release(&_flush_lock);
+	}
+}
+
+/* queue a rect of device to the flush thread */
+static void _flush_queue(const rtgui_rect_t *rect)
+{
+#ifdef RTGUI_USING_SHADOW_FRAMEBUFFER
+	rtgui_rect_t extent;
+#endif
+
+	rt_mutex_take(&_flush_lock, RT_WAITING_FOREVER);
+#ifdef RTGUI_USING_SHADOW_FRAMEBUFFER
+	if (_driver.framebuffer != _driver.device_framebuffer)
+	{
+		_graphic_shadow_extent(rect, &extent);
+		while (_flush_damage_intersect(_flush_front, &extent) == RT_TRUE)
+		{
+			_flush_waiters ++;
+			rt_mutex_release(&_flush_lock);
+			rt_sem_take(&_flush_front_sem, RT_WAITING_FOREVER);
+			rt_mutex_take(&_flush_lock, RT_WAITING_FOREVER);
+		}
+		_graphic_flush_shadow(rect);
+	}
+#endif
+
+	if (_flush_back->count == 0) rt_sem_release(&_flush_back_sem);
+	_flush_damage_add(_flush_back, rect);
+	rt_mutex_release(&_flush_lock);
+}
+
+rt_err_t rtgui_graphic_set_async_flush(rt_bool_t enable)
+{
+	if (enable == RT_TRUE && _flush_tid == RT_NULL)
+	{
+		rt_mutex_init(&_flush_lock, "flush", RT_IPC_FLAG_FIFO);
+		rt_sem_init(&_flush_back_sem, "fback", 0, RT_IPC_FLAG_FIFO);
+		rt_sem_init(&_flush_front_sem, "ffront", 0, RT_IPC_FLAG_FIFO);
+
+		_flush_tid = rt_thread_create("flush", _flush_entry, RT_NULL,
+			RTGUI_FLUSH_THREAD_STACK_SIZE, RTGUI_FLUSH_THREAD_PRIORITY, RTGUI_FLUSH_THREAD_TIMESLICE);
+		if (_flush_tid == RT_NULL) return -RT_ERROR;
+		rt_thread_startup(_flush_tid);
+	}
+
+	/* the queued damage is still sent by the thread when it's disabled */
+	_flush_async = enable;
+
+	return RT_EOK;
+}
+#endif
+
+/* the screen is the device turned by rotation */
+static void _graphic_apply_rotation(void)
+{
+	if (_driver.rotation == 90 || _driver.rotation == 270)
+	{
+		_driver.width = _driver.device_height;
+		_driver.height = _driver.device_width;
+	}
+	else
+	{
+		_driver.width = _driver.device_width;
+		_driver.height = _driver.device_height;
+	}
+
+	_driver.ops = rtgui_rotation_get_ops(_driver.device_ops, _driver.rotation);
+}
+
 rt_err_t rtgui_graphic_set_device(rt_device_t device)
 {
 	rt_err_t result;
@@ -52,22 +364,53 @@ rt_err_t rtgui_graphic_set_device(rt_device_t device)
 	_driver.device = device;
 	_driver.pixel_format = info.pixel_format;
 	_driver.bits_per_pixel = info.bits_per_pixel;
-	_driver.width = info.width;
-	_driver.height = info.height;
-	_driver.pitch = _driver.width * _driver.bits_per_pixel/8;
+	_driver.device_width = info.width;
+	_driver.device_height = info.height;
+	/* the line of mono panel is a page of 8 lines in byte per column */
+	if (_driver.pixel_format == RTGRAPHIC_PIXEL_FORMAT_MONO)
+		_driver.pitch = _driver.device_width;
+	else
+		_driver.pitch = (_driver.device_width * _driver.bits_per_pixel + 7)/8;
+#ifdef RTGUI_USING_SHADOW_FRAMEBUFFER
+	/* the shadow of the previous mode */
+	if (_driver.framebuffer != _driver.device_framebuffer)
+		rtgui_free((void*)_driver.framebuffer);
+#endif
 	_driver.framebuffer = info.framebuffer;
+	_driver.device_framebuffer = info.framebuffer;
+
+	/* the device without 2D accelerator leaves it untouched */
+	_driver.ext_ops = RT_NULL;
+	if (rt_device_control(device, RTGRAPHIC_CTRL_GET_EXT, &(_driver.ext_ops)) != RT_EOK)
+		_driver.ext_ops = RT_NULL;
+#ifdef RTGUI_USING_SHADOW_FRAMEBUFFER
+	_graphic_apply_shadow();
+#endif
 
 	if (info.framebuffer != RT_NULL)
 	{
 		/* is a frame buffer device */
-		_driver.ops = rtgui_framebuffer_get_ops(_driver.pixel_format);
+		_driver.device_ops = rtgui_framebuffer_get_ops(_driver.pixel_format);
 	}
 	else
 	{
 		/* is a pixel device */
-		_driver.ops = rtgui_pixel_device_get_ops(_driver.pixel_format);
+		_driver.device_ops = rtgui_pixel_device_get_ops(_driver.pixel_format);
 	}
-	
+	_graphic_apply_rotation();
+
+	return RT_EOK;
+}
+
+rt_err_t rtgui_graphic_set_rotation(int rotation)
+{
+	if (rotation != 0 && rotation != 90 && rotation != 180 && rotation != 270)
+		return -RT_ERROR;
+
+	/* it's kept for the device set later */
+	_driver.rotation = rotation;
+	if (_driver.device != RT_NULL) _graphic_apply_rotation();
+
 	return RT_EOK;
 }
 
@@ -75,13 +418,65 @@ rt_err_t rtgui_graphic_set_device(rt_device_t device)
 void rtgui_graphic_driver_screen_update(const struct rtgui_graphic_driver* driver, rtgui_rect_t *rect)
 {
 	struct rt_device_rect_info rect_info;
+	rtgui_rect_t device_rect;
 
-	rect_info.x = rect->x1; rect_info.y = rect->y1;
-	rect_info.width = rect->x2 - rect->x1; 
-	rect_info.height = rect->y2 - rect->y1;
+	/* the pixels drawn by the thread are written before update */
+	if (driver->ops->flush != RT_NULL) driver->ops->flush();
+
+	/* the device is updated in its native orientation */
+	rtgui_rotation_rect(rect, &device_rect);
+	RTGUI_STATS_UPDATE(rect);
+	/* the rect of window, cursor or damage can be out of screen */
+	_graphic_device_clip(&device_rect);
+	if (device_rect.x1 >= device_rect.x2 || device_rect.y1 >= device_rect.y2) return;
+#ifdef RTGUI_USING_ASYNC_FLUSH
+	if (_flush_async == RT_TRUE)
+	{
+		_flush_queue(&device_rect);
+		return;
+	}
+#endif
+#ifdef RTGUI_USING_SHADOW_FRAMEBUFFER
+	if (driver->framebuffer != driver->device_framebuffer) _graphic_flush_shadow(&device_rect);
+#endif
+	rect_info.x = device_rect.x1; rect_info.y = device_rect.y1;
+	rect_info.width = device_rect.x2 - device_rect.x1;
+	rect_info.height = device_rect.y2 - device_rect.y1;
 	rt_device_control(driver->device, RTGRAPHIC_CTRL_RECT_UPDATE, &rect_info);
 }
 
+/* copy a rect of screen to (x, y), the areas can overlap */
+void rtgui_graphic_driver_copy_area(const struct rtgui_graphic_driver* driver, rtgui_rect_t *rect, int x, int y)
+{
+	rtgui_color_t color;
+	int dx, dy, row, column;
+	int width, height;
+
+	if (driver->ops->copy_area != RT_NULL)
+	{
+		driver->ops->copy_area(rect, x, y);
+		return;
+	}
+
+	/* copy in pixel, in the order that the source is read before written */
+	dx = x - rect->x1;
+	dy = y - rect->y1;
+	width = rtgui_rect_width(*rect);
+	height = rtgui_rect_height(*rect);
+	for (row = 0; row < height; row ++)
+	{
+		int py = dy > 0? rect->y2 - 1 - row : rect->y1 + row;
+
+		for (column = 0; column < width; column ++)
+		{
+			int px = dx > 0? rect->x2 - 1 - column : rect->x1 + column;
+
+			driver->ops->get_pixel(&color, px, py);
+			driver->ops->set_pixel(&color, px + dx, py + dy);
+		}
+	}
+}
+
 /* get video frame buffer */
 rt_uint8_t* rtgui_graphic_driver_get_framebuffer(const struct rtgui_graphic_driver* driver)
 {
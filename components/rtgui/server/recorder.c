@@ -0,0 +1,384 @@
+/*
+ * File      : recorder.c
+ * This file is part of RTGUI in RT-Thread RTOS
+ * COPYRIGHT (C) 2006 - 2012, RT-Thread Development Team
+ *
+ * The license and distribution terms for this file may be
+ * found in the file LICENSE in this distribution or at
+ * http://www.rt-thread.org/license/LICENSE
+ */
+
+#include <rtgui/rtgui.h>
+#include <rtgui/event.h>
+#include <rtgui/filerw.h>
+#include <rtgui/rtgui_system.h>
+#include <rtgui/rtgui_server.h>
+#include <rtgui/rtgui_recorder.h>
+
+#ifdef RTGUI_USING_RECORDER
+struct rtgui_recorder
+{
+	/* the recording file */
+	struct rtgui_filerw* file;
+	rt_uint32_t start;
+
+	/* the replaying thread and the injected events */
+	rt_thread_t replayer;
+	rt_uint32_t count;
+	rt_uint32_t *inject;	/* injection time of each event */
+	rt_uint32_t *latency;	/* latency of each event, or RT_UINT32_MAX */
+	volatile rt_uint32_t dispatched;	/* events taken by server */
+	volatile rt_uint32_t resolved;		/* events checked for screen update */
+
+	/* the file and the replaying are set in other thread */
+	struct rt_mutex lock;
+	rt_bool_t inited;
+};
+static struct rtgui_recorder _recorder;
+
+/* the sequence in user field of event is in [1, 65535] */
+#define RTGUI_RECORDER_SEQ_MAX	65535
+
+#ifndef RT_UINT32_MAX
+#define RT_UINT32_MAX	0xffffffff
+#endif
+
+static rt_uint32_t _recorder_tick_clock(void)
+{
+	return rt_tick_get() * (1000000 / RT_TICK_PER_SECOND);
+}
+static rt_uint32_t (*_recorder_clock)(void) = _recorder_tick_clock;
+
+void rtgui_recorder_set_clock(rt_uint32_t (*clock)(void))
+{
+	if (clock == RT_NULL) clock = _recorder_tick_clock;
+	_recorder_clock = clock;
+}
+
+static void _recorder_init(void)
+{
+	rtgui_enter_critical();
+	if (_recorder.inited == RT_FALSE)
+	{
+		rt_mutex_init(&(_recorder.lock), "recorder", RT_IPC_FLAG_FIFO);
+		_recorder.inited = RT_TRUE;
+	}
+	rtgui_exit_critical();
+}
+
+rt_err_t rtgui_recorder_start(const char* filename)
+{
+	struct rtgui_recorder_header header;
+	struct rtgui_filerw* file;
+
+	_recorder_init();
+
+	file = rtgui_filerw_create_file(filename, "wb");
+	if (file == RT_NULL) return -RT_ERROR;
+
+	header.magic = RTGUI_RECORDER_MAGIC;
+	header.version = RTGUI_RECORDER_VERSION;
+	if (rtgui_filerw_write(file, &header, sizeof(header), 1) <= 0)
+	{
+		rtgui_filerw_close(file);
+		return -RT_ERROR;
+	}
+
+	rt_mutex_take(&(_recorder.lock), RT_WAITING_FOREVER);
+	if (_recorder.file != RT_NULL) rtgui_filerw_close(_recorder.file);
+	_recorder.file = file;
+	_recorder.start = _recorder_clock();
+	rt_mutex_release(&(_recorder.lock));
+
+	return RT_EOK;
+}
+
+void rtgui_recorder_stop(void)
+{
+	if (_recorder.inited == RT_FALSE) return;
+
+	rt_mutex_take(&(_recorder.lock), RT_WAITING_FOREVER);
+	if (_recorder.file != RT_NULL)
+	{
+		rtgui_filerw_close(_recorder.file);
+		_recorder.file = RT_NULL;
+	}
+	rt_mutex_release(&(_recorder.lock));
+}
+
+void rtgui_recorder_input(struct rtgui_event* event)
+{
+	struct rtgui_record record;
+
+	/* nothing to do in the most of time, check without lock */
+	if (_recorder.file == RT_NULL && _recorder.replayer == RT_NULL) return;
+
+	rt_mutex_take(&(_recorder.lock), RT_WAITING_FOREVER);
+	if (_recorder.replayer != RT_NULL && event->sender == _recorder.replayer)
+	{
+		rt_uint32_t index;
+
+		/* the user field carries the 16 bits sequence of injected event */
+		index = _recorder.dispatched +
+			(event->user + RTGUI_RECORDER_SEQ_MAX - 1 - _recorder.dispatched % RTGUI_RECORDER_SEQ_MAX) % RTGUI_RECORDER_SEQ_MAX;
+		if (event->user > 0 && index < _recorder.count)
+		{
+			/*
+			 * the previous events which haven't made a screen update before
+			 * this one are not counted, e.g. the key up.
+			 */
+			_recorder.resolved = index;
+			_recorder.dispatched = index + 1;
+		}
+	}
+	else if (_recorder.file != RT_NULL)
+	{
+		record.timestamp = _recorder_clock() - _recorder.start;
+		record.type = event->type;
+		record.reserved = 0;
+		if (event->type == RTGUI_EVENT_KBD)
+		{
+			struct rtgui_event_kbd* kbd = (struct rtgui_event_kbd*)event;
+
+			record.param[0] = kbd->type;
+			record.param[1] = kbd->key;
+			record.param[2] = kbd->mod;
+			record.param[3] = kbd->unicode;
+		}
+		else
+		{
+			struct rtgui_event_mouse* mouse = (struct rtgui_event_mouse*)event;
+
+			record.param[0] = mouse->x;
+			record.param[1] = mouse->y;
+			record.param[2] = mouse->button;
+			record.param[3] = 0;
+		}
+
+		rtgui_filerw_write(_recorder.file, &record, sizeof(record), 1);
+	}
+	rt_mutex_release(&(_recorder.lock));
+}
+
+void rtgui_recorder_update(void)
+{
+	rt_uint32_t now, index;
+
+	if (_recorder.replayer == RT_NULL) return;
+
+	rt_mutex_take(&(_recorder.lock), RT_WAITING_FOREVER);
+	if (_recorder.replayer != RT_NULL)
+	{
+		/* all of the events taken by server are reflected on screen now */
+		now = _recorder_clock();
+		for (index = _recorder.resolved; index < _recorder.dispatched; index ++)
+		{
+			if (now - _recorder.inject[index] <= RTGUI_RECORDER_TIMEOUT)
+				_recorder.latency[index] = now - _recorder.inject[index];
+		}
+		_recorder.resolved = _recorder.dispatched;
+	}
+	rt_mutex_release(&(_recorder.lock));
+}
+
+static struct rtgui_record* _recorder_load(const char* filename, rt_uint32_t *count)
+{
+	struct rtgui_recorder_header header;
+	struct rtgui_record *records, *new_records;
+	struct rtgui_filerw* file;
+	rt_uint32_t size;
+
+	file = rtgui_filerw_create_file(filename, "rb");
+	if (file == RT_NULL) return RT_NULL;
+
+	if (rtgui_filerw_read(file, &header, sizeof(header), 1) <= 0 ||
+		header.magic != RTGUI_RECORDER_MAGIC || header.version != RTGUI_RECORDER_VERSION)
+	{
+		rt_kprintf("%s is not an input record\n", filename);
+		rtgui_filerw_close(file);
+		return RT_NULL;
+	}
+
+	*count = 0;
+	size = 64;
+	records = (struct rtgui_record*) rtgui_malloc(size * sizeof(struct rtgui_record));
+	while (records != RT_NULL)
+	{
+		if (*count == size)
+		{
+			size *= 2;
+			new_records = (struct rtgui_record*) rtgui_realloc(records,
+				size * sizeof(struct rtgui_record));
+			if (new_records == RT_NULL)
+			{
+				rtgui_free(records);
+				records = RT_NULL;
+				break;
+			}
+			records = new_records;
+		}
+
+		if (rtgui_filerw_read(file, &records[*count], sizeof(struct rtgui_record), 1) <= 0)
+			break;
+		*count += 1;
+	}
+	rtgui_filerw_close(file);
+
+	return records;
+}
+
+static void _recorder_inject(struct rtgui_record* record, rt_uint32_t index)
+{
+	if (record->type == RTGUI_EVENT_KBD)
+	{
+		struct rtgui_event_kbd kbd;
+
+		RTGUI_EVENT_KBD_INIT(&kbd);
+		kbd.parent.user = index % RTGUI_RECORDER_SEQ_MAX + 1;
+		kbd.wid = RT_NULL;
+		kbd.type = record->param[0];
+		kbd.key = record->param[1];
+		kbd.mod = record->param[2];
+		kbd.unicode = record->param[3];
+
+		_recorder.inject[index] = _recorder_clock();
+		rtgui_server_post_event(&(kbd.parent), sizeof(kbd));
+	}
+	else
+	{
+		struct rtgui_event_mouse mouse;
+
+		if (record->type == RTGUI_EVENT_MOUSE_MOTION)
+			RTGUI_EVENT_MOUSE_MOTION_INIT(&mouse);
+		else
+			RTGUI_EVENT_MOUSE_BUTTON_INIT(&mouse);
+		mouse.parent.user = index % RTGUI_RECORDER_SEQ_MAX + 1;
+		mouse.wid = RT_NULL;
+		mouse.x = record->param[0];
+		mouse.y = record->param[1];
+		mouse.button = record->param[2];
+
+		_recorder.inject[index] = _recorder_clock();
+		rtgui_server_post_event(&(mouse.parent), sizeof(mouse));
+	}
+}
+
+/* shell sort, the latency array is small */
+static void _recorder_sort(rt_uint32_t *array, rt_uint32_t count)
+{
+	rt_uint32_t gap, i, j, value;
+
+	for (gap = count / 2; gap > 0; gap /= 2)
+	{
+		for (i = gap; i < count; i ++)
+		{
+			value = array[i];
+			for (j = i; j >= gap && array[j - gap] > value; j -= gap)
+				array[j] = array[j - gap];
+			array[j] = value;
+		}
+	}
+}
+
+rt_err_t rtgui_recorder_replay(const char* filename, rt_bool_t max_speed,
+	struct rtgui_replay_stat* stat)
+{
+	struct rtgui_record* records;
+	rt_uint32_t count, index, start, now, updated;
+	rt_uint32_t *inject, *latency;
+
+	RT_ASSERT(stat != RT_NULL);
+
+	_recorder_init();
+
+	records = _recorder_load(filename, &count);
+	if (records == RT_NULL) return -RT_ERROR;
+
+	inject = (rt_uint32_t*) rtgui_malloc((count + 1) * sizeof(rt_uint32_t));
+	latency = (rt_uint32_t*) rtgui_malloc((count + 1) * sizeof(rt_uint32_t));
+	if (inject == RT_NULL || latency == RT_NULL)
+	{
+		rtgui_free(inject);
+		rtgui_free(latency);
+		rtgui_free(records);
+		return -RT_ERROR;
+	}
+	for (index = 0; index < count; index ++) latency[index] = RT_UINT32_MAX;
+
+	rt_mutex_take(&(_recorder.lock), RT_WAITING_FOREVER);
+	if (_recorder.replayer != RT_NULL)
+	{
+		/* one replaying at a time */
+		rt_mutex_release(&(_recorder.lock));
+		rtgui_free(inject);
+		rtgui_free(latency);
+		rtgui_free(records);
+		return -RT_ERROR;
+	}
+	_recorder.count = count;
+	_recorder.inject = inject;
+	_recorder.latency = latency;
+	_recorder.dispatched = 0;
+	_recorder.resolved = 0;
+	_recorder.replayer = rt_thread_self();
+	rt_mutex_release(&(_recorder.lock));
+
+	start = _recorder_clock();
+	for (index = 0; index < count; index ++)
+	{
+		if (max_speed == RT_TRUE && index > 0)
+		{
+			/* wait for the screen update of previous event, or settle a while */
+			while ((_recorder.dispatched < index || _recorder.resolved < index) &&
+				_recorder_clock() - _recorder.inject[index - 1] < RTGUI_RECORDER_SETTLE)
+				rt_thread_yield();
+		}
+		else
+		{
+			while ((now = _recorder_clock() - start) < records[index].timestamp)
+			{
+				if (records[index].timestamp - now > 1000000 / RT_TICK_PER_SECOND)
+					rt_thread_delay(1);
+				else
+					rt_thread_yield();
+			}
+		}
+
+		_recorder_inject(&records[index], index);
+	}
+
+	/* wait for the screen update of the last events */
+	while (count > 0 && _recorder.resolved < count &&
+		_recorder_clock() - inject[count - 1] <= RTGUI_RECORDER_TIMEOUT)
+		rt_thread_delay(1);
+
+	rt_mutex_take(&(_recorder.lock), RT_WAITING_FOREVER);
+	_recorder.replayer = RT_NULL;
+	_recorder.inject = RT_NULL;
+	_recorder.latency = RT_NULL;
+	_recorder.count = 0;
+	rt_mutex_release(&(_recorder.lock));
+
+	/* the events without screen update are at the end after sorting */
+	_recorder_sort(latency, count);
+	for (updated = 0; updated < count && latency[updated] != RT_UINT32_MAX; updated ++) ;
+
+	rt_memset(stat, 0, sizeof(struct rtgui_replay_stat));
+	stat->events = count;
+	stat->updated = updated;
+	if (updated > 0)
+	{
+		stat->min = latency[0];
+		stat->max = latency[updated - 1];
+		stat->p50 = latency[(updated - 1) * 50 / 100];
+		stat->p90 = latency[(updated - 1) * 90 / 100];
+		stat->p99 = latency[(updated - 1) * 99 / 100];
+	}
+
+	rtgui_free(inject);
+	rtgui_free(latency);
+	rtgui_free(records);
+
+	return RT_EOK;
+}
+#endif
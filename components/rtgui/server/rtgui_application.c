@@ -16,11 +16,7 @@
 #include <rtgui/rtgui_application.h>
 #include <rtgui/widgets/window.h>
 
-#ifdef _WIN32
-#define RTGUI_EVENT_DEBUG
-#endif
-
-#ifdef RTGUI_EVENT_DEBUG
+#if defined(RTGUI_EVENT_DEBUG) || defined(RTGUI_USING_EVENT_TRACE)
 const char *event_string[] =
 {
 	/* window event */
@@ -55,11 +51,14 @@ const char *event_string[] =
 	/* user command event */
 	"COMMAND",				/* user command 		*/
 
-	/* request's status event */
-	"STATUS",				/* request result 		*/
+	/* widget event */
+	"FOCUSED",				/* widget focused 		*/
 	"SCROLLED",           	/* scroll bar scrolled  */
 	"RESIZE",				/* widget resize 		*/
 };
+#endif
+
+#ifdef RTGUI_EVENT_DEBUG
 
 #define DBG_MSG(x)	rt_kprintf x
 
@@ -239,6 +238,11 @@ static void _rtgui_application_constructor(struct rtgui_application *app)
 	app->mq             = RT_NULL;
 	app->modal_object   = RT_NULL;
 	app->on_idle        = RT_NULL;
+#ifdef RTGUI_USING_PIXEL_SPAN
+	app->span.count     = 0;
+#endif
+	app->scratch        = RT_NULL;
+	app->scratch_size   = 0;
 }
 
 static void _rtgui_application_destructor(struct rtgui_application *app)
@@ -247,6 +251,12 @@ static void _rtgui_application_destructor(struct rtgui_application *app)
 
 	rt_free(app->name);
 	app->name = RT_NULL;
+
+	if (app->scratch != RT_NULL)
+	{
+		rtgui_free(app->scratch);
+		app->scratch = RT_NULL;
+	}
 }
 
 DEFINE_CLASS_TYPE(application, "application",
@@ -273,7 +283,7 @@ struct rtgui_application* rtgui_application_create(
 
 	app->tid     = tid;
 	/* set user thread */
-	tid->user_data = (rt_uint32_t)app;
+	tid->user_data = (rt_ubase_t)app;
 
 	app->mq = rt_mq_create("rtgui", sizeof(union rtgui_event_generic), 32, RT_IPC_FLAG_FIFO);
 	if (app->mq == RT_NULL)
@@ -285,7 +295,15 @@ struct rtgui_application* rtgui_application_create(
 	/* set application title */
 	app->name = (unsigned char*)rt_strdup((char*)myname);
 	if (app->name != RT_NULL)
+	{
+#ifdef RTGUI_USING_STATS
+		rtgui_stats_thread_init(&(app->stats), (const char*)app->name);
+#endif
+#ifdef RTGUI_USING_EVENT_TRACE
+		rtgui_trace_thread_init(&(app->trace), (const char*)app->name, tid);
+#endif
 		return app;
+	}
 
 __mq_err:
 	rtgui_object_destroy(RTGUI_OBJECT(app));
@@ -312,6 +330,12 @@ void rtgui_application_destroy(struct rtgui_application *app)
 		return;
 	}
 
+#ifdef RTGUI_USING_STATS
+	rtgui_stats_thread_detach(&(app->stats));
+#endif
+#ifdef RTGUI_USING_EVENT_TRACE
+	rtgui_trace_thread_detach(&(app->trace));
+#endif
 	app->tid->user_data = 0;
 	rt_mq_delete(app->mq);
 	rtgui_object_destroy(RTGUI_OBJECT(app));
@@ -322,13 +346,48 @@ struct rtgui_application* rtgui_application_self(void)
 	struct rtgui_application *app;
 	rt_thread_t self;
 
-	/* get current thread */
+	/* get current thread, which may be not created by RT-Thread */
 	self = rt_thread_self();
+	if (self == RT_NULL) return RT_NULL;
 	app = (struct rtgui_application*)(self->user_data);
 
 	return app;
 }
 
+rt_uint8_t* rtgui_application_get_scratch(rt_size_t size)
+{
+	struct rtgui_application *app;
+	rt_uint8_t *scratch;
+
+	app = rtgui_application_self();
+	if (app == RT_NULL)
+		return (rt_uint8_t*) rtgui_malloc(size);
+
+	if (app->scratch_size < size)
+	{
+		/* the content is dropped, don't copy it by realloc */
+		scratch = (rt_uint8_t*) rtgui_malloc(size);
+		if (scratch == RT_NULL) return RT_NULL;
+
+		if (app->scratch != RT_NULL) rtgui_free(app->scratch);
+		app->scratch = scratch;
+		app->scratch_size = size;
+	}
+
+	return app->scratch;
+}
+
+void rtgui_application_put_scratch(rt_uint8_t* scratch)
+{
+	struct rtgui_application *app;
+
+	if (scratch == RT_NULL) return;
+
+	app = rtgui_application_self();
+	if (app == RT_NULL || app->scratch != scratch)
+		rtgui_free(scratch);
+}
+
 void rtgui_application_set_onidle(rtgui_idle_func onidle)
 {
 	struct rtgui_application *app;
@@ -371,12 +430,24 @@ rt_err_t rtgui_application_send(rt_thread_t tid, rtgui_event_t* event, rt_size_t
 	if (app == RT_NULL)
 		return -RT_ERROR;
 
+#ifdef RTGUI_USING_EVENT_TRACE
+	rtgui_trace_stamp(event);
+#endif
 	result = rt_mq_send(app->mq, event, event_size);
+#ifdef RTGUI_USING_EVENT_TRACE
+	rtgui_trace_send(event, tid, RTGUI_TRACE_SEND, result);
+#endif
 	if (result != RT_EOK)
 	{
+#ifdef RTGUI_USING_STATS
+		app->stats.event_dropped ++;
+#endif
 		if (event->type != RTGUI_EVENT_TIMER)
 			rt_kprintf("send event to %s failed\n", app->tid->name);
 	}
+#ifdef RTGUI_USING_STATS
+	else app->stats.event_sent ++;
+#endif
 
 	return result;
 }
@@ -397,9 +468,23 @@ rt_err_t rtgui_application_send_urgent(rt_thread_t tid, rtgui_event_t* event, rt
 	if (app == RT_NULL)
 		return -RT_ERROR;
 
+#ifdef RTGUI_USING_EVENT_TRACE
+	rtgui_trace_stamp(event);
+#endif
 	result = rt_mq_urgent(app->mq, event, event_size);
+#ifdef RTGUI_USING_EVENT_TRACE
+	rtgui_trace_send(event, tid, RTGUI_TRACE_SEND_URGENT, result);
+#endif
 	if (result != RT_EOK)
+	{
+#ifdef RTGUI_USING_STATS
+		app->stats.event_dropped ++;
+#endif
 		rt_kprintf("send ergent event failed\n");
+	}
+#ifdef RTGUI_USING_STATS
+	else app->stats.event_sent ++;
+#endif
 
 	return result;
 }
@@ -430,14 +515,29 @@ rt_err_t rtgui_application_send_sync(rt_thread_t tid, rtgui_event_t* event, rt_s
 	}
 
 	event->ack = &ack_mb;
+#ifdef RTGUI_USING_EVENT_TRACE
+	rtgui_trace_stamp(event);
+#endif
 	r = rt_mq_send(app->mq, event, event_size);
 	if (r != RT_EOK)
 	{
+#ifdef RTGUI_USING_EVENT_TRACE
+		rtgui_trace_send(event, tid, RTGUI_TRACE_SEND_SYNC, r);
+#endif
+#ifdef RTGUI_USING_STATS
+		app->stats.event_dropped ++;
+#endif
 		rt_kprintf("send sync event failed\n");
 		goto __return;
 	}
+#ifdef RTGUI_USING_STATS
+	app->stats.event_sent ++;
+#endif
 
 	r = rt_mb_recv(&ack_mb, (rt_uint32_t*)&ack_status, RT_WAITING_FOREVER);
+#ifdef RTGUI_USING_EVENT_TRACE
+	rtgui_trace_send(event, tid, RTGUI_TRACE_SEND_SYNC, RT_EOK);
+#endif
 	if (r!= RT_EOK)
 		goto __return;
 
@@ -475,6 +575,9 @@ rt_err_t rtgui_application_recv(rtgui_event_t* event, rt_size_t event_size)
 		return -RT_ERROR;
 
 	r = rt_mq_recv(app->mq, event, event_size, RT_WAITING_FOREVER);
+#ifdef RTGUI_USING_STATS
+	if (r == RT_EOK) app->stats.event_received ++;
+#endif
 
 	return r;
 }
@@ -492,10 +595,27 @@ rt_err_t rtgui_application_recv_nosuspend(rtgui_event_t* event, rt_size_t event_
 		return -RT_ERROR;
 
 	r = rt_mq_recv(app->mq, event, event_size, 0);
+#ifdef RTGUI_USING_STATS
+	if (r == RT_EOK) app->stats.event_received ++;
+#endif
 
 	return r;
 }
 
+/* dispatch an event received to the event handler of application */
+rt_inline void _rtgui_application_dispatch(struct rtgui_application *app, struct rtgui_event *event)
+{
+#ifdef RTGUI_USING_EVENT_TRACE
+	struct rtgui_trace_record record;
+
+	rtgui_trace_begin(&record, event);
+#endif
+	RTGUI_OBJECT(app)->event_handler(RTGUI_OBJECT(app), event);
+#ifdef RTGUI_USING_EVENT_TRACE
+	rtgui_trace_end(&(app->trace), &record);
+#endif
+}
+
 rt_err_t rtgui_application_recv_filter(rt_uint32_t type, rtgui_event_t* event, rt_size_t event_size)
 {
 	struct rtgui_application *app;
@@ -509,6 +629,9 @@ rt_err_t rtgui_application_recv_filter(rt_uint32_t type, rtgui_event_t* event, r
 
 	while (rt_mq_recv(app->mq, event, event_size, RT_WAITING_FOREVER) == RT_EOK)
 	{
+#ifdef RTGUI_USING_STATS
+		app->stats.event_received ++;
+#endif
 		if (event->type == type)
 		{
 			return RT_EOK;
@@ -517,7 +640,7 @@ rt_err_t rtgui_application_recv_filter(rt_uint32_t type, rtgui_event_t* event, r
 		{
 			if (RTGUI_OBJECT(app)->event_handler != RT_NULL)
 			{
-				RTGUI_OBJECT(app)->event_handler(RTGUI_OBJECT(app), event);
+				_rtgui_application_dispatch(app, event);
 			}
 		}
 	}
@@ -639,7 +762,7 @@ rt_inline void _rtgui_application_event_loop(struct rtgui_application *app)
 		{
 			result = rtgui_application_recv_nosuspend(event, sizeof(union rtgui_event_generic));
 			if (result == RT_EOK)
-				RTGUI_OBJECT(app)->event_handler(RTGUI_OBJECT(app), event);
+				_rtgui_application_dispatch(app, event);
 			else if (result == -RT_ETIMEOUT)
 				app->on_idle(RTGUI_OBJECT(app), RT_NULL);
 		}
@@ -647,7 +770,7 @@ rt_inline void _rtgui_application_event_loop(struct rtgui_application *app)
 		{
 			result = rtgui_application_recv(event, sizeof(union rtgui_event_generic));
 			if (result == RT_EOK)
-				RTGUI_OBJECT(app)->event_handler(RTGUI_OBJECT(app), event);
+				_rtgui_application_dispatch(app, event);
 		}
 	}
 }
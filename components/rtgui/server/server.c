@@ -18,6 +18,7 @@
 #include <rtgui/rtgui_object.h>
 #include <rtgui/rtgui_application.h>
 #include <rtgui/driver.h>
+#include <rtgui/rtgui_recorder.h>
 
 #include "mouse.h"
 #include "topwin.h"
@@ -25,15 +26,137 @@
 static struct rt_thread *rtgui_server_tid;
 static struct rtgui_application *rtgui_server_application;
 
-void rtgui_server_handle_update(struct rtgui_event_update_end* event)
+/*
+ * The update rects are merged into the damage of screen, which is flushed to
+ * device once per frame tick. The update after an idle frame is flushed at
+ * once, the following ones wait for the end of frame. Two rects are merged
+ * when the pixels wasted by their bounding rect are not more than
+ * RTGUI_SVR_DAMAGE_COST, the cost of a transfer to panel.
+ */
+static rtgui_rect_t _server_damage[RTGUI_SVR_DAMAGE_MAX];
+static int _server_damage_count = 0;
+#ifdef RTGUI_SVR_FRAME_TICK
+static rt_int32_t _server_frame_tick = RTGUI_SVR_FRAME_TICK;
+#else
+static rt_int32_t _server_frame_tick = 0;
+#endif
+static rtgui_timer_t* _server_frame_timer = RT_NULL;
+static rt_tick_t _server_frame_start;
+
+rt_inline rt_int32_t _rect_area(const rtgui_rect_t *rect)
+{
+	return rtgui_rect_width(*rect) * rtgui_rect_height(*rect);
+}
+
+/* the pixels of bounding rect, which are not in the two rects */
+static rt_int32_t _server_damage_waste(const rtgui_rect_t *rect1, const rtgui_rect_t *rect2,
+	rtgui_rect_t *bound)
+{
+	rtgui_rect_t inter;
+	rt_int32_t waste;
+
+	bound->x1 = rect1->x1 < rect2->x1? rect1->x1 : rect2->x1;
+	bound->y1 = rect1->y1 < rect2->y1? rect1->y1 : rect2->y1;
+	bound->x2 = rect1->x2 > rect2->x2? rect1->x2 : rect2->x2;
+	bound->y2 = rect1->y2 > rect2->y2? rect1->y2 : rect2->y2;
+
+	waste = _rect_area(bound) - _rect_area(rect1) - _rect_area(rect2);
+	if (rtgui_rect_is_intersect(rect1, rect2) == RT_EOK)
+	{
+		inter = *rect2;
+		rtgui_rect_intersect((rtgui_rect_t*)rect1, &inter);
+		waste += _rect_area(&inter);
+	}
+
+	return waste;
+}
+
+static void _server_damage_add(const rtgui_rect_t *rect)
+{
+	rtgui_rect_t damage, bound, best_bound;
+	rt_int32_t waste, best_waste;
+	int index, best;
+
+	if (rect->x2 <= rect->x1 || rect->y2 <= rect->y1) return;
+
+	damage = *rect;
+	while (1)
+	{
+		best = -1;
+		best_waste = 0;
+		for (index = 0; index < _server_damage_count; index ++)
+		{
+			waste = _server_damage_waste(&_server_damage[index], &damage, &bound);
+			if (best < 0 || waste < best_waste)
+			{
+				best = index;
+				best_waste = waste;
+				best_bound = bound;
+			}
+		}
+
+		/* the full damage is merged into the cheapest one anyway */
+		if (best < 0 || (best_waste > RTGUI_SVR_DAMAGE_COST &&
+			_server_damage_count < RTGUI_SVR_DAMAGE_MAX))
+			break;
+
+		/* the merged rect may be merged with others again */
+		damage = best_bound;
+		_server_damage[best] = _server_damage[-- _server_damage_count];
+	}
+
+	_server_damage[_server_damage_count ++] = damage;
+}
+
+static void _server_damage_flush(void)
 {
 	struct rtgui_graphic_driver* driver;
+	int index;
+
+	if (_server_damage_count == 0) return;
 
 	driver = rtgui_graphic_driver_get_default();
-	if (driver != RT_NULL)
+	for (index = 0; index < _server_damage_count; index ++)
+		rtgui_graphic_driver_screen_update(driver, &_server_damage[index]);
+	_server_damage_count = 0;
+	_server_frame_start = rt_tick_get();
+
+#ifdef RTGUI_USING_RECORDER
+	rtgui_recorder_update();
+#endif
+}
+
+static void _server_frame_timeout(struct rtgui_timer* timer, void* parameter)
+{
+	_server_damage_flush();
+}
+
+void rtgui_server_set_frame_tick(rt_int32_t tick)
+{
+	_server_frame_tick = tick;
+}
+
+void rtgui_server_handle_update(struct rtgui_event_update_end* event)
+{
+	rt_tick_t elapsed;
+
+	elapsed = rt_tick_get() - _server_frame_start;
+	if (_server_frame_timer == RT_NULL ||
+		(_server_damage_count == 0 && elapsed >= (rt_tick_t)_server_frame_tick))
 	{
-		rtgui_graphic_driver_screen_update(driver, &(event->rect));
+		_server_damage_add(&(event->rect));
+		_server_damage_flush();
+		return;
 	}
+
+	/* the first damage of frame starts the timer to the end of frame */
+	if (_server_damage_count == 0)
+	{
+		elapsed = _server_frame_tick - elapsed;
+		rt_timer_control(&(_server_frame_timer->timer), RT_TIMER_CTRL_SET_TIME, &elapsed);
+		rtgui_timer_start(_server_frame_timer);
+	}
+	_server_damage_add(&(event->rect));
 }
 
 void rtgui_server_handle_monitor_add(struct rtgui_event_monitor* event)
@@ -275,20 +398,37 @@ static rt_bool_t rtgui_server_event_handler(struct rtgui_object *object,
 
         /* mouse and keyboard event */
     case RTGUI_EVENT_MOUSE_MOTION:
+#ifdef RTGUI_USING_RECORDER
+        rtgui_recorder_input(event);
+#endif
         /* handle mouse motion event */
         rtgui_server_handle_mouse_motion((struct rtgui_event_mouse*)event);
         break;
 
     case RTGUI_EVENT_MOUSE_BUTTON:
+#ifdef RTGUI_USING_RECORDER
+        rtgui_recorder_input(event);
+#endif
         /* handle mouse button */
         rtgui_server_handle_mouse_btn((struct rtgui_event_mouse*)event);
         break;
 
     case RTGUI_EVENT_KBD:
+#ifdef RTGUI_USING_RECORDER
+        rtgui_recorder_input(event);
+#endif
         /* handle keyboard event */
         rtgui_server_handle_kbd((struct rtgui_event_kbd*)event);
         break;
 
+    case RTGUI_EVENT_TIMER:
+        {
+            struct rtgui_timer* timer = ((struct rtgui_event_timer*)event)->timer;
+
+            if (timer->timeout != RT_NULL) timer->timeout(timer, timer->user_data);
+        }
+        break;
+
     case RTGUI_EVENT_COMMAND:
         break;
     }
@@ -315,6 +455,10 @@ static void rtgui_server_entry(void* parameter)
 
     rtgui_object_set_event_handler(RTGUI_OBJECT(rtgui_server_application),
                                    rtgui_server_event_handler);
+	/* the update is flushed on every UPDATE_END without frame tick */
+	if (_server_frame_tick > 0)
+		_server_frame_timer = rtgui_timer_create(_server_frame_tick, RT_TIMER_FLAG_ONE_SHOT,
+			_server_frame_timeout, RT_NULL);
 	/* init mouse and show */
 	rtgui_mouse_init();
 #ifdef RTGUI_USING_MOUSE_CURSOR
@@ -323,6 +467,12 @@ static void rtgui_server_entry(void* parameter)
 
     rtgui_application_run(rtgui_server_application);
 
+	_server_damage_flush();
+	if (_server_frame_timer != RT_NULL)
+	{
+		rtgui_timer_destory(_server_frame_timer);
+		_server_frame_timer = RT_NULL;
+	}
     rtgui_application_destroy(rtgui_server_application);
     rtgui_server_application = RT_NULL;
 }
@@ -0,0 +1,462 @@
+/*
+ * File      : trace.c
+ * This file is part of RTGUI in RT-Thread RTOS
+ * COPYRIGHT (C) 2006 - 2012, RT-Thread Development Team
+ *
+ * The license and distribution terms for this file may be
+ * found in the file LICENSE in this distribution or at
+ * http://www.rt-thread.org/license/LICENSE
+ */
+
+#include <rtgui/rtgui.h>
+#include <rtgui/event.h>
+#include <rtgui/filerw.h>
+#include <rtgui/rtgui_system.h>
+#include <rtgui/rtgui_application.h>
+#include <rtgui/rtgui_trace.h>
+
+#ifdef RTGUI_USING_EVENT_TRACE
+/* the writers of the shared ring, whose names are kept for export */
+#ifndef RTGUI_TRACE_OTHERS_MAX
+#define RTGUI_TRACE_OTHERS_MAX		8
+#endif
+
+/* the thread id of the writers of shared ring in the exported file */
+#define RTGUI_TRACE_OTHERS_TID		1000
+
+struct rtgui_trace
+{
+	rtgui_list_t rings;
+	rt_uint32_t index;
+	rt_uint32_t start;
+
+	/* the shared ring of the threads without rtgui_application */
+	struct rtgui_trace_ring others;
+	struct rtgui_trace_record others_records[RTGUI_TRACE_RING_SIZE];
+	struct
+	{
+		rt_thread_t tid;
+		char name[RT_NAME_MAX + 1];
+	} writers[RTGUI_TRACE_OTHERS_MAX];
+
+	/* the rings are registered and exported in different threads */
+	struct rt_mutex lock;
+	rt_bool_t inited;
+};
+static struct rtgui_trace _trace;
+
+volatile rt_bool_t rtgui_trace_enabled = RT_FALSE;
+
+/* the name of event types, which is defined in rtgui_application.c */
+extern const char *event_string[];
+
+static rt_uint32_t _trace_tick_clock(void)
+{
+	return rt_tick_get() * (1000000 / RT_TICK_PER_SECOND);
+}
+static rt_uint32_t (*_trace_clock)(void) = _trace_tick_clock;
+
+void rtgui_trace_set_clock(rt_uint32_t (*clock)(void))
+{
+	if (clock == RT_NULL) clock = _trace_tick_clock;
+	_trace_clock = clock;
+}
+
+static void _trace_init(void)
+{
+	rtgui_enter_critical();
+	if (_trace.inited == RT_FALSE)
+	{
+		rt_mutex_init(&(_trace.lock), "trace", RT_IPC_FLAG_FIFO);
+		_trace.others.name = "others";
+		_trace.others.records = _trace.others_records;
+		_trace.inited = RT_TRUE;
+	}
+	rtgui_exit_critical();
+}
+
+void rtgui_trace_thread_init(struct rtgui_trace_ring* ring, const char* name, rt_thread_t tid)
+{
+	RT_ASSERT(ring != RT_NULL);
+
+	_trace_init();
+
+	rt_memset(ring, 0, sizeof(struct rtgui_trace_ring));
+	ring->name = name;
+	ring->tid = tid;
+	/* a ring without records is skipped */
+	ring->records = rtgui_malloc(sizeof(struct rtgui_trace_record) * RTGUI_TRACE_RING_SIZE);
+
+	rt_mutex_take(&(_trace.lock), RT_WAITING_FOREVER);
+	/* the index 0 is the shared ring */
+	ring->index = _trace.index % 255 + 1;
+	_trace.index ++;
+	rtgui_list_append(&(_trace.rings), &(ring->list));
+	rt_mutex_release(&(_trace.lock));
+}
+
+void rtgui_trace_thread_detach(struct rtgui_trace_ring* ring)
+{
+	RT_ASSERT(ring != RT_NULL);
+
+	rt_mutex_take(&(_trace.lock), RT_WAITING_FOREVER);
+	rtgui_list_remove(&(_trace.rings), &(ring->list));
+	rt_mutex_release(&(_trace.lock));
+
+	if (ring->records != RT_NULL)
+	{
+		rtgui_free(ring->records);
+		ring->records = RT_NULL;
+	}
+}
+
+void rtgui_trace_start(void)
+{
+	struct rtgui_list_node* node;
+
+	_trace_init();
+
+	rtgui_trace_enabled = RT_FALSE;
+	rt_mutex_take(&(_trace.lock), RT_WAITING_FOREVER);
+	rtgui_list_foreach(node, &(_trace.rings))
+	{
+		rtgui_list_entry(node, struct rtgui_trace_ring, list)->head = 0;
+	}
+	_trace.others.head = 0;
+	_trace.start = _trace_clock();
+	rt_mutex_release(&(_trace.lock));
+	rtgui_trace_enabled = RT_TRUE;
+}
+
+void rtgui_trace_stop(void)
+{
+	rtgui_trace_enabled = RT_FALSE;
+}
+
+/* get the ring of current thread, RT_NULL for the shared one */
+rt_inline struct rtgui_trace_ring* _trace_self_ring(void)
+{
+	struct rtgui_application* app;
+
+	app = rtgui_application_self();
+	return app != RT_NULL? &(app->trace) : RT_NULL;
+}
+
+rt_inline void _trace_push(struct rtgui_trace_ring* ring, struct rtgui_trace_record* record)
+{
+	if (ring->records == RT_NULL) return;
+
+	ring->records[ring->head % RTGUI_TRACE_RING_SIZE] = *record;
+	ring->head ++;
+}
+
+/* remember the name of a writer of shared ring, in critical section */
+static void _trace_others_writer(rt_thread_t tid)
+{
+	int index;
+
+	for (index = 0; index < RTGUI_TRACE_OTHERS_MAX; index ++)
+	{
+		if (_trace.writers[index].tid == tid) return;
+		if (_trace.writers[index].tid == RT_NULL)
+		{
+			_trace.writers[index].tid = tid;
+			rt_strncpy(_trace.writers[index].name, tid->name, RT_NAME_MAX);
+			return;
+		}
+	}
+}
+
+void rtgui_trace_stamp(struct rtgui_event* event)
+{
+	struct rtgui_trace_ring* ring;
+
+	if (rtgui_trace_enabled == RT_FALSE)
+	{
+		event->trace_id = 0;
+		return;
+	}
+
+	ring = _trace_self_ring();
+	if (ring != RT_NULL)
+	{
+		ring->sent ++;
+		event->trace_id = (ring->index << 24) | (ring->sent & 0xffffff);
+	}
+	else
+	{
+		rtgui_enter_critical();
+		_trace.others.sent ++;
+		event->trace_id = _trace.others.sent & 0xffffff;
+		rtgui_exit_critical();
+	}
+	/* the id 0 means no trace */
+	if (event->trace_id == 0) event->trace_id = 1;
+
+	event->trace_time = _trace_clock();
+}
+
+void rtgui_trace_send(struct rtgui_event* event, rt_thread_t receiver, int kind, rt_err_t result)
+{
+	struct rtgui_trace_ring* ring;
+	struct rtgui_trace_record record;
+
+	if (rtgui_trace_enabled == RT_FALSE || event->trace_id == 0) return;
+
+	record.timestamp = event->trace_time;
+	record.duration = _trace_clock() - event->trace_time;
+	record.queued = event->trace_time;
+	record.id = event->trace_id;
+	record.sender = rt_thread_self();
+	record.receiver = receiver;
+	record.wid = RT_NULL;
+	record.type = event->type;
+	record.kind = kind;
+	record.flag = result != RT_EOK? RTGUI_TRACE_FLAG_DROPPED : 0;
+
+	ring = _trace_self_ring();
+	if (ring != RT_NULL)
+	{
+		_trace_push(ring, &record);
+	}
+	else
+	{
+		rtgui_enter_critical();
+		_trace_others_writer(record.sender);
+		_trace_push(&(_trace.others), &record);
+		rtgui_exit_critical();
+	}
+}
+
+void rtgui_trace_begin(struct rtgui_trace_record* record, struct rtgui_event* event)
+{
+	if (rtgui_trace_enabled == RT_FALSE)
+	{
+		record->kind = RTGUI_TRACE_SEND;
+		return;
+	}
+
+	record->timestamp = _trace_clock();
+	record->queued = event->trace_id != 0? event->trace_time : record->timestamp;
+	record->id = event->trace_id;
+	record->sender = event->sender;
+	record->receiver = rt_thread_self();
+	record->type = event->type;
+	record->kind = RTGUI_TRACE_HANDLE;
+	record->flag = 0;
+
+	/* the handler may set the window of event, take it before */
+	switch (event->type)
+	{
+	case RTGUI_EVENT_WIN_CREATE:
+	case RTGUI_EVENT_WIN_DESTROY:
+	case RTGUI_EVENT_WIN_SHOW:
+	case RTGUI_EVENT_WIN_HIDE:
+	case RTGUI_EVENT_WIN_ACTIVATE:
+	case RTGUI_EVENT_WIN_DEACTIVATE:
+	case RTGUI_EVENT_WIN_CLOSE:
+	case RTGUI_EVENT_WIN_MOVE:
+	case RTGUI_EVENT_WIN_RESIZE:
+	case RTGUI_EVENT_WIN_MODAL_ENTER:
+	case RTGUI_EVENT_MONITOR_ADD:
+	case RTGUI_EVENT_MONITOR_REMOVE:
+	case RTGUI_EVENT_PAINT:
+	case RTGUI_EVENT_CLIP_INFO:
+	case RTGUI_EVENT_MOUSE_MOTION:
+	case RTGUI_EVENT_MOUSE_BUTTON:
+	case RTGUI_EVENT_KBD:
+	case RTGUI_EVENT_COMMAND:
+		record->wid = ((struct rtgui_event_win*)event)->wid;
+		break;
+
+	default:
+		record->wid = RT_NULL;
+		break;
+	}
+}
+
+void rtgui_trace_end(struct rtgui_trace_ring* ring, struct rtgui_trace_record* record)
+{
+	/* the trace is started in handler, or it's not started */
+	if (record->kind != RTGUI_TRACE_HANDLE || rtgui_trace_enabled == RT_FALSE) return;
+
+	record->duration = _trace_clock() - record->timestamp;
+	_trace_push(ring, record);
+}
+
+/* the thread id and name in the exported file, in the lock of trace */
+static int _trace_thread(rt_thread_t tid, const char** name)
+{
+	struct rtgui_list_node* node;
+	struct rtgui_trace_ring* ring;
+	int index;
+
+	rtgui_list_foreach(node, &(_trace.rings))
+	{
+		ring = rtgui_list_entry(node, struct rtgui_trace_ring, list);
+		if (ring->tid == tid)
+		{
+			if (name != RT_NULL) *name = ring->name;
+			return ring->index;
+		}
+	}
+
+	for (index = 0; index < RTGUI_TRACE_OTHERS_MAX; index ++)
+	{
+		if (_trace.writers[index].tid == tid)
+		{
+			if (name != RT_NULL) *name = _trace.writers[index].name;
+			return RTGUI_TRACE_OTHERS_TID + index + 1;
+		}
+	}
+
+	if (name != RT_NULL) *name = "(unknown)";
+	return RTGUI_TRACE_OTHERS_TID;
+}
+
+static const char* _trace_event_name(rt_uint16_t type, char* buffer, rt_size_t size)
+{
+	if (type <= RTGUI_EVENT_RESIZE) return event_string[type];
+
+	rt_snprintf(buffer, size, "EVENT_%d", type);
+	return buffer;
+}
+
+static const char* _trace_kind_name[] = {"send", "send_urgent", "send_sync", "handle"};
+
+static int _trace_write(struct rtgui_filerw* file, const char* line, rt_bool_t* first)
+{
+	int result;
+
+	if (*first == RT_FALSE && rtgui_filerw_write(file, ",\n", 2, 1) <= 0)
+		return -RT_ERROR;
+	*first = RT_FALSE;
+
+	result = rtgui_filerw_write(file, line, rt_strlen(line), 1);
+	return result > 0? RT_EOK : -RT_ERROR;
+}
+
+static rt_err_t _trace_export_ring(struct rtgui_filerw* file, struct rtgui_trace_ring* ring,
+	rt_bool_t* first)
+{
+	struct rtgui_trace_record* record;
+	rt_uint32_t index, head;
+	const char *name, *peer;
+	char line[256], type_name[16];
+	int tid;
+
+	if (ring->records == RT_NULL) return RT_EOK;
+
+	head = ring->head;
+	index = head > RTGUI_TRACE_RING_SIZE? head - RTGUI_TRACE_RING_SIZE : 0;
+	for (; index < head; index ++)
+	{
+		record = &(ring->records[index % RTGUI_TRACE_RING_SIZE]);
+		name = _trace_event_name(record->type, type_name, sizeof(type_name));
+
+		if (record->kind == RTGUI_TRACE_HANDLE)
+		{
+			tid = _trace_thread(record->receiver, RT_NULL);
+			_trace_thread(record->sender, &peer);
+			rt_snprintf(line, sizeof(line),
+				"{\"name\":\"%s\",\"cat\":\"handle\",\"ph\":\"X\",\"ts\":%u,\"dur\":%u,\"pid\":1,\"tid\":%d,"
+				"\"args\":{\"from\":\"%s\",\"queue\":%u,\"wid\":\"%p\"}}",
+				name, record->timestamp - _trace.start, record->duration, tid,
+				peer, record->timestamp - record->queued, (void*)record->wid);
+			if (_trace_write(file, line, first) != RT_EOK) return -RT_ERROR;
+
+			if (record->id == 0) continue;
+			/* the end of flow binds to the enclosing handler */
+			rt_snprintf(line, sizeof(line),
+				"{\"name\":\"%s\",\"cat\":\"event\",\"ph\":\"f\",\"bp\":\"e\",\"id\":%u,\"ts\":%u,\"pid\":1,\"tid\":%d}",
+				name, record->id, record->timestamp - _trace.start, tid);
+			if (_trace_write(file, line, first) != RT_EOK) return -RT_ERROR;
+		}
+		else
+		{
+			tid = _trace_thread(record->sender, RT_NULL);
+			_trace_thread(record->receiver, &peer);
+			rt_snprintf(line, sizeof(line),
+				"{\"name\":\"%s\",\"cat\":\"%s\",\"ph\":\"X\",\"ts\":%u,\"dur\":%u,\"pid\":1,\"tid\":%d,"
+				"\"args\":{\"to\":\"%s\",\"dropped\":%d}}",
+				name, _trace_kind_name[record->kind], record->timestamp - _trace.start,
+				record->duration, tid, peer, record->flag & RTGUI_TRACE_FLAG_DROPPED? 1 : 0);
+			if (_trace_write(file, line, first) != RT_EOK) return -RT_ERROR;
+
+			if (record->flag & RTGUI_TRACE_FLAG_DROPPED) continue;
+			rt_snprintf(line, sizeof(line),
+				"{\"name\":\"%s\",\"cat\":\"event\",\"ph\":\"s\",\"id\":%u,\"ts\":%u,\"pid\":1,\"tid\":%d}",
+				name, record->id, record->timestamp - _trace.start, tid);
+			if (_trace_write(file, line, first) != RT_EOK) return -RT_ERROR;
+		}
+	}
+
+	return RT_EOK;
+}
+
+static rt_err_t _trace_export_name(struct rtgui_filerw* file, int tid, const char* name,
+	rt_bool_t* first)
+{
+	char line[128];
+
+	rt_snprintf(line, sizeof(line),
+		"{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":%d,\"args\":{\"name\":\"%s\"}}",
+		tid, name);
+	return _trace_write(file, line, first);
+}
+
+rt_err_t rtgui_trace_export(const char* filename)
+{
+	struct rtgui_list_node* node;
+	struct rtgui_trace_ring* ring;
+	struct rtgui_filerw* file;
+	rt_bool_t first = RT_TRUE;
+	rt_err_t result = RT_EOK;
+	int index;
+
+	_trace_init();
+
+	file = rtgui_filerw_create_file(filename, "wb");
+	if (file == RT_NULL) return -RT_ERROR;
+
+	rt_mutex_take(&(_trace.lock), RT_WAITING_FOREVER);
+	if (rtgui_filerw_write(file, "{\"traceEvents\":[\n", 17, 1) <= 0)
+		result = -RT_ERROR;
+
+	rtgui_list_foreach(node, &(_trace.rings))
+	{
+		ring = rtgui_list_entry(node, struct rtgui_trace_ring, list);
+		if (result == RT_EOK)
+			result = _trace_export_name(file, ring->index, ring->name, &first);
+	}
+	for (index = 0; index < RTGUI_TRACE_OTHERS_MAX && _trace.writers[index].tid != RT_NULL; index ++)
+	{
+		if (result == RT_EOK)
+			result = _trace_export_name(file, RTGUI_TRACE_OTHERS_TID + index + 1,
+				_trace.writers[index].name, &first);
+	}
+
+	rtgui_list_foreach(node, &(_trace.rings))
+	{
+		ring = rtgui_list_entry(node, struct rtgui_trace_ring, list);
+		if (result == RT_EOK)
+			result = _trace_export_ring(file, ring, &first);
+	}
+	if (result == RT_EOK)
+		result = _trace_export_ring(file, &(_trace.others), &first);
+
+	if (result == RT_EOK && rtgui_filerw_write(file, "\n]}\n", 4, 1) <= 0)
+		result = -RT_ERROR;
+	rt_mutex_release(&(_trace.lock));
+
+	rtgui_filerw_close(file);
+	return result;
+}
+
+#ifdef RT_USING_FINSH
+#include <finsh.h>
+FINSH_FUNCTION_EXPORT(rtgui_trace_start, start the event trace of rtgui);
+FINSH_FUNCTION_EXPORT(rtgui_trace_stop, stop the event trace of rtgui);
+FINSH_FUNCTION_EXPORT(rtgui_trace_export, export the event trace to a Chrome trace file);
+#endif
+#endif
@@ -32,9 +32,9 @@ void rtgui_checkbox_set_onbutton(rtgui_checkbox_t* checkbox, rtgui_onbutton_func
 rt_bool_t rtgui_checkbox_event_handler(struct rtgui_object* object, struct rtgui_event* event)
 {
 	struct rtgui_widget *widget;
-	struct rtgui_checkbox *box = (struct rtgui_checkbox*)widget;
+	struct rtgui_checkbox *box;
 
-	RT_ASSERT(widget != RT_NULL);
+	RT_ASSERT(object != RT_NULL);
 	RT_ASSERT(event != RT_NULL);
 
 	widget = RTGUI_WIDGET(object);
@@ -169,7 +169,7 @@ static rt_bool_t rtgui_combobox_onmouse_button(struct rtgui_combobox* box, struc
 				box->pd_win = rtgui_win_create(RT_NULL, "combo", &rect, RTGUI_WIN_STYLE_NO_TITLE);
 				rtgui_win_set_ondeactivate(RTGUI_WIN(box->pd_win), rtgui_combobox_pulldown_hide);
 				/* set user data to parent combobox */
-				box->pd_win->user_data = (rt_uint32_t)box;
+				box->pd_win->user_data = (rt_ubase_t)box;
 
 				/* create list box */
 				rtgui_rect_inflate(&rect, -1);
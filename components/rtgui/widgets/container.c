@@ -206,6 +206,7 @@ void rtgui_container_add_child(rtgui_container_t *container, rtgui_widget_t* chi
 
 	/* set parent and toplevel widget */
 	child->parent = RTGUI_WIDGET(container);
+	RTGUI_WIDGET_VISIBLE_CHANGED();
 	/* put widget to parent's children list */
 	rtgui_list_append(&(container->children), &(child->sibling));
 
@@ -237,6 +238,7 @@ void rtgui_container_remove_child(rtgui_container_t *container, rtgui_widget_t*
 	/* set parent and toplevel widget */
 	child->parent = RT_NULL;
 	child->toplevel = RT_NULL;
+	RTGUI_WIDGET_VISIBLE_CHANGED();
 }
 
 /* destroy all children of container */
@@ -300,7 +300,7 @@ static void rtgui_filelist_view_menu_pop(rtgui_widget_t *parent)
 	if (menu != RT_NULL)
 	{
 		/* set user data on menu window */
-		menu->user_data = (rt_uint32_t)parent;
+		menu->user_data = (rt_ubase_t)parent;
 
 		rtgui_win_set_ondeactivate(menu, rtgui_filelist_view_on_menu_deactivate);
 
@@ -20,12 +20,16 @@
 #include <rtgui/widgets/container.h>
 #include <rtgui/widgets/notebook.h>
 
+volatile rt_uint32_t rtgui_widget_visible_serial = 0;
+
 static void _rtgui_widget_constructor(rtgui_widget_t *widget)
 {
    if (!widget) return;
 
 	/* set default flag */
 	widget->flag = RTGUI_WIDGET_FLAG_DEFAULT;
+	/* the visible of dc is not checked */
+	widget->visible_serial = rtgui_widget_visible_serial - 1;
 
 	/* init list */
 	rtgui_list_init(&(widget->sibling));
@@ -36,6 +40,7 @@ static void _rtgui_widget_constructor(rtgui_widget_t *widget)
 	widget->gc.font = rtgui_font_default();
 	widget->gc.textstyle = RTGUI_TEXTSTYLE_NORMAL;
 	widget->gc.textalign = RTGUI_ALIGN_LEFT | RTGUI_ALIGN_TOP;
+	widget->gc.map_color = RT_NULL;
 #ifndef RTGUI_USING_SMALL_SIZE
 	widget->align = RTGUI_ALIGN_LEFT | RTGUI_ALIGN_TOP;
 #endif
@@ -149,6 +154,7 @@ void rtgui_widget_set_parent(rtgui_widget_t* widget, rtgui_widget_t* parent)
 {
 	/* set parent and toplevel widget */
 	widget->parent = parent;
+	RTGUI_WIDGET_VISIBLE_CHANGED();
 
 	/* update children toplevel */
 	if (parent->toplevel != RT_NULL &&
@@ -551,6 +557,36 @@ void rtgui_widget_hide(rtgui_widget_t* widget)
 		widget->on_hide(RTGUI_OBJECT(widget), RT_NULL);
 }
 
+rt_bool_t rtgui_widget_check_dc_visible(rtgui_widget_t* widget)
+{
+	rtgui_widget_t* parent;
+	rt_uint32_t serial;
+
+	/*
+	 * the serial is read before the walk, a change during the walk leaves
+	 * the cached visible stale and it's checked again next time.
+	 */
+	serial = rtgui_widget_visible_serial;
+	if (widget->visible_serial != serial)
+	{
+		/* set init visible as true */
+		RTGUI_WIDGET_DC_SET_VISIBLE(widget);
+
+		for (parent = widget; parent != RT_NULL; parent = parent->parent)
+		{
+			if (RTGUI_WIDGET_IS_HIDE(parent))
+			{
+				RTGUI_WIDGET_DC_SET_UNVISIBLE(widget);
+				break;
+			}
+		}
+
+		widget->visible_serial = serial;
+	}
+
+	return RTGUI_WIDGET_IS_DC_VISIBLE(widget)? RT_TRUE : RT_FALSE;
+}
+
 rtgui_color_t rtgui_widget_get_parent_foreground(rtgui_widget_t* widget)
 {
 	rtgui_widget_t* parent;
@@ -0,0 +1,89 @@
+/*
+ * File      : host.h
+ * This file is part of RT-Thread RTOS
+ * COPYRIGHT (C) 2006 - 2012, RT-Thread Development Team
+ *
+ * The license and distribution terms for this file may be
+ * found in the file LICENSE in this distribution or at
+ * http://www.rt-thread.org/license/LICENSE
+ */
+#ifndef __HOST_H__
+#define __HOST_H__
+
+#include <rtthread.h>
+
+#include <errno.h>
+#include <pthread.h>
+#include <time.h>
+
+/* host side synchronization object shared by semaphore, mq and mailbox */
+struct host_cond
+{
+	pthread_mutex_t lock;
+	pthread_cond_t  cond;
+};
+
+rt_inline void host_cond_init(struct host_cond* hc)
+{
+	pthread_condattr_t attr;
+
+	pthread_mutex_init(&(hc->lock), NULL);
+
+	/* use monotonic clock, so a wall clock change won't wake up the waiter */
+	pthread_condattr_init(&attr);
+	pthread_condattr_setclock(&attr, CLOCK_MONOTONIC);
+	pthread_cond_init(&(hc->cond), &attr);
+	pthread_condattr_destroy(&attr);
+}
+
+rt_inline void host_cond_fini(struct host_cond* hc)
+{
+	pthread_cond_destroy(&(hc->cond));
+	pthread_mutex_destroy(&(hc->lock));
+}
+
+/* get the absolute time of (clock + tick), tick is in OS tick */
+rt_inline void host_abstime(clockid_t clock, struct timespec* ts, rt_int32_t tick)
+{
+	clock_gettime(clock, ts);
+
+	ts->tv_sec  += tick / RT_TICK_PER_SECOND;
+	ts->tv_nsec += (tick % RT_TICK_PER_SECOND) * (1000000000L / RT_TICK_PER_SECOND);
+	if (ts->tv_nsec >= 1000000000L)
+	{
+		ts->tv_sec  += 1;
+		ts->tv_nsec -= 1000000000L;
+	}
+}
+
+/*
+ * wait on the condition with the lock held until abstime, a RT_NULL abstime
+ * blocks until signaled.
+ *
+ * @return RT_EOK on signaled, -RT_ETIMEOUT on timeout.
+ */
+rt_inline rt_err_t host_cond_wait(struct host_cond* hc, const struct timespec* abstime)
+{
+	int r;
+
+	if (abstime == RT_NULL)
+		r = pthread_cond_wait(&(hc->cond), &(hc->lock));
+	else
+		r = pthread_cond_timedwait(&(hc->cond), &(hc->lock), abstime);
+
+	if (r == ETIMEDOUT) return -RT_ETIMEOUT;
+	if (r != 0) return -RT_ERROR;
+
+	return RT_EOK;
+}
+
+/* monotonic time in nanosecond */
+rt_inline unsigned long long host_time_ns(void)
+{
+	struct timespec ts;
+
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return (unsigned long long)ts.tv_sec * 1000000000ULL + ts.tv_nsec;
+}
+
+#endif
@@ -0,0 +1,293 @@
+#include <rtthread.h>
+
+#include <rtgui/rtgui_server.h>
+#include <rtgui/rtgui_system.h>
+#include <rtgui/driver.h>
+#include <rtgui/rtgui_recorder.h>
+#include <rtgui/rtgui_stats.h>
+#include <rtgui/rtgui_trace.h>
+
+#include "memfb.h"
+#include "host.h"
+
+#include <sched.h>
+#include <signal.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+extern int rt_application_init(void);
+extern void rt_mq_system_init(void);
+extern void rt_mb_system_init(void);
+extern void rt_thread_system_init(void);
+extern rt_thread_t rt_thread_find(char* name);
+
+static volatile sig_atomic_t done = 0;
+
+static void sig_handler(int signo)
+{
+	done = 1;
+}
+
+static const char *record_file = RT_NULL, *replay_file = RT_NULL, *trace_file = RT_NULL;
+static rt_bool_t replay_max_speed = RT_FALSE;
+static rt_bool_t dump_stats = RT_FALSE;
+
+#if defined(RTGUI_USING_RECORDER) || defined(RTGUI_USING_EVENT_TRACE)
+static rt_uint32_t host_clock_us(void)
+{
+	return (rt_uint32_t)(host_time_ns() / 1000);
+}
+#endif
+
+#ifdef RTGUI_USING_RECORDER
+static void replay_entry(void* parameter)
+{
+	struct rtgui_replay_stat stat;
+
+	if (rtgui_recorder_replay(replay_file, replay_max_speed, &stat) == RT_EOK)
+	{
+		rt_kprintf("replay %s: %u events, %u updated, latency(us) min %u p50 %u p90 %u p99 %u max %u\n",
+			replay_file, stat.events, stat.updated,
+			stat.min, stat.p50, stat.p90, stat.p99, stat.max);
+	}
+	else
+	{
+		rt_kprintf("replay %s failed\n", replay_file);
+	}
+
+	done = 1;
+}
+#endif
+
+static const struct
+{
+	const char* name;
+	int pixel_format;
+} _formats[] =
+{
+	{"mono",	RTGRAPHIC_PIXEL_FORMAT_MONO},
+	{"gray4",	RTGRAPHIC_PIXEL_FORMAT_GRAY4},
+	{"gray16",	RTGRAPHIC_PIXEL_FORMAT_GRAY16},
+	{"rgb565",	RTGRAPHIC_PIXEL_FORMAT_RGB565},
+	{"rgb565p",	RTGRAPHIC_PIXEL_FORMAT_RGB565P},
+	{"rgb888",	RTGRAPHIC_PIXEL_FORMAT_RGB888},
+	{"argb888",	RTGRAPHIC_PIXEL_FORMAT_ARGB888},
+};
+
+static void usage(const char* name)
+{
+	fprintf(stderr, "usage: %s [-f format] [-s WxH] [-O degree] [-p] [-a] [-B] [-A] [-F tick] [-b rate] [-d pattern] [-o frame] "
+		"[-l damage.csv] [-r input.rec | -R input.rec [-m]] [-S] [-t trace.json] [seconds]\n", name);
+	fprintf(stderr, "  -f  pixel format: mono, gray4, gray16, rgb565, rgb565p(default), rgb888, argb888\n");
+	fprintf(stderr, "  -s  screen size, default 240x320\n");
+	fprintf(stderr, "  -O  rotate the screen clockwise by 0(default), 90, 180 or 270 degree\n");
+	fprintf(stderr, "  -p  work as a pixel device instead of a framebuffer\n");
+	fprintf(stderr, "  -a  emulate a 2D accelerator of device\n");
+	fprintf(stderr, "  -B  draw in a shadow framebuffer and write the updates to device\n");
+	fprintf(stderr, "  -A  send the updates to device in a flush thread\n");
+	fprintf(stderr, "  -F  ticks between the screen updates, 0 updates on every drawing\n");
+	fprintf(stderr, "  -b  emulate the bus of panel in bytes per millisecond, e.g. 5000 for 40MHz SPI\n");
+	fprintf(stderr, "  -d  dump each updated frame, e.g. frame%%05d.png\n");
+	fprintf(stderr, "  -o  dump the last frame on exit, .ppm or .png\n");
+	fprintf(stderr, "  -l  write every rect update to a CSV file on exit\n");
+	fprintf(stderr, "  -r  record the input events to a file\n");
+	fprintf(stderr, "  -R  replay the input events and report the latency, then exit\n");
+	fprintf(stderr, "  -m  replay at max speed instead of the recorded time\n");
+	fprintf(stderr, "  -S  dump the statistics of rtgui on exit\n");
+	fprintf(stderr, "  -t  trace the events and write a Chrome trace file on exit\n");
+}
+
+/*
+ * without seconds the program runs until SIGINT/SIGTERM, so it can be
+ * driven under perf or valgrind.
+ */
+int main(int argc, char *argv[])
+{
+	rt_device_t device;
+	rt_thread_t server;
+	struct memfb_stat stat;
+	long seconds = 0;
+	int opt, index;
+	int pixel_format = RTGRAPHIC_PIXEL_FORMAT_RGB565P;
+	int width = 240, height = 320;
+	rt_bool_t pixel_device = RT_FALSE, accelerated = RT_FALSE;
+	rt_bool_t async_flush = RT_FALSE;
+	rt_uint32_t bus_rate = 0;
+	const char *dump_pattern = RT_NULL, *last_frame = RT_NULL, *damage_log = RT_NULL;
+
+	while ((opt = getopt(argc, argv, "f:s:O:paBAF:b:d:o:l:r:R:mSt:h")) != -1)
+	{
+		switch (opt)
+		{
+		case 'f':
+			for (index = 0; index < sizeof(_formats)/sizeof(_formats[0]); index ++)
+			{
+				if (strcmp(optarg, _formats[index].name) == 0) break;
+			}
+			if (index == sizeof(_formats)/sizeof(_formats[0]))
+			{
+				usage(argv[0]);
+				return 1;
+			}
+			pixel_format = _formats[index].pixel_format;
+			break;
+		case 's':
+			if (sscanf(optarg, "%dx%d", &width, &height) != 2)
+			{
+				usage(argv[0]);
+				return 1;
+			}
+			break;
+		case 'O':
+			if (rtgui_graphic_set_rotation(atoi(optarg)) != RT_EOK)
+			{
+				usage(argv[0]);
+				return 1;
+			}
+			break;
+		case 'p':
+			pixel_device = RT_TRUE;
+			break;
+		case 'a':
+			accelerated = RT_TRUE;
+			break;
+#ifdef RTGUI_USING_SHADOW_FRAMEBUFFER
+		case 'B':
+			rtgui_graphic_set_shadow(RT_TRUE);
+			break;
+#endif
+#ifdef RTGUI_USING_ASYNC_FLUSH
+		case 'A':
+			async_flush = RT_TRUE;
+			break;
+#endif
+		case 'F':
+			rtgui_server_set_frame_tick(atoi(optarg));
+			break;
+		case 'b':
+			bus_rate = atoi(optarg);
+			break;
+		case 'd':
+			dump_pattern = optarg;
+			break;
+		case 'o':
+			last_frame = optarg;
+			break;
+		case 'l':
+			damage_log = optarg;
+			break;
+		case 'r':
+			record_file = optarg;
+			break;
+		case 'R':
+			replay_file = optarg;
+			break;
+		case 'm':
+			replay_max_speed = RT_TRUE;
+			break;
+		case 'S':
+			dump_stats = RT_TRUE;
+			break;
+		case 't':
+			trace_file = optarg;
+			break;
+		default:
+			usage(argv[0]);
+			return 1;
+		}
+	}
+	if (optind < argc) seconds = atol(argv[optind]);
+
+	rt_kprintf("RTGUI headless host ....\n");
+
+	signal(SIGINT, sig_handler);
+	signal(SIGTERM, sig_handler);
+
+	/* init rtt system */
+	rt_mq_system_init();
+	rt_mb_system_init();
+	rt_thread_system_init();
+
+	/* init driver */
+	memfb_hw_init();
+	if (memfb_set_mode(pixel_format, width, height, pixel_device) != RT_EOK)
+	{
+		fprintf(stderr, "unsupported framebuffer mode\n");
+		return 1;
+	}
+	memfb_set_accelerated(accelerated);
+	memfb_set_bus_rate(bus_rate);
+	memfb_set_frame_dump(dump_pattern);
+	device = rt_device_find("fb");
+	rtgui_graphic_set_device(device);
+#ifdef RTGUI_USING_ASYNC_FLUSH
+	if (async_flush == RT_TRUE) rtgui_graphic_set_async_flush(RT_TRUE);
+#endif
+
+#ifdef RTGUI_USING_EVENT_TRACE
+	rtgui_trace_set_clock(host_clock_us);
+	if (trace_file != RT_NULL) rtgui_trace_start();
+#endif
+
+	/* init gui system */
+	rtgui_system_server_init();
+
+	/*
+	 * the server thread has the highest priority on target and registers
+	 * itself before any application runs, wait for it on host.
+	 */
+	server = rt_thread_find("rtgui");
+	while (server != RT_NULL && server->user_data == 0) sched_yield();
+
+#ifdef RTGUI_USING_RECORDER
+	rtgui_recorder_set_clock(host_clock_us);
+	if (record_file != RT_NULL && rtgui_recorder_start(record_file) != RT_EOK)
+		fprintf(stderr, "can't record to %s\n", record_file);
+#endif
+
+	/* initial user application */
+	rt_application_init();
+
+#ifdef RTGUI_USING_RECORDER
+	if (replay_file != RT_NULL)
+	{
+		rt_thread_t tid;
+
+		tid = rt_thread_create("replay", replay_entry, RT_NULL, 4096, 25, 10);
+		if (tid != RT_NULL) rt_thread_startup(tid);
+	}
+#endif
+
+	while (!done)
+	{
+		sleep(1);
+		if (seconds > 0 && --seconds == 0) break;
+	}
+
+#ifdef RTGUI_USING_RECORDER
+	rtgui_recorder_stop();
+#endif
+#ifdef RTGUI_USING_EVENT_TRACE
+	if (trace_file != RT_NULL)
+	{
+		rtgui_trace_stop();
+		if (rtgui_trace_export(trace_file) != RT_EOK)
+			fprintf(stderr, "can't write trace to %s\n", trace_file);
+	}
+#endif
+
+	memfb_get_stat(&stat);
+	rt_kprintf("screen update: %u, pixels: %llu, bytes: %llu, frames dumped: %u\n",
+		stat.updates, stat.pixels, stat.bytes, stat.frames);
+	if (pixel_device == RT_TRUE)
+		rt_kprintf("pixel device transfers: %u\n", stat.transfers);
+	if (damage_log != RT_NULL) memfb_dump_damage(damage_log);
+#ifdef RTGUI_USING_STATS
+	if (dump_stats == RT_TRUE) rtgui_stats_dump();
+#endif
+	if (last_frame != RT_NULL) memfb_dump_frame(last_frame);
+
+	return 0;
+}
@@ -0,0 +1,161 @@
+#include <rtthread.h>
+#include "list.h"
+#include "host.h"
+
+#include <stdlib.h>
+
+rt_list_t _mb_list;
+pthread_mutex_t _mb_list_mutex = PTHREAD_MUTEX_INITIALIZER;
+
+void rt_mb_system_init()
+{
+	rt_list_init(&_mb_list);
+}
+
+#define hmb ((struct host_cond*)(mb->host_mb))
+
+rt_err_t rt_mb_init(rt_mailbox_t mb, const char* name, void* msgpool, rt_size_t size, rt_uint8_t flag)
+{
+
+	RT_ASSERT(mb != RT_NULL);
+
+	mb->flag = flag;
+
+	rt_strncpy(mb->name, name, RT_NAME_MAX);
+
+	/* append to mq list */
+	pthread_mutex_lock(&_mb_list_mutex);
+	rt_list_insert_after(&(_mb_list), &(mb->list));
+	pthread_mutex_unlock(&_mb_list_mutex);
+
+	/* init mailbox */
+	mb->msg_pool	= msgpool;
+	mb->size 		= size;
+
+	mb->entry 	 	= 0;
+	mb->in_offset 	= 0;
+	mb->out_offset 	= 0;
+
+	/* init mutex */
+	mb->host_mb		= (void*) malloc(sizeof(struct host_cond));
+	host_cond_init(hmb);
+
+	return RT_EOK;
+}
+
+rt_err_t rt_mb_detach(rt_mailbox_t mb)
+{
+	/* parameter check */
+	RT_ASSERT(mb != RT_NULL);
+
+	host_cond_fini(hmb);
+
+	free(mb->host_mb);
+	mb->host_mb = NULL;
+
+	/* remove from list */
+	pthread_mutex_lock(&_mb_list_mutex);
+	rt_list_remove(&(mb->list));
+	pthread_mutex_unlock(&_mb_list_mutex);
+
+	return RT_EOK;
+}
+
+rt_mailbox_t rt_mb_create (const char* name, rt_size_t size, rt_uint8_t flag)
+{
+	rt_mailbox_t mb = (rt_mailbox_t) rt_malloc (sizeof(struct rt_mailbox));
+	mb->msg_pool = rt_malloc(size * sizeof(rt_uint32_t));
+	if (mb->msg_pool == RT_NULL)
+	{
+		rt_free(mb);
+		return RT_NULL;
+	}
+
+	rt_mb_init(mb, name, mb->msg_pool, size, flag);
+
+	return mb;
+}
+
+rt_err_t rt_mb_delete (rt_mailbox_t mb)
+{
+	rt_mb_detach(mb);
+
+	rt_free(mb);
+
+	return RT_EOK;
+}
+
+rt_err_t rt_mb_send (rt_mailbox_t mb, rt_uint32_t value)
+{
+	/* parameter check */
+	RT_ASSERT(mb != RT_NULL);
+
+	pthread_mutex_lock(&(hmb->lock));
+
+	/* mailbox is full */
+	if (mb->entry == mb->size)
+	{
+		pthread_mutex_unlock(&(hmb->lock));
+		return -RT_EFULL;
+	}
+
+	/* set ptr */
+	mb->msg_pool[mb->in_offset] = value;
+	/* increase input offset */
+	mb->in_offset = (mb->in_offset + 1) % mb->size;
+	/* increase message entry */
+	mb->entry ++;
+
+	/* wake up one receiver */
+	pthread_cond_signal(&(hmb->cond));
+	pthread_mutex_unlock(&(hmb->lock));
+
+	return RT_EOK;
+}
+
+rt_err_t rt_mb_recv (rt_mailbox_t mb, rt_uint32_t* value, rt_int32_t timeout)
+{
+	rt_err_t r;
+	struct timespec abstime;
+
+	/* parameter check */
+	RT_ASSERT(mb != RT_NULL);
+
+	if (timeout > 0) host_abstime(CLOCK_MONOTONIC, &abstime, timeout);
+
+	pthread_mutex_lock(&(hmb->lock));
+
+	/* mailbox is empty */
+	while (mb->entry == 0)
+	{
+		if (timeout == 0)
+		{
+			pthread_mutex_unlock(&(hmb->lock));
+			return -RT_ETIMEOUT;
+		}
+
+		r = host_cond_wait(hmb, timeout < 0? RT_NULL : &abstime);
+		if (r != RT_EOK)
+		{
+			pthread_mutex_unlock(&(hmb->lock));
+			return r;
+		}
+	}
+
+	/* fill ptr */
+	*value = mb->msg_pool[mb->out_offset];
+
+	/* increase output offset */
+	mb->out_offset = (mb->out_offset + 1) % mb->size;
+	/* decrease message entry */
+	mb->entry --;
+
+	pthread_mutex_unlock(&(hmb->lock));
+
+	return RT_EOK;
+}
+
+rt_err_t rt_mb_control(rt_mailbox_t mb, rt_uint8_t cmd, void* arg)
+{
+	return RT_EOK;
+}
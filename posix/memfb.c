@@ -0,0 +1,595 @@
+/*
+ * File      : memfb.c
+ * This file is part of RT-Thread RTOS
+ * COPYRIGHT (C) 2006 - 2012, RT-Thread Development Team
+ *
+ * The license and distribution terms for this file may be
+ * found in the file LICENSE in this distribution or at
+ * http://www.rt-thread.org/license/LICENSE
+ */
+#include <rtthread.h>
+#include <rtgui/color.h>
+#include <rtgui/driver.h>
+#include "memfb.h"
+#include "host.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#ifdef RTGUI_IMAGE_PNG
+#include "zlib.h"
+#endif
+
+#define MEMFB_SCREEN_WIDTH	240
+#define MEMFB_SCREEN_HEIGHT	320
+
+/* the damage log grows in this step */
+#define MEMFB_DAMAGE_STEP	1024
+
+struct memfb_device
+{
+	struct rt_device parent;
+	struct rt_device_graphic_ops ops;
+
+	rt_uint8_t pixel_format;
+	rt_uint8_t bits_per_pixel;
+	rt_uint16_t pitch;
+	rt_uint16_t width;
+	rt_uint16_t height;
+	rt_bool_t pixel_device;
+	rt_bool_t accelerated;
+	/* bytes per millisecond of the bus to panel, 0 for no delay */
+	rt_uint32_t bus_rate;
+
+	/*
+	 * the memory of pixels. For mono format, each page is 8 lines in one byte
+	 * per column and the pitch is the width.
+	 */
+	rt_uint8_t *framebuffer;
+	rt_uint8_t *pixels;
+
+	/* damage accounting */
+	pthread_mutex_t lock;
+	unsigned long long start;
+	struct memfb_damage *damage;
+	rt_uint32_t damage_count, damage_size;
+	struct memfb_stat stat;
+
+	char* dump_pattern;
+};
+static struct memfb_device _device;
+
+/* bits per pixel of the supported formats, 0 for unsupported */
+static rt_uint8_t memfb_format_bpp(int pixel_format, rt_bool_t pixel_device)
+{
+	switch (pixel_format)
+	{
+	case RTGRAPHIC_PIXEL_FORMAT_MONO:
+		/* pixel device has no mono ops */
+		return pixel_device? 0 : 1;
+	case RTGRAPHIC_PIXEL_FORMAT_RGB565:
+	case RTGRAPHIC_PIXEL_FORMAT_RGB565P:
+		return 16;
+	case RTGRAPHIC_PIXEL_FORMAT_RGB888:
+		/* the pixel device takes a 32 bits 0x00RRGGBB */
+		return pixel_device? 32 : 24;
+	case RTGRAPHIC_PIXEL_FORMAT_ARGB888:
+		return pixel_device? 0 : 32;
+	case RTGRAPHIC_PIXEL_FORMAT_GRAY4:
+		return pixel_device? 0 : 2;
+	case RTGRAPHIC_PIXEL_FORMAT_GRAY16:
+		return pixel_device? 0 : 4;
+	}
+
+	return 0;
+}
+
+static rt_err_t memfb_alloc(struct memfb_device *device, rt_uint16_t width, rt_uint16_t height)
+{
+	rt_uint8_t *pixels;
+	rt_uint16_t pitch, lines;
+
+	if (device->pixel_format == RTGRAPHIC_PIXEL_FORMAT_MONO)
+	{
+		pitch = width;
+		lines = (height + 7) / 8;
+	}
+	else
+	{
+		pitch = (width * device->bits_per_pixel + 7)/8;
+		lines = height;
+	}
+
+	pixels = (rt_uint8_t*) calloc(lines, pitch);
+	if (pixels == RT_NULL) return -RT_ERROR;
+
+	free(device->framebuffer);
+	device->framebuffer = pixels;
+	device->pixels = pixels;
+	device->width = width;
+	device->height = height;
+	device->pitch = pitch;
+
+	return RT_EOK;
+}
+
+/* get the pixel at (x, y) in RGB888 */
+static void memfb_get_rgb(struct memfb_device *device, int x, int y, rt_uint8_t *rgb)
+{
+	rtgui_color_t color;
+	rt_uint8_t *ptr;
+
+	if (device->pixel_format == RTGRAPHIC_PIXEL_FORMAT_MONO)
+	{
+		ptr = device->pixels + (y / 8) * device->width + x;
+		color = (*ptr & (1 << (y % 8)))? black : white;
+	}
+	else if (device->bits_per_pixel < 8)
+	{
+		int ppb, level;
+
+		/* the gray pixels are packed, the left one is in the high bits */
+		ppb = 8 / device->bits_per_pixel;
+		ptr = device->pixels + y * device->pitch + x / ppb;
+		level = (*ptr >> ((ppb - 1 - x % ppb) * device->bits_per_pixel)) & ((1 << device->bits_per_pixel) - 1);
+		color = rtgui_color_from_gray(level * 255 / ((1 << device->bits_per_pixel) - 1));
+	}
+	else
+	{
+		ptr = device->pixels + y * device->pitch + x * device->bits_per_pixel/8;
+		switch (device->pixel_format)
+		{
+		case RTGRAPHIC_PIXEL_FORMAT_RGB565:
+			color = rtgui_color_from_565(*(rt_uint16_t*)ptr);
+			break;
+		case RTGRAPHIC_PIXEL_FORMAT_RGB565P:
+			color = rtgui_color_from_565p(*(rt_uint16_t*)ptr);
+			break;
+		case RTGRAPHIC_PIXEL_FORMAT_RGB888:
+			/* the framebuffer is in the byte order of rtgui_color_t */
+			if (device->pixel_device == RT_TRUE)
+				color = rtgui_color_from_888(*(rt_uint32_t*)ptr);
+			else
+				color = RTGUI_RGB(ptr[0], ptr[1], ptr[2]);
+			break;
+		default:
+			color = *(rtgui_color_t*)ptr;
+			break;
+		}
+	}
+
+	rgb[0] = RTGUI_RGB_R(color);
+	rgb[1] = RTGUI_RGB_G(color);
+	rgb[2] = RTGUI_RGB_B(color);
+}
+
+static rt_err_t memfb_write_ppm(struct memfb_device *device, FILE *fp)
+{
+	int x, y;
+	rt_uint8_t rgb[3];
+
+	fprintf(fp, "P6\n%d %d\n255\n", device->width, device->height);
+	for (y = 0; y < device->height; y ++)
+	{
+		for (x = 0; x < device->width; x ++)
+		{
+			memfb_get_rgb(device, x, y, rgb);
+			fwrite(rgb, 1, 3, fp);
+		}
+	}
+
+	return ferror(fp)? -RT_ERROR : RT_EOK;
+}
+
+#ifdef RTGUI_IMAGE_PNG
+static void memfb_put_u32(rt_uint8_t *ptr, rt_uint32_t value)
+{
+	ptr[0] = value >> 24; ptr[1] = value >> 16;
+	ptr[2] = value >> 8;  ptr[3] = value;
+}
+
+static void memfb_write_chunk(FILE *fp, const char *type, const rt_uint8_t *data, rt_uint32_t length)
+{
+	rt_uint8_t buf[4];
+	uLong crc;
+
+	memfb_put_u32(buf, length);
+	fwrite(buf, 1, 4, fp);
+	fwrite(type, 1, 4, fp);
+	if (length) fwrite(data, 1, length, fp);
+
+	crc = crc32(0, (const Bytef*)type, 4);
+	if (length) crc = crc32(crc, data, length);
+	memfb_put_u32(buf, crc);
+	fwrite(buf, 1, 4, fp);
+}
+
+/* the libpng in tree is built without write support, so encode it here */
+static rt_err_t memfb_write_png(struct memfb_device *device, FILE *fp)
+{
+	static const rt_uint8_t signature[8] = {0x89, 'P', 'N', 'G', '\r', '\n', 0x1a, '\n'};
+	rt_uint8_t ihdr[13];
+	rt_uint8_t *raw, *ptr;
+	Bytef *data;
+	uLongf data_size;
+	uLong raw_size;
+	int x, y;
+
+	raw_size = (device->width * 3 + 1) * device->height;
+	raw = (rt_uint8_t*) malloc(raw_size);
+	data_size = compressBound(raw_size);
+	data = (Bytef*) malloc(data_size);
+	if (raw == RT_NULL || data == RT_NULL)
+	{
+		free(raw); free(data);
+		return -RT_ERROR;
+	}
+
+	/* each line starts with filter type none */
+	ptr = raw;
+	for (y = 0; y < device->height; y ++)
+	{
+		*ptr ++ = 0;
+		for (x = 0; x < device->width; x ++, ptr += 3)
+			memfb_get_rgb(device, x, y, ptr);
+	}
+
+	if (compress2(data, &data_size, raw, raw_size, Z_BEST_SPEED) != Z_OK)
+	{
+		free(raw); free(data);
+		return -RT_ERROR;
+	}
+
+	/* 8 bits RGB, no interlace */
+	memfb_put_u32(ihdr, device->width);
+	memfb_put_u32(ihdr + 4, device->height);
+	ihdr[8] = 8; ihdr[9] = 2; ihdr[10] = 0; ihdr[11] = 0; ihdr[12] = 0;
+
+	fwrite(signature, 1, sizeof(signature), fp);
+	memfb_write_chunk(fp, "IHDR", ihdr, sizeof(ihdr));
+	memfb_write_chunk(fp, "IDAT", data, data_size);
+	memfb_write_chunk(fp, "IEND", RT_NULL, 0);
+
+	free(raw); free(data);
+	return ferror(fp)? -RT_ERROR : RT_EOK;
+}
+#endif
+
+static rt_err_t memfb_write_frame(struct memfb_device *device, const char* filename)
+{
+	FILE *fp;
+	rt_err_t result;
+	const char *ext;
+
+	fp = fopen(filename, "wb");
+	if (fp == RT_NULL) return -RT_ERROR;
+
+	ext = strrchr(filename, '.');
+#ifdef RTGUI_IMAGE_PNG
+	if (ext != RT_NULL && strcasecmp(ext, ".png") == 0)
+		result = memfb_write_png(device, fp);
+	else
+#endif
+		result = memfb_write_ppm(device, fp);
+
+	fclose(fp);
+	return result;
+}
+
+static void memfb_rect_update(struct memfb_device *device, struct rt_device_rect_info *rect)
+{
+	struct memfb_damage *damage;
+	rt_uint32_t bytes;
+
+	/* a mono panel is written in pages */
+	if (device->pixel_format == RTGRAPHIC_PIXEL_FORMAT_MONO)
+		bytes = rect->width * ((rect->y + rect->height + 7) / 8 - rect->y / 8);
+	else
+		bytes = rect->height * (((rect->x + rect->width) * device->bits_per_pixel + 7) / 8 -
+			rect->x * device->bits_per_pixel / 8);
+
+	pthread_mutex_lock(&(device->lock));
+	if (device->damage_count == device->damage_size)
+	{
+		damage = (struct memfb_damage*) realloc(device->damage,
+			(device->damage_size + MEMFB_DAMAGE_STEP) * sizeof(struct memfb_damage));
+		if (damage != RT_NULL)
+		{
+			device->damage = damage;
+			device->damage_size += MEMFB_DAMAGE_STEP;
+		}
+	}
+
+	if (device->damage_count < device->damage_size)
+	{
+		damage = &(device->damage[device->damage_count ++]);
+		damage->timestamp = (rt_uint32_t)((host_time_ns() - device->start) / 1000);
+		damage->x = rect->x;
+		damage->y = rect->y;
+		damage->width = rect->width;
+		damage->height = rect->height;
+		damage->bytes = bytes;
+	}
+
+	device->stat.updates ++;
+	device->stat.pixels += rect->width * rect->height;
+	device->stat.bytes += bytes;
+
+	if (device->dump_pattern != RT_NULL)
+	{
+		char filename[256];
+
+		rt_snprintf(filename, sizeof(filename), device->dump_pattern, device->stat.frames);
+		if (memfb_write_frame(device, filename) == RT_EOK)
+			device->stat.frames ++;
+	}
+	pthread_mutex_unlock(&(device->lock));
+
+	/* the caller waits for the transfer to panel */
+	if (device->bus_rate != 0)
+	{
+		struct timespec delay;
+		unsigned long long ns;
+
+		ns = (unsigned long long)bytes * 1000000ULL / device->bus_rate;
+		delay.tv_sec = ns / 1000000000ULL;
+		delay.tv_nsec = ns % 1000000000ULL;
+		nanosleep(&delay, RT_NULL);
+	}
+}
+
+/* pixel device interface, the transfers are counted as the drawing threads race */
+#define MEMFB_PIXEL(x, y)	(_device.pixels + (y) * _device.pitch + (x) * (_device.bits_per_pixel/8))
+#define MEMFB_TRANSFER()	__sync_fetch_and_add(&(_device.stat.transfers), 1)
+
+static void memfb_set_pixel(const char* pixel, int x, int y)
+{
+	MEMFB_TRANSFER();
+	memcpy(MEMFB_PIXEL(x, y), pixel, _device.bits_per_pixel/8);
+}
+
+static void memfb_get_pixel(char* pixel, int x, int y)
+{
+	MEMFB_TRANSFER();
+	memcpy(pixel, MEMFB_PIXEL(x, y), _device.bits_per_pixel/8);
+}
+
+static void memfb_draw_hline(const char* pixel, int x1, int x2, int y)
+{
+	MEMFB_TRANSFER();
+	for (; x1 < x2; x1 ++)
+		memcpy(MEMFB_PIXEL(x1, y), pixel, _device.bits_per_pixel/8);
+}
+
+static void memfb_draw_vline(const char* pixel, int x, int y1, int y2)
+{
+	MEMFB_TRANSFER();
+	for (; y1 < y2; y1 ++)
+		memcpy(MEMFB_PIXEL(x, y1), pixel, _device.bits_per_pixel/8);
+}
+
+static void memfb_blit_line(const char* pixel, int x, int y, rt_size_t size)
+{
+	MEMFB_TRANSFER();
+	memcpy(MEMFB_PIXEL(x, y), pixel, size * (_device.bits_per_pixel/8));
+}
+
+/* 2D accelerator, which works on the pixels in byte */
+static void memfb_fill_rect(const char* pixel, struct rt_device_rect_info* rect)
+{
+	int x, y;
+
+	MEMFB_TRANSFER();
+	for (y = rect->y; y < rect->y + rect->height; y ++)
+		for (x = rect->x; x < rect->x + rect->width; x ++)
+			memcpy(MEMFB_PIXEL(x, y), pixel, _device.bits_per_pixel/8);
+}
+
+static void memfb_blit_rect(const char* pixels, int pitch, struct rt_device_rect_info* rect)
+{
+	int y;
+
+	MEMFB_TRANSFER();
+	for (y = rect->y; y < rect->y + rect->height; y ++, pixels += pitch)
+		memcpy(MEMFB_PIXEL(rect->x, y), pixels, rect->width * (_device.bits_per_pixel/8));
+}
+
+static void memfb_copy_area(struct rt_device_rect_info* rect, int x, int y)
+{
+	int line;
+
+	MEMFB_TRANSFER();
+	/* copy from the bottom line when the area is moved down */
+	if (y > rect->y)
+	{
+		for (line = rect->height - 1; line >= 0; line --)
+			memmove(MEMFB_PIXEL(x, y + line), MEMFB_PIXEL(rect->x, rect->y + line),
+				rect->width * (_device.bits_per_pixel/8));
+	}
+	else
+	{
+		for (line = 0; line < rect->height; line ++)
+			memmove(MEMFB_PIXEL(x, y + line), MEMFB_PIXEL(rect->x, rect->y + line),
+				rect->width * (_device.bits_per_pixel/8));
+	}
+}
+
+static const struct rtgui_graphic_ext_ops _memfb_ext_ops =
+{
+	memfb_fill_rect,
+	memfb_blit_rect,
+	memfb_copy_area,
+};
+
+/* common device interface */
+static rt_err_t memfb_init(rt_device_t dev)
+{
+	return RT_EOK;
+}
+static rt_err_t memfb_open(rt_device_t dev, rt_uint16_t oflag)
+{
+	return RT_EOK;
+}
+static rt_err_t memfb_close(rt_device_t dev)
+{
+	return RT_EOK;
+}
+static rt_err_t memfb_control(rt_device_t dev, rt_uint8_t cmd, void *args)
+{
+	struct memfb_device *device;
+
+	device = (struct memfb_device*)dev;
+	RT_ASSERT(device != RT_NULL);
+	RT_ASSERT(device->framebuffer != RT_NULL);
+
+	switch (cmd)
+	{
+	case RTGRAPHIC_CTRL_GET_INFO:
+		{
+		struct rt_device_graphic_info *info;
+
+		info = (struct rt_device_graphic_info*) args;
+		info->bits_per_pixel = device->bits_per_pixel;
+		info->pixel_format = device->pixel_format;
+		info->framebuffer = device->pixel_device? RT_NULL : device->framebuffer;
+		info->width = device->width;
+		info->height = device->height;
+		}
+		break;
+	case RTGRAPHIC_CTRL_RECT_UPDATE:
+		memfb_rect_update(device, (struct rt_device_rect_info*)args);
+		break;
+	case RTGRAPHIC_CTRL_SET_MODE:
+		{
+		struct rt_device_rect_info* rect;
+
+		rect = (struct rt_device_rect_info*)args;
+		if ((device->width == rect->width) && (device->height == rect->height)) break;
+
+		return memfb_alloc(device, rect->width, rect->height);
+		}
+	case RTGRAPHIC_CTRL_GET_EXT:
+		/* the packed pixels are not supported by the accelerator */
+		if (device->accelerated == RT_FALSE || device->bits_per_pixel < 8) return -RT_ERROR;
+
+		*(const struct rtgui_graphic_ext_ops**)args = &_memfb_ext_ops;
+		break;
+	}
+
+	return RT_EOK;
+}
+
+rt_err_t memfb_set_mode(int pixel_format, rt_uint16_t width, rt_uint16_t height,
+	rt_bool_t pixel_device)
+{
+	rt_uint8_t bits_per_pixel;
+
+	bits_per_pixel = memfb_format_bpp(pixel_format, pixel_device);
+	if (bits_per_pixel == 0 || width == 0 || height == 0) return -RT_ERROR;
+
+	_device.pixel_format = pixel_format;
+	_device.bits_per_pixel = bits_per_pixel;
+	_device.pixel_device = pixel_device;
+
+	/* re-allocate pixels even the size is same, the format is changed */
+	return memfb_alloc(&_device, width, height);
+}
+
+void memfb_set_accelerated(rt_bool_t accelerated)
+{
+	_device.accelerated = accelerated;
+}
+
+void memfb_set_bus_rate(rt_uint32_t rate)
+{
+	_device.bus_rate = rate;
+}
+
+void memfb_set_frame_dump(const char* pattern)
+{
+	pthread_mutex_lock(&(_device.lock));
+	free(_device.dump_pattern);
+	_device.dump_pattern = pattern != RT_NULL? strdup(pattern) : RT_NULL;
+	pthread_mutex_unlock(&(_device.lock));
+}
+
+rt_err_t memfb_dump_frame(const char* filename)
+{
+	rt_err_t result;
+
+	pthread_mutex_lock(&(_device.lock));
+	result = memfb_write_frame(&_device, filename);
+	pthread_mutex_unlock(&(_device.lock));
+
+	return result;
+}
+
+void memfb_get_stat(struct memfb_stat* stat)
+{
+	pthread_mutex_lock(&(_device.lock));
+	*stat = _device.stat;
+	pthread_mutex_unlock(&(_device.lock));
+}
+
+void memfb_reset_stat(void)
+{
+	pthread_mutex_lock(&(_device.lock));
+	memset(&(_device.stat), 0, sizeof(_device.stat));
+	_device.damage_count = 0;
+	_device.start = host_time_ns();
+	pthread_mutex_unlock(&(_device.lock));
+}
+
+rt_err_t memfb_dump_damage(const char* filename)
+{
+	FILE *fp;
+	rt_uint32_t index;
+	struct memfb_damage *damage;
+
+	fp = fopen(filename, "w");
+	if (fp == RT_NULL) return -RT_ERROR;
+
+	pthread_mutex_lock(&(_device.lock));
+	fprintf(fp, "time_us,x,y,width,height,bytes\n");
+	for (index = 0; index < _device.damage_count; index ++)
+	{
+		damage = &(_device.damage[index]);
+		fprintf(fp, "%u,%d,%d,%d,%d,%u\n", damage->timestamp,
+			damage->x, damage->y, damage->width, damage->height, damage->bytes);
+	}
+	pthread_mutex_unlock(&(_device.lock));
+
+	fclose(fp);
+	return RT_EOK;
+}
+
+void memfb_hw_init(void)
+{
+	_device.parent.init = memfb_init;
+	_device.parent.open = memfb_open;
+	_device.parent.close = memfb_close;
+	_device.parent.read = RT_NULL;
+	_device.parent.write = RT_NULL;
+	_device.parent.control = memfb_control;
+	_device.parent.user_data = &(_device.ops);
+
+	_device.ops.set_pixel = memfb_set_pixel;
+	_device.ops.get_pixel = memfb_get_pixel;
+	_device.ops.draw_hline = memfb_draw_hline;
+	_device.ops.draw_vline = memfb_draw_vline;
+	_device.ops.blit_line = memfb_blit_line;
+
+	pthread_mutex_init(&(_device.lock), NULL);
+	_device.start = host_time_ns();
+
+	if (memfb_set_mode(RTGRAPHIC_PIXEL_FORMAT_RGB565P, MEMFB_SCREEN_WIDTH,
+		MEMFB_SCREEN_HEIGHT, RT_FALSE) != RT_EOK)
+	{
+		fprintf(stderr, "Couldn't allocate framebuffer\n");
+		exit(1);
+	}
+
+	rt_device_register(&(_device.parent), "fb", RT_DEVICE_FLAG_RDWR);
+}
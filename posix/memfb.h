@@ -0,0 +1,66 @@
+/*
+ * File      : memfb.h
+ * This file is part of RT-Thread RTOS
+ * COPYRIGHT (C) 2006 - 2012, RT-Thread Development Team
+ *
+ * The license and distribution terms for this file may be
+ * found in the file LICENSE in this distribution or at
+ * http://www.rt-thread.org/license/LICENSE
+ */
+#ifndef __MEMFB_H__
+#define __MEMFB_H__
+
+#include <rtthread.h>
+
+/* one RTGRAPHIC_CTRL_RECT_UPDATE request */
+struct memfb_damage
+{
+	rt_uint32_t timestamp;		/* microseconds since memfb_hw_init */
+	rt_uint16_t x, y;
+	rt_uint16_t width, height;
+	rt_uint32_t bytes;			/* bytes pushed to the panel */
+};
+
+struct memfb_stat
+{
+	rt_uint32_t updates;		/* number of rect update */
+	rt_uint32_t frames;			/* number of frame dumped */
+	rt_uint32_t transfers;		/* operations of pixel device, each is a bus transaction */
+	unsigned long long pixels;	/* total updated pixels */
+	unsigned long long bytes;	/* total bytes pushed to the panel */
+};
+
+/* initialize memory framebuffer device, which is registered as "fb" */
+void memfb_hw_init(void);
+
+/*
+ * set the pixel format and the size of device, it must be invoked before
+ * rtgui_graphic_set_device. When pixel_device is true, the device doesn't
+ * expose framebuffer and works through rt_device_graphic_ops.
+ */
+rt_err_t memfb_set_mode(int pixel_format, rt_uint16_t width, rt_uint16_t height,
+	rt_bool_t pixel_device);
+
+/*
+ * expose a 2D accelerator by RTGRAPHIC_CTRL_GET_EXT, which fills, blits and
+ * copies rect in the memory. It must be invoked before rtgui_graphic_set_device.
+ */
+void memfb_set_accelerated(rt_bool_t accelerated);
+
+/*
+ * emulate the bus to panel (SPI or 8080), the rect update waits for the bytes
+ * in rate of bytes per millisecond. 0 returns at once.
+ */
+void memfb_set_bus_rate(rt_uint32_t rate);
+
+/* dump each updated frame to a file, the pattern has one %d for frame number */
+void memfb_set_frame_dump(const char* pattern);
+/* dump current frame to a .ppm or .png file */
+rt_err_t memfb_dump_frame(const char* filename);
+
+void memfb_get_stat(struct memfb_stat* stat);
+void memfb_reset_stat(void);
+/* write the damage log in CSV format */
+rt_err_t memfb_dump_damage(const char* filename);
+
+#endif
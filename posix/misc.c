@@ -0,0 +1,98 @@
+#include <rtthread.h>
+#include "host.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdarg.h>
+#include <string.h>
+
+void rt_kprintf(const char* fmt, ...)
+{
+	va_list args;
+
+	va_start(args, fmt);
+	vfprintf(stdout, fmt, args);
+	va_end(args);
+}
+
+void* rt_memset(void *src, int c, rt_ubase_t n)
+{
+	return memset(src, c, n);
+}
+
+void* rt_memcpy(void *dst, const void *src, rt_ubase_t n)
+{
+ 	return memcpy(dst, src, n);
+}
+
+int rt_memcmp(const void *dst, const void *src, rt_ubase_t n)
+{
+	return memcmp(dst, src, n);
+}
+
+void* rt_memmove(void *dst, const void *src, rt_ubase_t count)
+{
+	return memmove(dst, src, count);
+}
+
+rt_ubase_t rt_strncmp(const char * cs, const char * ct, rt_ubase_t count)
+{
+	return strncmp(cs, ct, count);
+}
+
+rt_ubase_t rt_strlen (const char *src)
+{
+	return strlen(src);
+}
+
+char* rt_strncpy(char *dest, const char *src, rt_ubase_t n)
+{
+	char *dscan;
+	const char *sscan;
+
+	dscan = dest;
+	sscan = src;
+	while (n > 0)
+    {
+		--n;
+		if ((*dscan++ = *sscan++) == '\0') break;
+	}
+
+	while (n-- > 0) *dscan++ = '\0';
+
+	return dest;
+}
+
+void* rt_malloc(rt_size_t nbytes)
+{
+	return malloc(nbytes);
+}
+
+void* rt_realloc(void *ptr, rt_size_t size)
+{
+	return realloc(ptr, size);
+}
+
+void rt_free (void *ptr)
+{
+	free(ptr);
+}
+
+char* rt_strdup(const char* str)
+{
+	return strdup(str);
+}
+
+rt_tick_t rt_tick_get(void)
+{
+	return (rt_tick_t)(host_time_ns() / (1000000000ULL / RT_TICK_PER_SECOND));
+}
+
+void rt_assert(const char* str, int line)
+{
+	rt_kprintf("assert: %s:%d\n", str, line);
+	fflush(stdout);
+
+	/* abort so the debugger or valgrind can catch it */
+	abort();
+}
@@ -0,0 +1,312 @@
+#include <rtthread.h>
+#include "list.h"
+#include "host.h"
+
+#include <stdlib.h>
+
+rt_list_t _mq_list;
+pthread_mutex_t _mq_list_mutex = PTHREAD_MUTEX_INITIALIZER;
+
+void rt_mq_system_init()
+{
+	rt_list_init(&_mq_list);
+}
+
+#define hmq ((struct host_cond*)(mq->host_mq))
+
+struct rt_mq_message
+{
+	struct rt_mq_message* next;
+};
+
+rt_err_t rt_mq_init(rt_mq_t mq, const char* name, void *msgpool, rt_size_t msg_size, rt_size_t pool_size, rt_uint8_t flag)
+{
+	size_t index;
+	struct rt_mq_message* head;
+
+	/* parameter check */
+	RT_ASSERT(mq != RT_NULL);
+
+	/* set parent flag */
+	mq->flag = flag;
+
+	rt_strncpy(mq->name, name, RT_NAME_MAX);
+
+	/* append to mq list */
+	pthread_mutex_lock(&_mq_list_mutex);
+	rt_list_insert_after(&(_mq_list), &(mq->list));
+	pthread_mutex_unlock(&_mq_list_mutex);
+
+	/* set message pool */
+	mq->msg_pool 	= msgpool;
+
+	/* get correct message size */
+	mq->msg_size	= RT_ALIGN(msg_size,  RT_ALIGN_SIZE);
+	mq->max_msgs	= pool_size / (mq->msg_size + sizeof(struct rt_mq_message));
+
+	/* init message list */
+	mq->msg_queue_head = RT_NULL;
+	mq->msg_queue_tail = RT_NULL;
+
+	/* init message empty list */
+	mq->msg_queue_free = RT_NULL;
+
+	for (index = 0; index < mq->max_msgs; index ++)
+	{
+		head = (struct rt_mq_message*)((rt_uint8_t*)mq->msg_pool +
+			index * (mq->msg_size + sizeof(struct rt_mq_message)));
+		head->next = mq->msg_queue_free;
+		mq->msg_queue_free = head;
+	}
+
+	/* the initial entry is zero */
+	mq->entry		= 0;
+
+	/* init mutex */
+	mq->host_mq		= (void*) malloc(sizeof(struct host_cond));
+	host_cond_init(hmq);
+
+	return RT_EOK;
+}
+
+rt_err_t rt_mq_detach(rt_mq_t mq)
+{
+	/* parameter check */
+	RT_ASSERT(mq != RT_NULL);
+
+	host_cond_fini(hmq);
+
+	free(mq->host_mq);
+	mq->host_mq = NULL;
+
+	/* remove from list */
+	pthread_mutex_lock(&_mq_list_mutex);
+	rt_list_remove(&(mq->list));
+	pthread_mutex_unlock(&_mq_list_mutex);
+
+	return RT_EOK;
+}
+
+rt_mq_t rt_mq_create (const char* name, rt_size_t msg_size, rt_size_t max_msgs, rt_uint8_t flag)
+{
+	size_t index;
+	struct rt_messagequeue* mq;
+	struct rt_mq_message* head;
+
+	/* allocate object */
+	mq = (rt_mq_t) rt_malloc(sizeof(struct rt_messagequeue));
+	if (mq == RT_NULL) return mq;
+
+	/* set flag */
+	mq->flag = flag;
+
+	rt_strncpy(mq->name, name, RT_NAME_MAX);
+
+	/* append to mq list */
+	pthread_mutex_lock(&_mq_list_mutex);
+	rt_list_insert_after(&(_mq_list), &(mq->list));
+	pthread_mutex_unlock(&_mq_list_mutex);
+
+	/* init message queue */
+
+	/* get correct message size */
+	mq->msg_size	= RT_ALIGN(msg_size, RT_ALIGN_SIZE);
+	mq->max_msgs	= max_msgs;
+
+	/* allocate message pool */
+	mq->msg_pool = rt_malloc((mq->msg_size + sizeof(struct rt_mq_message))* mq->max_msgs);
+	if (mq->msg_pool == RT_NULL)
+	{
+		rt_mq_delete(mq);
+		return RT_NULL;
+	}
+
+	/* init message list */
+	mq->msg_queue_head = RT_NULL;
+	mq->msg_queue_tail = RT_NULL;
+
+	/* init message empty list */
+	mq->msg_queue_free = RT_NULL;
+
+	for (index = 0; index < mq->max_msgs; index ++)
+	{
+		head = (struct rt_mq_message*)((rt_uint8_t*)mq->msg_pool +
+			index * (mq->msg_size + sizeof(struct rt_mq_message)));
+		head->next = mq->msg_queue_free;
+		mq->msg_queue_free = head;
+	}
+
+	/* the initial entry is zero */
+	mq->entry		= 0;
+
+	/* init mutex */
+	mq->host_mq		= (void*) malloc(sizeof(struct host_cond));
+	host_cond_init(hmq);
+
+	return mq;
+}
+
+rt_err_t rt_mq_delete (rt_mq_t mq)
+{
+	/* parameter check */
+	RT_ASSERT(mq != RT_NULL);
+
+	rt_mq_detach(mq);
+
+	/* free mailbox pool */
+	rt_free(mq->msg_pool);
+
+	/* delete mailbox object */
+	rt_free(mq);
+
+	return RT_EOK;
+}
+
+rt_err_t rt_mq_send (rt_mq_t mq, void* buffer, rt_size_t size)
+{
+	struct rt_mq_message *msg;
+
+	/* greater than one message size */
+	if (size > mq->msg_size) return -RT_ERROR;
+
+	pthread_mutex_lock(&(hmq->lock));
+
+	/* get a free list, there must be an empty item */
+	msg = (struct rt_mq_message*)mq->msg_queue_free;
+
+	/* message queue is full */
+	if (msg == RT_NULL)
+	{
+		pthread_mutex_unlock(&(hmq->lock));
+		return -RT_EFULL;
+	}
+
+	/* move free list pointer */
+	mq->msg_queue_free = msg->next;
+
+	/* copy buffer */
+	rt_memcpy(msg + 1, buffer, size);
+
+	/* link msg to message queue */
+	if (mq->msg_queue_tail != RT_NULL)
+	{
+		/* if the tail exists, */
+		((struct rt_mq_message*)mq->msg_queue_tail)->next = msg;
+	}
+	/* the msg is the new tail of list, the next shall be NULL */
+	msg->next = RT_NULL;
+
+	/* set new tail */
+	mq->msg_queue_tail = msg;
+
+	/* if the head is empty, set head */
+	if (mq->msg_queue_head == RT_NULL)mq->msg_queue_head = msg;
+
+	/* increase message entry */
+	mq->entry ++;
+
+	/* wake up one receiver */
+	pthread_cond_signal(&(hmq->cond));
+	pthread_mutex_unlock(&(hmq->lock));
+
+	return RT_EOK;
+}
+
+rt_err_t rt_mq_urgent(rt_mq_t mq, void* buffer, rt_size_t size)
+{
+	struct rt_mq_message *msg;
+
+	/* greater than one message size */
+	if (size > mq->msg_size) return -RT_ERROR;
+
+	pthread_mutex_lock(&(hmq->lock));
+
+	/* get a free list, there must be an empty item */
+	msg = (struct rt_mq_message*)mq->msg_queue_free;
+
+	/* message queue is full */
+	if (msg == RT_NULL)
+	{
+		pthread_mutex_unlock(&(hmq->lock));
+		return -RT_EFULL;
+	}
+
+	/* move free list pointer */
+	mq->msg_queue_free = msg->next;
+
+	/* copy buffer */
+	rt_memcpy(msg + 1, buffer, (unsigned short)size);
+
+	/* link msg to the beginning of message queue */
+	msg->next = mq->msg_queue_head;
+	mq->msg_queue_head = msg;
+
+	/* if there is no tail */
+	if (mq->msg_queue_tail == RT_NULL) mq->msg_queue_tail = msg;
+
+	/* increase message entry */
+	mq->entry ++;
+
+	/* wake up one receiver */
+	pthread_cond_signal(&(hmq->cond));
+	pthread_mutex_unlock(&(hmq->lock));
+
+	return RT_EOK;
+}
+
+rt_err_t rt_mq_recv (rt_mq_t mq, void* buffer, rt_size_t size, rt_int32_t timeout)
+{
+	rt_err_t r;
+	struct timespec abstime;
+	struct rt_mq_message *msg;
+
+	if (timeout > 0) host_abstime(CLOCK_MONOTONIC, &abstime, timeout);
+
+	pthread_mutex_lock(&(hmq->lock));
+
+	/* mq is empty */
+	while (mq->entry == 0)
+	{
+		if (timeout == 0)
+		{
+			pthread_mutex_unlock(&(hmq->lock));
+			return -RT_ETIMEOUT;
+		}
+
+		r = host_cond_wait(hmq, timeout < 0? RT_NULL : &abstime);
+		if (r != RT_EOK)
+		{
+			pthread_mutex_unlock(&(hmq->lock));
+			return r;
+		}
+	}
+
+	/* get message from queue */
+	msg = (struct rt_mq_message*) mq->msg_queue_head;
+
+	/* move message queue head */
+	mq->msg_queue_head = msg->next;
+
+	/* reach queue tail, set to NULL */
+	if (mq->msg_queue_tail == msg) mq->msg_queue_tail = RT_NULL;
+
+	/* copy message */
+	rt_memcpy(buffer, msg + 1,
+		size > mq->msg_size? (unsigned short)(mq->msg_size) : (unsigned short)size);
+
+	/* put message to free list */
+	msg->next = (struct rt_mq_message*)mq->msg_queue_free;
+	mq->msg_queue_free = msg;
+
+	/* decrease message entry */
+	mq->entry --;
+
+	pthread_mutex_unlock(&(hmq->lock));
+
+	return RT_EOK;
+}
+
+rt_err_t rt_mq_control(rt_mq_t mq, rt_uint8_t cmd, void* arg)
+{
+	return RT_EOK;
+}
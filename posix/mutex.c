@@ -0,0 +1,99 @@
+#include <rtthread.h>
+#include "host.h"
+
+#include <stdlib.h>
+
+#define hmutex ((pthread_mutex_t *)(mutex->host_mutex))
+
+rt_err_t rt_mutex_init (rt_mutex_t mutex, const char* name, rt_uint8_t flag)
+{
+	if (mutex != RT_NULL)
+	{
+		pthread_mutexattr_t attr;
+
+		rt_strncpy(mutex->name, name, RT_NAME_MAX);
+
+		/* the mutex of RT-Thread can be taken recursively by the owner */
+		mutex->host_mutex = malloc(sizeof(pthread_mutex_t));
+		pthread_mutexattr_init(&attr);
+		pthread_mutexattr_settype(&attr, PTHREAD_MUTEX_RECURSIVE);
+		pthread_mutex_init(hmutex, &attr);
+		pthread_mutexattr_destroy(&attr);
+	}
+
+	return RT_EOK;
+}
+
+rt_err_t rt_mutex_detach (rt_mutex_t mutex)
+{
+	pthread_mutex_destroy(hmutex);
+	free(mutex->host_mutex);
+	mutex->host_mutex = RT_NULL;
+
+	return RT_EOK;
+}
+
+rt_mutex_t rt_mutex_create (const char* name, rt_uint8_t flag)
+{
+	rt_mutex_t mutex;
+
+	mutex = (rt_mutex_t)rt_malloc(sizeof(struct rt_mutex));
+	if (mutex != RT_NULL)
+	{
+	    rt_mutex_init(mutex, name, flag);
+		return mutex;
+	}
+
+	return RT_NULL;
+}
+
+rt_err_t rt_mutex_delete (rt_mutex_t mutex)
+{
+	rt_mutex_detach(mutex);
+
+	rt_free(mutex);
+
+	return RT_EOK;
+}
+
+rt_err_t rt_mutex_take (rt_mutex_t mutex, rt_int32_t time)
+{
+	int r;
+
+	if (time < 0)
+	{
+		r = pthread_mutex_lock(hmutex);
+	}
+	else if (time == 0)
+	{
+		r = pthread_mutex_trylock(hmutex);
+	}
+	else
+	{
+		struct timespec abstime;
+
+		/* pthread_mutex_timedlock only accepts the realtime clock */
+		host_abstime(CLOCK_REALTIME, &abstime, time);
+		r = pthread_mutex_timedlock(hmutex, &abstime);
+	}
+
+	if (r == 0) return RT_EOK;
+	if (r == ETIMEDOUT || r == EBUSY) return -RT_ETIMEOUT;
+
+	return -RT_ERROR;
+}
+
+rt_err_t rt_mutex_release(rt_mutex_t mutex)
+{
+	if (pthread_mutex_unlock(hmutex) == 0)
+	{
+		return RT_EOK;
+	}
+
+	return -RT_ERROR;
+}
+
+rt_err_t rt_mutex_control(rt_mutex_t mutex, rt_uint8_t cmd, void* arg)
+{
+	return RT_EOK;
+}
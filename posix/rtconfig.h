@@ -0,0 +1,45 @@
+/* RT-Thread config file for the POSIX host */
+#ifndef __RTTHREAD_CFG_H__
+#define __RTTHREAD_CFG_H__
+
+/* SECTION: RT-Thread/GUI */
+#define RT_USING_RTGUI
+
+/* name length of RTGUI object */
+#define RTGUI_NAME_MAX		12
+/* support 16 weight font */
+#define RTGUI_USING_FONT16
+/* support Chinese font */
+#define RTGUI_USING_FONTHZ
+/* use small size in RTGUI */
+#define RTGUI_USING_SMALL_SIZE
+/* default font size in RTGUI */
+#define RTGUI_DEFAULT_FONT_SIZE	12
+
+#define RTGUI_USING_STDIO_FILERW
+#define RTGUI_IMAGE_CONTAINER
+#define RTGUI_IMAGE_XPM
+#define RTGUI_IMAGE_BMP
+#define RTGUI_IMAGE_PNG
+#define RTGUI_IMAGE_JPEG
+#define RTGUI_USING_FONT12
+#define RTGUI_USING_HZ_BMP
+#define RTGUI_USING_WINMOVE
+/* memory hooks, used by the benchmarks to count allocations */
+#define RTGUI_USING_HOOK
+/* input event recorder and replayer */
+#define RTGUI_USING_RECORDER
+/* runtime statistics */
+#define RTGUI_USING_STATS
+/* event trace, exported to Chrome trace_event JSON */
+#define RTGUI_USING_EVENT_TRACE
+/* coalesce the set_pixel of pixel device into lines */
+#define RTGUI_USING_PIXEL_SPAN
+/* draw in a shadow of framebuffer and write the updated rect to device */
+#define RTGUI_USING_SHADOW_FRAMEBUFFER
+/* send the screen update to device in a thread */
+#define RTGUI_USING_ASYNC_FLUSH
+/* coalesce the screen updates in a frame of 20ms */
+#define RTGUI_SVR_FRAME_TICK	(RT_TICK_PER_SECOND/50)
+
+#endif
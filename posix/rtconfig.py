@@ -0,0 +1,2 @@
+CROSS_TOOL = 'gcc'
+TARGET_EXT = ''
@@ -0,0 +1,112 @@
+#include <rtthread.h>
+#include "host.h"
+
+#include <stdlib.h>
+
+struct host_sem
+{
+	struct host_cond hc;
+	rt_uint32_t value;
+};
+
+rt_err_t rt_sem_init (rt_sem_t sem, const char* name, rt_uint32_t value, rt_uint8_t flag)
+{
+	if (sem != RT_NULL)
+	{
+		struct host_sem* hs;
+
+		memset(sem->name, 0, sizeof(sem->name));
+		rt_strncpy(sem->name, name, RT_NAME_MAX);
+
+		hs = (struct host_sem*) malloc(sizeof(struct host_sem));
+		host_cond_init(&(hs->hc));
+		hs->value = value;
+
+		sem->host_sem = hs;
+	}
+
+	return RT_EOK;
+}
+
+rt_err_t rt_sem_detach (rt_sem_t sem)
+{
+	struct host_sem* hs = (struct host_sem*)sem->host_sem;
+
+	host_cond_fini(&(hs->hc));
+	free(hs);
+	sem->host_sem = RT_NULL;
+
+	return RT_EOK;
+}
+
+rt_sem_t rt_sem_create (const char* name, rt_uint32_t value, rt_uint8_t flag)
+{
+	rt_sem_t sem;
+
+	sem = (rt_sem_t)rt_malloc(sizeof(struct rt_semaphore));
+	if (sem != RT_NULL)
+	{
+	    rt_sem_init(sem, name, value, flag);
+		return sem;
+	}
+
+	return RT_NULL;
+}
+
+rt_err_t rt_sem_delete (rt_sem_t sem)
+{
+	rt_sem_detach(sem);
+
+	rt_free(sem);
+
+	return RT_EOK;
+}
+
+rt_err_t rt_sem_take (rt_sem_t sem, rt_int32_t time)
+{
+	rt_err_t r = RT_EOK;
+	struct timespec abstime;
+	struct host_sem* hs = (struct host_sem*)sem->host_sem;
+
+	if (time > 0) host_abstime(CLOCK_MONOTONIC, &abstime, time);
+
+	pthread_mutex_lock(&(hs->hc.lock));
+	while (hs->value == 0)
+	{
+		if (time == 0)
+		{
+			r = -RT_ETIMEOUT;
+			break;
+		}
+
+		r = host_cond_wait(&(hs->hc), time < 0? RT_NULL : &abstime);
+		if (r != RT_EOK) break;
+	}
+
+	if (r == RT_EOK) hs->value --;
+	pthread_mutex_unlock(&(hs->hc.lock));
+
+	return r;
+}
+
+rt_err_t rt_sem_trytake(rt_sem_t sem)
+{
+	return rt_sem_take(sem, 0);
+}
+
+rt_err_t rt_sem_release(rt_sem_t sem)
+{
+	struct host_sem* hs = (struct host_sem*)sem->host_sem;
+
+	pthread_mutex_lock(&(hs->hc.lock));
+	hs->value ++;
+	pthread_cond_signal(&(hs->hc.cond));
+	pthread_mutex_unlock(&(hs->hc.lock));
+
+	return RT_EOK;
+}
+
+rt_err_t rt_sem_control(rt_sem_t sem, rt_uint8_t cmd, void* arg)
+{
+	return RT_EOK;
+}
@@ -0,0 +1,7 @@
+void rt_hw_key_init()
+{
+}
+
+void rt_hw_lcd_init(void)
+{
+}
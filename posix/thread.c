@@ -0,0 +1,223 @@
+#include <rtthread.h>
+#include "list.h"
+#include "host.h"
+
+#include <stdlib.h>
+#include <sched.h>
+#include <string.h>
+
+#ifdef THREAD_DEBUG
+#define DBG_MSG(x)	rt_kprintf x
+#else
+#define DBG_MSG(x)
+#endif
+
+rt_list_t _thread_list;
+pthread_mutex_t _thread_list_mutex = PTHREAD_MUTEX_INITIALIZER;
+
+/* the rt_thread running on current host thread */
+static __thread rt_thread_t _thread_self = RT_NULL;
+
+struct host_thread
+{
+	pthread_t pthread;
+};
+
+void rt_thread_system_init()
+{
+	rt_list_init(&_thread_list);
+}
+
+rt_err_t rt_thread_init(struct rt_thread* thread,
+	const char* name,
+	void (*entry)(void* parameter), void* parameter,
+	void* stack_start, rt_uint32_t stack_size,
+	rt_uint8_t priority, rt_uint32_t tick)
+{
+	RT_ASSERT(thread != RT_NULL);
+
+	rt_strncpy(thread->name, name, RT_NAME_MAX);
+
+	thread->entry = entry;
+	thread->parameter = parameter;
+	thread->tid = thread;
+	thread->stat = RT_THREAD_INIT;
+	thread->host_thread = RT_NULL;
+	thread->user_data = 0;
+
+	rt_list_init(&(thread->tlist));
+
+	/* add to list */
+	pthread_mutex_lock(&_thread_list_mutex);
+	rt_list_insert_after(&_thread_list, &(thread->tlist));
+	pthread_mutex_unlock(&_thread_list_mutex);
+
+	return RT_EOK;
+}
+
+rt_err_t rt_thread_detach(rt_thread_t thread)
+{
+	/* the host thread can't be killed, it's detached and exits by itself */
+	thread->stat = RT_THREAD_INIT;
+
+	pthread_mutex_lock(&_thread_list_mutex);
+	rt_list_remove(&(thread->tlist));
+	pthread_mutex_unlock(&_thread_list_mutex);
+
+	if (thread->host_thread != RT_NULL)
+	{
+		free(thread->host_thread);
+		thread->host_thread = RT_NULL;
+	}
+
+	return RT_EOK;
+}
+
+rt_thread_t rt_thread_create (const char* name,
+	void (*entry)(void* parameter), void* parameter,
+	rt_uint32_t stack_size,
+	rt_uint8_t priority, rt_uint32_t tick)
+{
+	rt_thread_t thread;
+
+	thread = (rt_thread_t)rt_malloc(sizeof(struct rt_thread));
+	if (thread != RT_NULL)
+	{
+		rt_thread_init(thread, name, entry, parameter, NULL, stack_size, priority, tick);
+	}
+
+	return thread;
+}
+
+rt_thread_t rt_thread_self(void)
+{
+	return _thread_self;
+}
+
+static void* host_thread_entry(void* parameter)
+{
+	rt_thread_t thread = (rt_thread_t) parameter;
+
+	_thread_self = thread;
+	thread->stat = RT_THREAD_READY;
+
+	DBG_MSG(("create thread:%s, tid: 0x%p\n", thread->name, thread->tid));
+
+	/* execute thread entry */
+	thread->entry(thread->parameter);
+
+	return NULL;
+}
+
+rt_err_t rt_thread_startup(rt_thread_t thread)
+{
+	pthread_attr_t attr;
+	struct host_thread* ht;
+
+	if (thread->stat == RT_THREAD_READY)
+	{
+		return -RT_ERROR;
+	}
+
+	ht = (struct host_thread*) malloc(sizeof(struct host_thread));
+	if (ht == RT_NULL) return -RT_ERROR;
+	thread->host_thread = ht;
+
+	pthread_attr_init(&attr);
+	pthread_attr_setdetachstate(&attr, PTHREAD_CREATE_DETACHED);
+	if (pthread_create(&(ht->pthread), &attr, host_thread_entry, thread) != 0)
+	{
+		pthread_attr_destroy(&attr);
+		return -RT_ERROR;
+	}
+	pthread_attr_destroy(&attr);
+
+	return RT_EOK;
+}
+
+rt_err_t rt_thread_delete(rt_thread_t thread)
+{
+	rt_thread_detach(thread);
+
+	rt_free(thread);
+	return RT_EOK;
+}
+
+rt_err_t rt_thread_yield(void)
+{
+	sched_yield();
+
+	return RT_EOK;
+}
+
+rt_err_t rt_thread_delay(rt_tick_t tick)
+{
+	struct timespec ts;
+
+	ts.tv_sec  = tick / RT_TICK_PER_SECOND;
+	ts.tv_nsec = (tick % RT_TICK_PER_SECOND) * (1000000000L / RT_TICK_PER_SECOND);
+	while (nanosleep(&ts, &ts) != 0 && errno == EINTR) ;
+
+	return RT_EOK;
+}
+
+rt_err_t rt_thread_control(rt_thread_t thread, rt_uint8_t cmd, void* arg)
+{
+	return RT_EOK;
+}
+
+rt_err_t rt_thread_suspend(rt_thread_t thread)
+{
+	return RT_EOK;
+}
+
+rt_err_t rt_thread_resume(rt_thread_t thread)
+{
+	return RT_EOK;
+}
+
+static pthread_mutex_t _critical_mutex;
+static pthread_once_t _critical_once = PTHREAD_ONCE_INIT;
+
+static void _critical_init(void)
+{
+	pthread_mutexattr_t attr;
+
+	/* the critical section can be nested */
+	pthread_mutexattr_init(&attr);
+	pthread_mutexattr_settype(&attr, PTHREAD_MUTEX_RECURSIVE);
+	pthread_mutex_init(&_critical_mutex, &attr);
+	pthread_mutexattr_destroy(&attr);
+}
+
+void rt_enter_critical(void)
+{
+	pthread_once(&_critical_once, _critical_init);
+	pthread_mutex_lock(&_critical_mutex);
+}
+
+void rt_exit_critical(void)
+{
+	pthread_mutex_unlock(&_critical_mutex);
+}
+
+/* note: this function is not located in RT-Thread RTOS */
+rt_thread_t rt_thread_find(char* name)
+{
+	rt_thread_t thread;
+	struct rt_list_node* node;
+
+	pthread_mutex_lock(&_thread_list_mutex);
+	rt_list_foreach(node, &(_thread_list), next)
+	{
+		thread = rt_list_entry(node, struct rt_thread, tlist);
+		if (strncmp(thread->name, name, RT_NAME_MAX) == 0)
+		{
+			pthread_mutex_unlock(&_thread_list_mutex);
+			return thread->tid;
+		}
+	}
+
+	pthread_mutex_unlock(&_thread_list_mutex);
+	return RT_NULL;
+}
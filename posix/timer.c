@@ -0,0 +1,242 @@
+#include "rtthread.h"
+#include "list.h"
+#include "host.h"
+
+#include <stdlib.h>
+
+/*
+ * All timers are served by one host thread, the active timers are kept in
+ * a list which is sorted by timeout. The callback runs without lock, so the
+ * detach waits until it returns. A timer detached by its own callback is
+ * released by the timer thread after the callback.
+ */
+struct _host_timer
+{
+	rt_list_t list;
+	struct rt_timer* owner;	/* RT_NULL when detached in its callback */
+
+	unsigned long long timeout;	/* absolute timeout in nanosecond */
+	rt_tick_t interval;
+	rt_bool_t active;
+	rt_bool_t running;
+};
+
+static rt_list_t _timer_list = {&_timer_list, &_timer_list};
+static struct host_cond _timer_cond;
+static pthread_cond_t _timer_done = PTHREAD_COND_INITIALIZER;
+static pthread_t _timer_thread;
+static pthread_once_t _timer_once = PTHREAD_ONCE_INIT;
+
+/* convert RT-Thread OS tick to nanoseconds */
+#define TICK_TO_NS(tick)	((unsigned long long)(tick) * (1000000000ULL / RT_TICK_PER_SECOND))
+
+static void _host_timer_insert(struct _host_timer* ht)
+{
+	struct rt_list_node* node;
+
+	rt_list_foreach(node, &_timer_list, next)
+	{
+		struct _host_timer* item = rt_list_entry(node, struct _host_timer, list);
+		if (item->timeout > ht->timeout) break;
+	}
+
+	/* insert before the first timer which expires later */
+	rt_list_insert_before(node, &(ht->list));
+	ht->active = RT_TRUE;
+}
+
+static void* _host_timer_entry(void* parameter)
+{
+	struct timespec abstime;
+	struct _host_timer* ht;
+	struct rt_timer* timer;
+
+	pthread_mutex_lock(&(_timer_cond.lock));
+	while (1)
+	{
+		if (rt_list_isempty(&_timer_list))
+		{
+			host_cond_wait(&_timer_cond, RT_NULL);
+			continue;
+		}
+
+		ht = rt_list_entry(_timer_list.next, struct _host_timer, list);
+		if (ht->timeout > host_time_ns())
+		{
+			abstime.tv_sec  = ht->timeout / 1000000000ULL;
+			abstime.tv_nsec = ht->timeout % 1000000000ULL;
+			host_cond_wait(&_timer_cond, &abstime);
+			continue;
+		}
+
+		/* remove the timeout timer */
+		rt_list_remove(&(ht->list));
+		ht->active = RT_FALSE;
+
+		timer = ht->owner;
+		if (timer->flag & RT_TIMER_FLAG_PERIODIC)
+		{
+			/* a periodic timer of 0 tick runs each tick, not in a busy loop */
+			ht->timeout += TICK_TO_NS(ht->interval != 0? ht->interval : 1);
+			_host_timer_insert(ht);
+		}
+
+		/* call timer callback without lock */
+		ht->running = RT_TRUE;
+		pthread_mutex_unlock(&(_timer_cond.lock));
+		timer->timeout_func(timer->parameter);
+		pthread_mutex_lock(&(_timer_cond.lock));
+		ht->running = RT_FALSE;
+
+		if (ht->owner == RT_NULL) free(ht);
+		else pthread_cond_broadcast(&_timer_done);
+	}
+
+	return NULL;
+}
+
+static void _host_timer_system_init(void)
+{
+	host_cond_init(&_timer_cond);
+	pthread_create(&_timer_thread, NULL, _host_timer_entry, RT_NULL);
+	pthread_detach(_timer_thread);
+}
+
+void rt_timer_init(rt_timer_t timer,
+	const char* name,
+	void (*timeout)(void* parameter), void* parameter,
+	rt_tick_t time, rt_uint8_t flag)
+{
+	struct _host_timer* ht;
+
+	RT_ASSERT(timer != RT_NULL);
+
+	pthread_once(&_timer_once, _host_timer_system_init);
+
+	rt_strncpy(timer->name, name, RT_NAME_MAX);
+
+	timer->timeout_func = timeout;
+	timer->parameter = parameter;
+	timer->flag = flag;
+
+	ht = (struct _host_timer*) malloc(sizeof(struct _host_timer));
+	timer->host_timer = ht;
+
+	rt_list_init(&(ht->list));
+	ht->owner = timer;
+	ht->interval = time;
+	ht->active = RT_FALSE;
+	ht->running = RT_FALSE;
+}
+
+rt_err_t rt_timer_detach(rt_timer_t timer)
+{
+	struct _host_timer* ht;
+
+	ht = (struct _host_timer*)timer->host_timer;
+
+	pthread_mutex_lock(&(_timer_cond.lock));
+	if (ht->active == RT_TRUE)
+	{
+		rt_list_remove(&(ht->list));
+		ht->active = RT_FALSE;
+	}
+
+	if (ht->running == RT_TRUE && pthread_equal(pthread_self(), _timer_thread))
+	{
+		/* detached by its own callback, the timer thread releases it */
+		ht->owner = RT_NULL;
+		ht = RT_NULL;
+	}
+	else
+	{
+		/* wait for the callback on timer thread */
+		while (ht->running == RT_TRUE)
+			pthread_cond_wait(&_timer_done, &(_timer_cond.lock));
+	}
+	pthread_mutex_unlock(&(_timer_cond.lock));
+
+	free(ht);
+	timer->host_timer = RT_NULL;
+
+	return RT_EOK;
+}
+
+rt_timer_t rt_timer_create(const char* name,
+	void (*timeout)(void* parameter), void* parameter,
+	rt_tick_t time, rt_uint8_t flag)
+{
+	rt_timer_t timer;
+
+	timer = (rt_timer_t)rt_malloc(sizeof(struct rt_timer));
+	if (timer != RT_NULL)
+		rt_timer_init(timer, name, timeout, parameter, time, flag);
+
+	return timer;
+}
+
+rt_err_t rt_timer_delete(rt_timer_t timer)
+{
+	rt_timer_detach(timer);
+	rt_free(timer);
+
+	return RT_EOK;
+}
+
+rt_err_t rt_timer_start(rt_timer_t timer)
+{
+	struct _host_timer* ht;
+
+	ht = (struct _host_timer*)timer->host_timer;
+
+	pthread_mutex_lock(&(_timer_cond.lock));
+	if (ht->active == RT_TRUE) rt_list_remove(&(ht->list));
+
+	ht->timeout = host_time_ns() + TICK_TO_NS(ht->interval);
+	_host_timer_insert(ht);
+
+	/* wake up timer thread to re-calculate the next timeout */
+	pthread_cond_signal(&(_timer_cond.cond));
+	pthread_mutex_unlock(&(_timer_cond.lock));
+
+	return RT_EOK;
+}
+
+rt_err_t rt_timer_stop(rt_timer_t timer)
+{
+	struct _host_timer* ht;
+
+	ht = (struct _host_timer*)timer->host_timer;
+
+	pthread_mutex_lock(&(_timer_cond.lock));
+	if (ht->active == RT_TRUE)
+	{
+		rt_list_remove(&(ht->list));
+		ht->active = RT_FALSE;
+	}
+	pthread_mutex_unlock(&(_timer_cond.lock));
+
+	return RT_EOK;
+}
+
+rt_err_t rt_timer_control(rt_timer_t timer, rt_uint8_t cmd, void* arg)
+{
+	struct _host_timer* ht;
+
+	ht = (struct _host_timer*)timer->host_timer;
+
+	/* the new time takes effect on the next start */
+	switch (cmd)
+	{
+	case RT_TIMER_CTRL_SET_TIME:
+		ht->interval = *(rt_tick_t*)arg;
+		break;
+	case RT_TIMER_CTRL_GET_TIME:
+		*(rt_tick_t*)arg = ht->interval;
+		break;
+	default:
+		return -RT_ERROR;
+	}
+
+	return RT_EOK;
+}
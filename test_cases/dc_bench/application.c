@@ -0,0 +1,507 @@
+/*
+ * File      : application.c
+ * This file is part of RTGUI in RT-Thread RTOS
+ * COPYRIGHT (C) 2006 - 2012, RT-Thread Development Team
+ *
+ * The license and distribution terms for this file may be
+ * found in the file LICENSE in this distribution or at
+ * http://www.rt-thread.org/license/LICENSE
+ */
+#include <rtthread.h>
+
+#include <rtgui/rtgui.h>
+#include <rtgui/rtgui_system.h>
+#include <rtgui/rtgui_application.h>
+#include <rtgui/dc.h>
+#include <rtgui/dc_hw.h>
+#include <rtgui/dc_client.h>
+#include <rtgui/image.h>
+#include <rtgui/driver.h>
+#include <rtgui/widgets/window.h>
+
+/*
+ * Each case is run for DC_BENCH_TICKS OS ticks, the result is reported in
+ * nanosecond per call and mega pixels per second.
+ */
+#ifndef DC_BENCH_TICKS
+#define DC_BENCH_TICKS		(RT_TICK_PER_SECOND / 5)
+#endif
+#define DC_BENCH_BATCH		16
+
+#define BENCH_TEXT			"RT-Thread GUI"
+#define BENCH_RECT_SIZE		100
+#define BENCH_CIRCLE_R		40
+#define BENCH_POLYGON_R		40
+
+/* the framebuffer device for each ops table under test */
+struct bench_device
+{
+	struct rt_device parent;
+	struct rt_device_graphic_info info;
+	rt_uint8_t *pixels;
+};
+
+static const struct
+{
+	const char* name;
+	rt_uint8_t pixel_format;
+	rt_uint8_t bits_per_pixel;
+} _formats[] =
+{
+	{"mono",	RTGRAPHIC_PIXEL_FORMAT_MONO,	1},
+	{"gray4",	RTGRAPHIC_PIXEL_FORMAT_GRAY4,	2},
+	{"gray16",	RTGRAPHIC_PIXEL_FORMAT_GRAY16,	4},
+	{"rgb565",	RTGRAPHIC_PIXEL_FORMAT_RGB565,	16},
+	{"rgb565p",	RTGRAPHIC_PIXEL_FORMAT_RGB565P,	16},
+	{"rgb888",	RTGRAPHIC_PIXEL_FORMAT_RGB888,	24},
+	{"argb888",	RTGRAPHIC_PIXEL_FORMAT_ARGB888,	32},
+};
+
+static const char * bench_xpm[] = {
+	"16 16 4 1",
+	" 	c #FF0000",
+	".	c #00FF00",
+	"+	c #0000FF",
+	"@	c #FFFFFF",
+	"      ....      ",
+	"    ........    ",
+	"   ...++++...   ",
+	"  ..++++++++..  ",
+	" ..++@@@@@@++.. ",
+	" .++@@@@@@@@++. ",
+	"..++@@    @@++..",
+	".++@@      @@++.",
+	".++@@      @@++.",
+	"..++@@    @@++..",
+	" .++@@@@@@@@++. ",
+	" ..++@@@@@@++.. ",
+	"  ..++++++++..  ",
+	"   ...++++...   ",
+	"    ........    ",
+	"      ....      "};
+
+static struct rtgui_image *_image;
+static struct rtgui_dc *_buffer;
+static struct rtgui_dc *_key_buffer;
+static struct rtgui_dc *_argb_buffer;
+static struct rtgui_dc *_alpha_buffer;
+static rt_uint8_t *_line;
+static int _polygon_x[6], _polygon_y[6];
+static rt_uint32_t _polygon_area;
+static rt_uint32_t _text_area;
+
+static rt_err_t bench_device_control(rt_device_t dev, rt_uint8_t cmd, void *args)
+{
+	struct bench_device *device = (struct bench_device*)dev;
+
+	if (cmd == RTGRAPHIC_CTRL_GET_INFO)
+		*(struct rt_device_graphic_info*)args = device->info;
+
+	return RT_EOK;
+}
+
+static rt_err_t bench_device_init(struct bench_device *device, int index,
+	rt_uint16_t width, rt_uint16_t height)
+{
+	rt_memset(device, 0, sizeof(struct bench_device));
+	device->parent.control = bench_device_control;
+	device->info.pixel_format = _formats[index].pixel_format;
+	device->info.bits_per_pixel = _formats[index].bits_per_pixel;
+	device->info.width = width;
+	device->info.height = height;
+
+	/* mono framebuffer is in pages of 8 lines, a byte per column */
+	if (_formats[index].pixel_format == RTGRAPHIC_PIXEL_FORMAT_MONO)
+		device->pixels = (rt_uint8_t*) rtgui_malloc((height + 7) / 8 * width);
+	else
+		device->pixels = (rt_uint8_t*) rtgui_malloc(height * ((width * _formats[index].bits_per_pixel + 7)/8));
+	if (device->pixels == RT_NULL) return -RT_ERROR;
+	device->info.framebuffer = device->pixels;
+
+	return RT_EOK;
+}
+
+/* each bench function draws once and returns the number of touched pixels */
+typedef rt_uint32_t (*bench_func_t)(struct rtgui_dc *dc, rtgui_rect_t *rect, int i);
+
+static rt_uint32_t bench_hline(struct rtgui_dc *dc, rtgui_rect_t *rect, int i)
+{
+	rtgui_dc_draw_hline(dc, rect->x1, rect->x2, rect->y1 + i % rtgui_rect_height(*rect));
+	return rtgui_rect_width(*rect);
+}
+
+static rt_uint32_t bench_spans(struct rtgui_dc *dc, rtgui_rect_t *rect, int i)
+{
+	struct rtgui_span spans[2];
+	int y;
+
+	/* the second span is given from right to left */
+	y = rect->y1 + i % (rtgui_rect_height(*rect) - 1);
+	spans[0].x1 = rect->x1;
+	spans[0].x2 = rect->x2;
+	spans[0].y  = y;
+	spans[1].x1 = rect->x2;
+	spans[1].x2 = rect->x1;
+	spans[1].y  = y + 1;
+	rtgui_dc_draw_spans(dc, spans, 2);
+
+	return 2 * rtgui_rect_width(*rect);
+}
+
+static rt_uint32_t bench_vline(struct rtgui_dc *dc, rtgui_rect_t *rect, int i)
+{
+	rtgui_dc_draw_vline(dc, rect->x1 + i % rtgui_rect_width(*rect), rect->y1, rect->y2);
+	return rtgui_rect_height(*rect);
+}
+
+static rt_uint32_t bench_fill_rect(struct rtgui_dc *dc, rtgui_rect_t *rect, int i)
+{
+	rtgui_rect_t r;
+
+	r.x1 = rect->x1 + i % (rtgui_rect_width(*rect) - BENCH_RECT_SIZE);
+	r.y1 = rect->y1 + i % (rtgui_rect_height(*rect) - BENCH_RECT_SIZE);
+	r.x2 = r.x1 + BENCH_RECT_SIZE;
+	r.y2 = r.y1 + BENCH_RECT_SIZE;
+	rtgui_dc_fill_rect(dc, &r);
+
+	return BENCH_RECT_SIZE * BENCH_RECT_SIZE;
+}
+
+static rt_uint32_t bench_blit_line(struct rtgui_dc *dc, rtgui_rect_t *rect, int i)
+{
+	rtgui_dc_blit_line(dc, rect->x1, rect->x2, rect->y1 + i % rtgui_rect_height(*rect), _line);
+	return rtgui_rect_width(*rect);
+}
+
+static rt_uint32_t bench_text(struct rtgui_dc *dc, rtgui_rect_t *rect, int i)
+{
+	rtgui_rect_t r;
+
+	r = *rect;
+	r.y1 += i % (rtgui_rect_height(*rect) - 20);
+	rtgui_dc_draw_text(dc, BENCH_TEXT, &r);
+
+	return _text_area;
+}
+
+static rt_uint32_t bench_fill_polygon(struct rtgui_dc *dc, rtgui_rect_t *rect, int i)
+{
+	int vx[6], vy[6], index;
+	int dx, dy;
+
+	dx = rect->x1 + BENCH_POLYGON_R + i % (rtgui_rect_width(*rect) - 2 * BENCH_POLYGON_R);
+	dy = rect->y1 + BENCH_POLYGON_R + i % (rtgui_rect_height(*rect) - 2 * BENCH_POLYGON_R);
+	for (index = 0; index < 6; index ++)
+	{
+		vx[index] = _polygon_x[index] + dx;
+		vy[index] = _polygon_y[index] + dy;
+	}
+	rtgui_dc_fill_polygon(dc, vx, vy, 6);
+
+	return _polygon_area;
+}
+
+static rt_uint32_t bench_fill_circle(struct rtgui_dc *dc, rtgui_rect_t *rect, int i)
+{
+	rtgui_dc_fill_circle(dc,
+		rect->x1 + BENCH_CIRCLE_R + i % (rtgui_rect_width(*rect) - 2 * BENCH_CIRCLE_R),
+		rect->y1 + BENCH_CIRCLE_R + i % (rtgui_rect_height(*rect) - 2 * BENCH_CIRCLE_R),
+		BENCH_CIRCLE_R);
+
+	/* pi * r * r */
+	return BENCH_CIRCLE_R * BENCH_CIRCLE_R * 355 / 113;
+}
+
+static rt_uint32_t bench_image_blit(struct rtgui_dc *dc, rtgui_rect_t *rect, int i)
+{
+	rtgui_rect_t r;
+
+	r.x1 = rect->x1 + i % (rtgui_rect_width(*rect) - _image->w);
+	r.y1 = rect->y1 + i % (rtgui_rect_height(*rect) - _image->h);
+	r.x2 = r.x1 + _image->w;
+	r.y2 = r.y1 + _image->h;
+	rtgui_image_blit(_image, dc, &r);
+
+	return _image->w * _image->h;
+}
+
+static rt_uint32_t bench_buffer_blit(struct rtgui_dc *dc, rtgui_rect_t *rect, int i)
+{
+	rtgui_rect_t r;
+
+	r.x1 = rect->x1 + i % (rtgui_rect_width(*rect) - BENCH_RECT_SIZE);
+	r.y1 = rect->y1 + i % (rtgui_rect_height(*rect) - BENCH_RECT_SIZE);
+	r.x2 = r.x1 + BENCH_RECT_SIZE;
+	r.y2 = r.y1 + BENCH_RECT_SIZE;
+	rtgui_dc_blit(_buffer, RT_NULL, dc, &r);
+
+	return BENCH_RECT_SIZE * BENCH_RECT_SIZE;
+}
+
+/* the circle sprite is drawn in the runs between the pixels of color key */
+static rt_uint32_t bench_buffer_key(struct rtgui_dc *dc, rtgui_rect_t *rect, int i)
+{
+	rtgui_rect_t r;
+
+	r.x1 = rect->x1 + i % (rtgui_rect_width(*rect) - BENCH_RECT_SIZE);
+	r.y1 = rect->y1 + i % (rtgui_rect_height(*rect) - BENCH_RECT_SIZE);
+	r.x2 = r.x1 + BENCH_RECT_SIZE;
+	r.y2 = r.y1 + BENCH_RECT_SIZE;
+	rtgui_dc_blit(_key_buffer, RT_NULL, dc, &r);
+
+	return BENCH_RECT_SIZE * BENCH_RECT_SIZE;
+}
+
+/* the buffer in ARGB888 is converted to the screen on each blit */
+static rt_uint32_t bench_buffer_argb(struct rtgui_dc *dc, rtgui_rect_t *rect, int i)
+{
+	rtgui_rect_t r;
+
+	r.x1 = rect->x1 + i % (rtgui_rect_width(*rect) - BENCH_RECT_SIZE);
+	r.y1 = rect->y1 + i % (rtgui_rect_height(*rect) - BENCH_RECT_SIZE);
+	r.x2 = r.x1 + BENCH_RECT_SIZE;
+	r.y2 = r.y1 + BENCH_RECT_SIZE;
+	rtgui_dc_blit(_argb_buffer, RT_NULL, dc, &r);
+
+	return BENCH_RECT_SIZE * BENCH_RECT_SIZE;
+}
+
+static rt_uint32_t bench_buffer_blend(struct rtgui_dc *dc, rtgui_rect_t *rect, int i)
+{
+	rtgui_rect_t r;
+
+	r.x1 = rect->x1 + i % (rtgui_rect_width(*rect) - BENCH_RECT_SIZE);
+	r.y1 = rect->y1 + i % (rtgui_rect_height(*rect) - BENCH_RECT_SIZE);
+	r.x2 = r.x1 + BENCH_RECT_SIZE;
+	r.y2 = r.y1 + BENCH_RECT_SIZE;
+	rtgui_dc_blit(_alpha_buffer, RT_NULL, dc, &r);
+
+	return BENCH_RECT_SIZE * BENCH_RECT_SIZE;
+}
+
+static const struct
+{
+	const char* name;
+	bench_func_t func;
+} _benches[] =
+{
+	{"hline",		bench_hline},
+	{"spans",		bench_spans},
+	{"vline",		bench_vline},
+	{"fill_rect",	bench_fill_rect},
+	{"blit_line",	bench_blit_line},
+	{"text",		bench_text},
+	{"fill_polygon", bench_fill_polygon},
+	{"fill_circle",	bench_fill_circle},
+	{"image_blit",	bench_image_blit},
+	{"buffer_blit",	bench_buffer_blit},
+	{"buffer_key",	bench_buffer_key},
+	{"buffer_argb",	bench_buffer_argb},
+	{"buffer_blend", bench_buffer_blend},
+};
+
+static void bench_run(const char* engine, const char* format, struct rtgui_dc *dc)
+{
+	rt_tick_t start, elapsed;
+	rt_uint32_t calls, index, batch;
+	unsigned long long pixels, ns;
+	rtgui_rect_t rect;
+
+	rtgui_dc_get_rect(dc, &rect);
+	for (index = 0; index < sizeof(_benches)/sizeof(_benches[0]); index ++)
+	{
+		calls = 0;
+		pixels = 0;
+
+		/* start at a tick boundary */
+		start = rt_tick_get();
+		while (rt_tick_get() == start) ;
+
+		start = rt_tick_get();
+		do
+		{
+			for (batch = 0; batch < DC_BENCH_BATCH; batch ++, calls ++)
+				pixels += _benches[index].func(dc, &rect, calls);
+
+			elapsed = rt_tick_get() - start;
+		} while (elapsed < DC_BENCH_TICKS);
+
+		ns = (unsigned long long)elapsed * (1000000000 / RT_TICK_PER_SECOND);
+		/* Mpixels/s = pixels * 1000 / ns, keep one decimal */
+		rt_kprintf("%-10s %-8s %-13s %10u %8u.%u\n", engine, format, _benches[index].name,
+			(rt_uint32_t)(ns / calls),
+			(rt_uint32_t)(pixels * 1000 / ns),
+			(rt_uint32_t)(pixels * 10000 / ns % 10));
+	}
+}
+
+/* divide the widget into columns x rows clip rects with one pixel gap between them */
+static void bench_set_clip(rtgui_widget_t *widget, int columns, int rows)
+{
+	rtgui_rect_t rect, cell;
+	int column, row;
+
+	rect = widget->extent;
+	rtgui_region_fini(&(widget->clip));
+	rtgui_region_init(&(widget->clip));
+
+	for (row = 0; row < rows; row ++)
+	{
+		for (column = 0; column < columns; column ++)
+		{
+			cell.x1 = rect.x1 + rtgui_rect_width(rect) * column / columns;
+			cell.x2 = rect.x1 + rtgui_rect_width(rect) * (column + 1) / columns - 1;
+			cell.y1 = rect.y1 + rtgui_rect_height(rect) * row / rows;
+			cell.y2 = rect.y1 + rtgui_rect_height(rect) * (row + 1) / rows - 1;
+			rtgui_region_union_rect(&(widget->clip), &(widget->clip), &cell);
+		}
+	}
+}
+
+static void bench_prepare(void)
+{
+	int index, area;
+	rtgui_rect_t rect;
+	static const int hexagon[6][2] = {{40, 0}, {20, 35}, {-20, 35}, {-40, 0}, {-20, -35}, {20, -35}};
+
+	_image = rtgui_image_create_from_mem("xpm", (rt_uint8_t*)bench_xpm, sizeof(bench_xpm), RT_TRUE);
+
+	_argb_buffer = rtgui_dc_buffer_create_pixformat(RTGRAPHIC_PIXEL_FORMAT_ARGB888,
+		BENCH_RECT_SIZE, BENCH_RECT_SIZE);
+	rect.x1 = rect.y1 = 0;
+	rect.x2 = rect.y2 = BENCH_RECT_SIZE;
+	rtgui_dc_fill_rect(_argb_buffer, &rect);
+
+	/* the opacity goes from transparent on the left to opaque on the right */
+	_alpha_buffer = rtgui_dc_buffer_create_pixformat(RTGRAPHIC_PIXEL_FORMAT_ARGB888,
+		BENCH_RECT_SIZE, BENCH_RECT_SIZE);
+	rtgui_dc_buffer_set_blend_mode(_alpha_buffer, RTGUI_BLENDMODE_BLEND);
+	for (index = 0; index < BENCH_RECT_SIZE; index ++)
+	{
+		RTGUI_DC_FC(_alpha_buffer) = RTGUI_ARGB(index * 255 / (BENCH_RECT_SIZE - 1), 0x20, 0x80, 0xe0);
+		rtgui_dc_draw_vline(_alpha_buffer, index, 0, BENCH_RECT_SIZE);
+	}
+
+	/* a line of raw pixels, which is large enough for any format */
+	_line = (rt_uint8_t*) rtgui_malloc(rtgui_graphic_driver_get_default()->width * sizeof(rtgui_color_t));
+	for (index = 0; index < rtgui_graphic_driver_get_default()->width * sizeof(rtgui_color_t); index ++)
+		_line[index] = index;
+
+	/* shoelace area of the hexagon */
+	area = 0;
+	for (index = 0; index < 6; index ++)
+	{
+		_polygon_x[index] = hexagon[index][0];
+		_polygon_y[index] = hexagon[index][1];
+		area += hexagon[index][0] * hexagon[(index + 1) % 6][1] -
+			hexagon[(index + 1) % 6][0] * hexagon[index][1];
+	}
+	_polygon_area = (area < 0? -area : area) / 2;
+
+	rtgui_font_get_metrics(rtgui_font_default(), BENCH_TEXT, &rect);
+	_text_area = rtgui_rect_width(rect) * rtgui_rect_height(rect);
+}
+
+static void dc_bench_entry(void* parameter)
+{
+	struct rtgui_application* app;
+	struct rtgui_win *win;
+	struct rtgui_dc *dc;
+	struct bench_device device;
+	rt_device_t screen;
+	rtgui_rect_t rect, r;
+	int index;
+	static const int clips[][2] = {{1, 1}, {2, 4}, {8, 8}};
+	char engine[16];
+
+	app = rtgui_application_create(rt_thread_self(), "dc_bench");
+	RT_ASSERT(app != RT_NULL);
+
+	screen = rtgui_graphic_driver_get_default()->device;
+	rtgui_graphic_driver_get_rect(rtgui_graphic_driver_get_default(), &rect);
+
+	win = rtgui_win_create(RT_NULL, "dc_bench", &rect,
+		RTGUI_WIN_STYLE_NO_TITLE | RTGUI_WIN_STYLE_NO_BORDER);
+	rtgui_win_show(win, RT_FALSE);
+
+	bench_prepare();
+
+	rt_kprintf("%-10s %-8s %-13s %10s %10s\n", "engine", "format", "operation", "ns/call", "Mpixels/s");
+	for (index = 0; index < sizeof(_formats)/sizeof(_formats[0]); index ++)
+	{
+		int clip;
+
+		if (bench_device_init(&device, index, rtgui_rect_width(rect), rtgui_rect_height(rect)) != RT_EOK)
+			break;
+		rtgui_graphic_set_device(&(device.parent));
+
+		/* the buffer in the pixel format of screen is blitted without conversion */
+		_buffer = rtgui_dc_buffer_create(BENCH_RECT_SIZE, BENCH_RECT_SIZE);
+		r.x1 = r.y1 = 0;
+		r.x2 = r.y2 = BENCH_RECT_SIZE;
+		rtgui_dc_fill_rect(_buffer, &r);
+
+		/* a circle on the color key */
+		_key_buffer = rtgui_dc_buffer_create(BENCH_RECT_SIZE, BENCH_RECT_SIZE);
+		RTGUI_DC_BC(_key_buffer) = white;
+		rtgui_dc_fill_rect(_key_buffer, &r);
+		RTGUI_DC_FC(_key_buffer) = red;
+		rtgui_dc_fill_circle(_key_buffer, BENCH_RECT_SIZE/2, BENCH_RECT_SIZE/2, BENCH_CIRCLE_R);
+		rtgui_dc_buffer_set_color_key(_key_buffer, RT_TRUE, white);
+
+		dc = rtgui_dc_hw_create(RTGUI_WIDGET(win));
+		if (dc != RT_NULL)
+		{
+			bench_run("hw", _formats[index].name, dc);
+			rtgui_dc_end_drawing(dc);
+		}
+
+		for (clip = 0; clip < sizeof(clips)/sizeof(clips[0]); clip ++)
+		{
+			bench_set_clip(RTGUI_WIDGET(win), clips[clip][0], clips[clip][1]);
+
+			dc = rtgui_dc_client_create(RTGUI_WIDGET(win));
+			if (dc != RT_NULL)
+			{
+				rt_snprintf(engine, sizeof(engine), "client/%d", clips[clip][0] * clips[clip][1]);
+				bench_run(engine, _formats[index].name, dc);
+				rtgui_dc_end_drawing(dc);
+			}
+		}
+		rtgui_region_fini(&(RTGUI_WIDGET(win)->clip));
+		rtgui_region_init_with_extents(&(RTGUI_WIDGET(win)->clip), &(RTGUI_WIDGET(win)->extent));
+
+		dc = rtgui_dc_buffer_create(rtgui_rect_width(rect), rtgui_rect_height(rect));
+		if (dc != RT_NULL)
+		{
+			bench_run("buffer", _formats[index].name, dc);
+			rtgui_dc_destory(dc);
+		}
+		rtgui_dc_destory(_buffer);
+		rtgui_dc_destory(_key_buffer);
+
+		rtgui_graphic_set_device(screen);
+		rtgui_free(device.pixels);
+	}
+
+
+	rt_kprintf("dc_bench done\n");
+
+	rtgui_image_destroy(_image);
+	rtgui_dc_destory(_argb_buffer);
+	rtgui_dc_destory(_alpha_buffer);
+	rtgui_free(_line);
+	rtgui_win_destroy(win);
+	rtgui_application_destroy(app);
+}
+
+int rt_application_init()
+{
+	rt_thread_t tid;
+
+	tid = rt_thread_create("dc_bench", dc_bench_entry, RT_NULL, 4096, 25, 10);
+	if (tid != RT_NULL)
+		rt_thread_startup(tid);
+
+	return 0;
+}
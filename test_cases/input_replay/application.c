@@ -0,0 +1,211 @@
+/*
+ * File      : application.c
+ * This file is part of RTGUI in RT-Thread RTOS
+ * COPYRIGHT (C) 2006 - 2012, RT-Thread Development Team
+ *
+ * The license and distribution terms for this file may be
+ * found in the file LICENSE in this distribution or at
+ * http://www.rt-thread.org/license/LICENSE
+ */
+#include <rtthread.h>
+
+#include <rtgui/rtgui.h>
+#include <rtgui/rtgui_server.h>
+#include <rtgui/rtgui_system.h>
+#include <rtgui/rtgui_application.h>
+#include <rtgui/rtgui_recorder.h>
+#include <rtgui/kbddef.h>
+#include <rtgui/driver.h>
+#include <rtgui/widgets/window.h>
+#include <rtgui/widgets/listbox.h>
+
+/*
+ * A synthetic operator session is recorded first: scrolling a list with the
+ * keys, clicking on the items and dragging the window by its title. Then the
+ * session is replayed at recorded time and at max speed, and the latency from
+ * the injection to the screen update is reported.
+ */
+#ifndef INPUT_REPLAY_FILE
+#define INPUT_REPLAY_FILE		"input_replay.rec"
+#endif
+/* the interval between the synthetic events */
+#define INPUT_INTERVAL			2	/* OS tick */
+
+#define LIST_ITEMS				40
+
+static struct rtgui_listbox_item _items[LIST_ITEMS];
+static char _item_names[LIST_ITEMS][12];
+static rtgui_rect_t _win_rect;
+/* a window past the right and bottom edge of screen */
+static rtgui_rect_t _edge_rect = {100, 200, 400, 500};
+static volatile rt_bool_t _ui_ready = RT_FALSE;
+
+static void input_replay_ui_entry(void* parameter)
+{
+	struct rtgui_application* app;
+	struct rtgui_win *win, *edge_win;
+	struct rtgui_listbox *listbox;
+	int index;
+
+	app = rtgui_application_create(rt_thread_self(), "replay_ui");
+	RT_ASSERT(app != RT_NULL);
+
+	/* it's under the list window, whose updates are clipped by the screen */
+	edge_win = rtgui_win_create(RT_NULL, "edge", &_edge_rect, RTGUI_WIN_STYLE_DEFAULT);
+	rtgui_win_show(edge_win, RT_FALSE);
+
+	for (index = 0; index < LIST_ITEMS; index ++)
+	{
+		rt_snprintf(_item_names[index], sizeof(_item_names[index]), "item %d", index);
+		_items[index].name = _item_names[index];
+		_items[index].image = RT_NULL;
+	}
+
+	win = rtgui_win_create(RT_NULL, "replay", &_win_rect, RTGUI_WIN_STYLE_DEFAULT);
+	listbox = rtgui_listbox_create(_items, LIST_ITEMS, &_win_rect);
+	rtgui_container_add_child(RTGUI_CONTAINER(win), RTGUI_WIDGET(listbox));
+	rtgui_win_show(win, RT_FALSE);
+	rtgui_widget_focus(RTGUI_WIDGET(listbox));
+	rtgui_listbox_set_current_item(listbox, 0);
+
+	_ui_ready = RT_TRUE;
+	rtgui_application_run(app);
+
+	rtgui_win_destroy(win);
+	rtgui_win_destroy(edge_win);
+	rtgui_application_destroy(app);
+}
+
+static void input_post_kbd(rt_uint16_t key)
+{
+	struct rtgui_event_kbd kbd;
+
+	RTGUI_EVENT_KBD_INIT(&kbd);
+	kbd.wid = RT_NULL;
+	kbd.key = key;
+	kbd.mod = RTGUI_KMOD_NONE;
+	kbd.unicode = 0;
+
+	kbd.type = RTGUI_KEYDOWN;
+	rtgui_server_post_event(&(kbd.parent), sizeof(kbd));
+	rt_thread_delay(INPUT_INTERVAL);
+
+	kbd.type = RTGUI_KEYUP;
+	rtgui_server_post_event(&(kbd.parent), sizeof(kbd));
+	rt_thread_delay(INPUT_INTERVAL);
+}
+
+static void input_post_mouse(rt_uint16_t type, int x, int y, rt_uint16_t button)
+{
+	struct rtgui_event_mouse mouse;
+
+	if (type == RTGUI_EVENT_MOUSE_MOTION)
+		RTGUI_EVENT_MOUSE_MOTION_INIT(&mouse);
+	else
+		RTGUI_EVENT_MOUSE_BUTTON_INIT(&mouse);
+	mouse.wid = RT_NULL;
+	mouse.x = x;
+	mouse.y = y;
+	mouse.button = button;
+
+	rtgui_server_post_event(&(mouse.parent), sizeof(mouse));
+	rt_thread_delay(INPUT_INTERVAL);
+}
+
+static void input_session(void)
+{
+	int index, x, y;
+
+	/* list scrolling */
+	for (index = 0; index < LIST_ITEMS; index ++)
+		input_post_kbd(RTGUIK_DOWN);
+	for (index = 0; index < LIST_ITEMS / 2; index ++)
+		input_post_kbd(RTGUIK_UP);
+
+	/* menu navigation, click on the items */
+	for (index = 0; index < 8; index ++)
+	{
+		x = _win_rect.x1 + rtgui_rect_width(_win_rect) / 2;
+		y = _win_rect.y1 + 40 + index * 16;
+
+		input_post_mouse(RTGUI_EVENT_MOUSE_BUTTON, x, y, RTGUI_MOUSE_BUTTON_LEFT | RTGUI_MOUSE_BUTTON_DOWN);
+		input_post_mouse(RTGUI_EVENT_MOUSE_BUTTON, x, y, RTGUI_MOUSE_BUTTON_LEFT | RTGUI_MOUSE_BUTTON_UP);
+	}
+
+	/* window drag by its title */
+	x = _win_rect.x1 + 40;
+	y = _win_rect.y1 + 8;
+	input_post_mouse(RTGUI_EVENT_MOUSE_BUTTON, x, y, RTGUI_MOUSE_BUTTON_LEFT | RTGUI_MOUSE_BUTTON_DOWN);
+	for (index = 0; index < 20; index ++)
+	{
+		x += 1;
+		y += 2;
+		input_post_mouse(RTGUI_EVENT_MOUSE_MOTION, x, y, 0);
+	}
+	input_post_mouse(RTGUI_EVENT_MOUSE_BUTTON, x, y, RTGUI_MOUSE_BUTTON_LEFT | RTGUI_MOUSE_BUTTON_UP);
+}
+
+#ifdef RTGUI_USING_RECORDER
+static void input_replay(rt_bool_t max_speed)
+{
+	struct rtgui_replay_stat stat;
+
+	if (rtgui_recorder_replay(INPUT_REPLAY_FILE, max_speed, &stat) != RT_EOK)
+	{
+		rt_kprintf("replay %s failed\n", INPUT_REPLAY_FILE);
+		return;
+	}
+
+	rt_kprintf("%-9s %6u %7u %8u %8u %8u %8u %8u\n", max_speed? "max" : "recorded",
+		stat.events, stat.updated, stat.min, stat.p50, stat.p90, stat.p99, stat.max);
+}
+#endif
+
+static void input_replay_entry(void* parameter)
+{
+	while (_ui_ready == RT_FALSE) rt_thread_delay(1);
+	rt_thread_delay(RT_TICK_PER_SECOND / 10);
+
+#ifndef RTGUI_USING_RECORDER
+	/* the session is still run, but there is nothing to replay */
+	input_session();
+	rt_kprintf("input_replay needs RTGUI_USING_RECORDER\n");
+#else
+	if (rtgui_recorder_start(INPUT_REPLAY_FILE) != RT_EOK)
+	{
+		rt_kprintf("can't record to %s\n", INPUT_REPLAY_FILE);
+		return;
+	}
+	input_session();
+	/* let the server take the last events */
+	rt_thread_delay(RT_TICK_PER_SECOND / 10);
+	rtgui_recorder_stop();
+
+	rt_kprintf("%-9s %6s %7s %8s %8s %8s %8s %8s\n", "speed", "events", "updated",
+		"min(us)", "p50", "p90", "p99", "max");
+	input_replay(RT_FALSE);
+	input_replay(RT_TRUE);
+
+	rt_kprintf("input_replay done\n");
+#endif
+}
+
+int rt_application_init()
+{
+	rt_thread_t tid;
+
+	_win_rect.x1 = 10;
+	_win_rect.y1 = 30;
+	_win_rect.x2 = 210;
+	_win_rect.y2 = 250;
+
+	tid = rt_thread_create("replay_ui", input_replay_ui_entry, RT_NULL, 4096, 25, 10);
+	if (tid != RT_NULL)
+		rt_thread_startup(tid);
+
+	tid = rt_thread_create("replay", input_replay_entry, RT_NULL, 4096, 25, 10);
+	if (tid != RT_NULL)
+		rt_thread_startup(tid);
+
+	return 0;
+}
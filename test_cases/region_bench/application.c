@@ -0,0 +1,658 @@
+/*
+ * File      : application.c
+ * This file is part of RTGUI in RT-Thread RTOS
+ * COPYRIGHT (C) 2006 - 2012, RT-Thread Development Team
+ *
+ * The license and distribution terms for this file may be
+ * found in the file LICENSE in this distribution or at
+ * http://www.rt-thread.org/license/LICENSE
+ */
+#include <rtthread.h>
+
+#include <rtgui/rtgui.h>
+#include <rtgui/rtgui_system.h>
+#include <rtgui/region.h>
+
+/*
+ * Each case is run for REGION_BENCH_TICKS OS ticks, the result is reported in
+ * nanosecond and memory allocations per region operation.
+ */
+#ifndef REGION_BENCH_TICKS
+#define REGION_BENCH_TICKS		(RT_TICK_PER_SECOND / 5)
+#endif
+#define REGION_BENCH_BATCH		16
+
+/* the number of random sequences and the operations in each sequence */
+#ifndef REGION_CHECK_SEEDS
+#define REGION_CHECK_SEEDS		2000
+#endif
+#define REGION_CHECK_STEPS		64
+
+#define SCREEN_WIDTH			320
+#define SCREEN_HEIGHT			240
+
+#define STACK_SIZE				8	/* windows in the stack */
+#define TREE_COLUMNS			4	/* widget tree in the window */
+#define TREE_ROWS				4
+#define DAMAGE_SIZE				16	/* damage rects per frame */
+#define POINT_SIZE				64	/* hit test points */
+
+/* the scene: a window stack from top to bottom and a widget tree */
+static rtgui_rect_t _screen;
+static rtgui_rect_t _win[STACK_SIZE];
+static rtgui_region_t _available[STACK_SIZE + 1];	/* uncovered screen above each window */
+static rtgui_region_t _clip[STACK_SIZE];			/* visible region of each window */
+static rtgui_rect_t _widget[TREE_COLUMNS * TREE_ROWS];
+static rtgui_rect_t _damage[DAMAGE_SIZE];
+static int _point[POINT_SIZE][2];
+static rtgui_region_t _result;
+static int _tree;	/* the window with most complex clip, which holds the widget tree */
+
+/* allocation counter, only the benchmark thread is accounted */
+static rt_thread_t _bench_thread;
+static rt_uint32_t _malloc_count, _free_count;
+
+#ifdef RTGUI_USING_HOOK
+static void bench_malloc_hook(void* ptr, rt_size_t size)
+{
+	if (rt_thread_self() == _bench_thread) _malloc_count ++;
+}
+
+static void bench_free_hook(void* ptr)
+{
+	if (rt_thread_self() == _bench_thread) _free_count ++;
+}
+#endif
+
+static rt_uint32_t _random_seed;
+static rt_uint32_t bench_random(void)
+{
+	/* xorshift32, it's reproducible on all the targets */
+	_random_seed ^= _random_seed << 13;
+	_random_seed ^= _random_seed >> 17;
+	_random_seed ^= _random_seed << 5;
+
+	return _random_seed;
+}
+
+static void bench_rect_init(rtgui_rect_t *rect, int x, int y, int width, int height)
+{
+	rect->x1 = x;
+	rect->y1 = y;
+	rect->x2 = x + width;
+	rect->y2 = y + height;
+}
+
+static void bench_scene_init(void)
+{
+	int index;
+
+	bench_rect_init(&_screen, 0, 0, SCREEN_WIDTH, SCREEN_HEIGHT);
+
+	/* cascaded windows of different size, which are overlapped each other */
+	for (index = 0; index < STACK_SIZE; index ++)
+	{
+		bench_rect_init(&_win[index],
+			(index * 37) % 160, (index * 23) % 110,
+			120 + (index % 3) * 40, 90 + (index % 2) * 40);
+	}
+
+	/* as the server does, the clip of window is the screen left by the windows above it */
+	rtgui_region_init_with_extents(&_available[0], &_screen);
+	for (index = 0; index < STACK_SIZE; index ++)
+	{
+		rtgui_region_init(&_clip[index]);
+		rtgui_region_intersect_rect(&_clip[index], &_available[index], &_win[index]);
+
+		rtgui_region_init(&_available[index + 1]);
+		rtgui_region_subtract_rect(&_available[index + 1], &_available[index], &_win[index]);
+	}
+
+	_tree = 0;
+	for (index = 1; index < STACK_SIZE; index ++)
+	{
+		if (rtgui_region_num_rects(&_clip[index]) > rtgui_region_num_rects(&_clip[_tree]))
+			_tree = index;
+	}
+
+	/* a grid of buttons in the window */
+	for (index = 0; index < TREE_COLUMNS * TREE_ROWS; index ++)
+	{
+		rtgui_rect_t *win = &_win[_tree];
+
+		bench_rect_init(&_widget[index],
+			win->x1 + 4 + (index % TREE_COLUMNS) * (rtgui_rect_width(*win) - 8) / TREE_COLUMNS,
+			win->y1 + 4 + (index / TREE_COLUMNS) * (rtgui_rect_height(*win) - 8) / TREE_ROWS,
+			(rtgui_rect_width(*win) - 8) / TREE_COLUMNS - 2,
+			(rtgui_rect_height(*win) - 8) / TREE_ROWS - 2);
+	}
+
+	_random_seed = 0x20120609;
+	for (index = 0; index < DAMAGE_SIZE; index ++)
+	{
+		bench_rect_init(&_damage[index],
+			bench_random() % (SCREEN_WIDTH - 32), bench_random() % (SCREEN_HEIGHT - 16),
+			8 + bench_random() % 24, 8 + bench_random() % 8);
+	}
+	for (index = 0; index < POINT_SIZE; index ++)
+	{
+		_point[index][0] = bench_random() % SCREEN_WIDTH;
+		_point[index][1] = bench_random() % SCREEN_HEIGHT;
+	}
+
+	rtgui_region_init(&_result);
+}
+
+static void bench_scene_fini(void)
+{
+	int index;
+
+	for (index = 0; index < STACK_SIZE; index ++)
+	{
+		rtgui_region_fini(&_available[index]);
+		rtgui_region_fini(&_clip[index]);
+	}
+	rtgui_region_fini(&_available[STACK_SIZE]);
+	rtgui_region_fini(&_result);
+}
+
+/* re-calculate the uncovered screen when the window stack is changed */
+static rt_uint32_t bench_stack_subtract_rect(int i)
+{
+	int index;
+
+	rtgui_region_reset(&_result, &_screen);
+	for (index = 0; index < STACK_SIZE; index ++)
+		rtgui_region_subtract_rect(&_result, &_result, &_win[index]);
+
+	return STACK_SIZE;
+}
+
+/* re-calculate the clip of each window */
+static rt_uint32_t bench_stack_intersect_rect(int i)
+{
+	int index;
+
+	for (index = 0; index < STACK_SIZE; index ++)
+		rtgui_region_intersect_rect(&_result, &_available[index], &_win[index]);
+
+	return STACK_SIZE;
+}
+
+/* remove the visible windows from the screen */
+static rt_uint32_t bench_stack_subtract(int i)
+{
+	int index;
+
+	rtgui_region_reset(&_result, &_screen);
+	for (index = 0; index < STACK_SIZE; index ++)
+		rtgui_region_subtract(&_result, &_result, &_clip[index]);
+
+	return STACK_SIZE;
+}
+
+/* merge the visible windows */
+static rt_uint32_t bench_stack_union(int i)
+{
+	int index;
+
+	rtgui_region_empty(&_result);
+	for (index = 0; index < STACK_SIZE; index ++)
+		rtgui_region_union(&_result, &_result, &_clip[index]);
+
+	return STACK_SIZE;
+}
+
+/* the clip of each widget is the extent of widget in the clip of parent */
+static rt_uint32_t bench_tree_intersect_rect(int i)
+{
+	int index;
+
+	for (index = 0; index < TREE_COLUMNS * TREE_ROWS; index ++)
+		rtgui_region_intersect_rect(&_result, &_clip[_tree], &_widget[index]);
+
+	return TREE_COLUMNS * TREE_ROWS;
+}
+
+/* the parent removes the extent of children from its clip */
+static rt_uint32_t bench_tree_subtract_rect(int i)
+{
+	int index;
+
+	rtgui_region_copy(&_result, &_clip[_tree]);
+	for (index = 0; index < TREE_COLUMNS * TREE_ROWS; index ++)
+		rtgui_region_subtract_rect(&_result, &_result, &_widget[index]);
+
+	return TREE_COLUMNS * TREE_ROWS + 1;
+}
+
+/* accumulate the damaged area in one frame */
+static rt_uint32_t bench_damage_union_rect(int i)
+{
+	int index;
+
+	rtgui_region_empty(&_result);
+	for (index = 0; index < DAMAGE_SIZE; index ++)
+		rtgui_region_union_rect(&_result, &_result, &_damage[index]);
+
+	return DAMAGE_SIZE;
+}
+
+/* find the visible rect under the pen */
+static rt_uint32_t bench_contains_point(int i)
+{
+	int index;
+	rtgui_rect_t box;
+
+	for (index = 0; index < POINT_SIZE; index ++)
+		rtgui_region_contains_point(&_available[STACK_SIZE], _point[index][0], _point[index][1], &box);
+
+	return POINT_SIZE;
+}
+
+/* move a window around */
+static rt_uint32_t bench_translate(int i)
+{
+	int dx = (i & 0x01)? -1 : 1;
+
+	rtgui_region_translate(&_clip[_tree], dx, dx);
+
+	return 1;
+}
+
+static const struct
+{
+	const char* name;
+	rt_uint32_t (*func)(int i);
+} _benches[] =
+{
+	{"stack/subtract_rect",		bench_stack_subtract_rect},
+	{"stack/intersect_rect",	bench_stack_intersect_rect},
+	{"stack/subtract",			bench_stack_subtract},
+	{"stack/union",				bench_stack_union},
+	{"tree/intersect_rect",		bench_tree_intersect_rect},
+	{"tree/subtract_rect",		bench_tree_subtract_rect},
+	{"damage/union_rect",		bench_damage_union_rect},
+	{"contains_point",			bench_contains_point},
+	{"translate",				bench_translate},
+};
+
+static void bench_run(void)
+{
+	rt_tick_t start, elapsed;
+	rt_uint32_t calls, ops, index, batch;
+	unsigned long long ns;
+
+	rt_kprintf("scene: %d windows, desktop %d rects, window #%d %d rects\n", STACK_SIZE,
+		rtgui_region_num_rects(&_available[STACK_SIZE]), _tree,
+		rtgui_region_num_rects(&_clip[_tree]));
+	rt_kprintf("%-22s %10s %10s %10s\n", "operation", "ns/op", "malloc/op", "free/op");
+	for (index = 0; index < sizeof(_benches)/sizeof(_benches[0]); index ++)
+	{
+		calls = 0;
+		ops = 0;
+		_malloc_count = _free_count = 0;
+
+		/* start at a tick boundary */
+		start = rt_tick_get();
+		while (rt_tick_get() == start) ;
+
+		start = rt_tick_get();
+		do
+		{
+			for (batch = 0; batch < REGION_BENCH_BATCH; batch ++, calls ++)
+				ops += _benches[index].func(calls);
+
+			elapsed = rt_tick_get() - start;
+		} while (elapsed < REGION_BENCH_TICKS);
+
+		ns = (unsigned long long)elapsed * (1000000000 / RT_TICK_PER_SECOND);
+#ifdef RTGUI_USING_HOOK
+		/* keep two decimals of the allocation count */
+		rt_kprintf("%-22s %10u %7u.%02u %7u.%02u\n", _benches[index].name,
+			(rt_uint32_t)(ns / ops),
+			_malloc_count / ops, (rt_uint32_t)((unsigned long long)_malloc_count * 100 / ops % 100),
+			_free_count / ops, (rt_uint32_t)((unsigned long long)_free_count * 100 / ops % 100));
+#else
+		rt_kprintf("%-22s %10u %10s %10s\n", _benches[index].name,
+			(rt_uint32_t)(ns / ops), "-", "-");
+#endif
+	}
+}
+
+/*
+ * The correctness check: random sequences of region operations are applied to
+ * both the regions and the bitmaps, the rasterized region must be the same as
+ * the bitmap after each step, and the region must keep the y-x banded form.
+ */
+#define CHECK_REGIONS			4
+#define CHECK_OFFSET			32	/* the bitmap covers [-32, 96) */
+#define CHECK_SIZE				128
+#define CHECK_RECT_RANGE		64	/* random rects are in [0, 64) */
+
+static rtgui_region_t _check_region[CHECK_REGIONS];
+static rt_uint8_t _check_bitmap[CHECK_REGIONS][CHECK_SIZE * CHECK_SIZE];
+static rt_uint8_t _check_raster[CHECK_SIZE * CHECK_SIZE];
+static rt_uint8_t _check_tmp[CHECK_SIZE * CHECK_SIZE];
+
+#define CHECK_PIXEL(bitmap, x, y)	(bitmap)[((y) + CHECK_OFFSET) * CHECK_SIZE + (x) + CHECK_OFFSET]
+
+enum
+{
+	CHECK_UNION, CHECK_SUBTRACT, CHECK_INTERSECT,
+	CHECK_UNION_RECT, CHECK_SUBTRACT_RECT, CHECK_INTERSECT_RECT,
+	CHECK_INVERSE, CHECK_TRANSLATE, CHECK_COPY, CHECK_RESET, CHECK_EMPTY,
+	CHECK_OP_MAX
+};
+
+static const char* _check_op_name[CHECK_OP_MAX] =
+{
+	"union", "subtract", "intersect",
+	"union_rect", "subtract_rect", "intersect_rect",
+	"inverse", "translate", "copy", "reset", "empty"
+};
+
+static void check_random_rect(rtgui_rect_t *rect)
+{
+	int x1, x2, y1, y2;
+
+	x1 = bench_random() % CHECK_RECT_RANGE;
+	x2 = bench_random() % CHECK_RECT_RANGE;
+	y1 = bench_random() % CHECK_RECT_RANGE;
+	y2 = bench_random() % CHECK_RECT_RANGE;
+
+	rect->x1 = x1 < x2? x1 : x2;
+	rect->x2 = (x1 < x2? x2 : x1) + 1;
+	rect->y1 = y1 < y2? y1 : y2;
+	rect->y2 = (y1 < y2? y2 : y1) + 1;
+}
+
+static void check_bitmap_rect(rt_uint8_t *bitmap, const rtgui_rect_t *rect)
+{
+	int x, y;
+
+	rt_memset(bitmap, 0, CHECK_SIZE * CHECK_SIZE);
+	for (y = rect->y1; y < rect->y2; y ++)
+		for (x = rect->x1; x < rect->x2; x ++)
+			CHECK_PIXEL(bitmap, x, y) = 1;
+}
+
+/* rasterize the region and verify the invariants, return the error string */
+static const char* check_raster(rtgui_region_t *region, rt_uint8_t *bitmap)
+{
+	rtgui_rect_t *rects, *prev, box;
+	int count, index, x, y;
+
+	rects = rtgui_region_rects(region);
+	count = rtgui_region_num_rects(region);
+
+	rt_memset(bitmap, 0, CHECK_SIZE * CHECK_SIZE);
+	if (count == 0)
+	{
+		return RT_NULL;
+	}
+
+	box = rects[0];
+	for (index = 0; index < count; index ++)
+	{
+		if (rects[index].x1 >= rects[index].x2 || rects[index].y1 >= rects[index].y2)
+			return "empty rect";
+		if (rects[index].x1 < -CHECK_OFFSET || rects[index].y1 < -CHECK_OFFSET ||
+			rects[index].x2 > CHECK_SIZE - CHECK_OFFSET || rects[index].y2 > CHECK_SIZE - CHECK_OFFSET)
+			return "rect out of range";
+
+		if (index > 0)
+		{
+			prev = &rects[index - 1];
+			if (rects[index].y1 == prev->y1)
+			{
+				/* in the same band, the rects are sorted and not adjacent */
+				if (rects[index].y2 != prev->y2) return "band height mismatch";
+				if (rects[index].x1 <= prev->x2) return "band not coalesced";
+			}
+			else if (rects[index].y1 < prev->y2) return "bands overlapped";
+		}
+
+		if (rects[index].x1 < box.x1) box.x1 = rects[index].x1;
+		if (rects[index].y1 < box.y1) box.y1 = rects[index].y1;
+		if (rects[index].x2 > box.x2) box.x2 = rects[index].x2;
+		if (rects[index].y2 > box.y2) box.y2 = rects[index].y2;
+
+		for (y = rects[index].y1; y < rects[index].y2; y ++)
+		{
+			for (x = rects[index].x1; x < rects[index].x2; x ++)
+			{
+				if (CHECK_PIXEL(bitmap, x, y)) return "rects overlapped";
+				CHECK_PIXEL(bitmap, x, y) = 1;
+			}
+		}
+	}
+
+	if (rtgui_rect_is_equal(&box, rtgui_region_extents(region)) != RT_EOK)
+		return "extents mismatch";
+
+	return RT_NULL;
+}
+
+static const char* check_region(int index)
+{
+	const char* error;
+	rtgui_rect_t box, rect;
+	int point, x, y, in, out;
+
+	error = check_raster(&_check_region[index], _check_raster);
+	if (error != RT_NULL) return error;
+
+	if (rt_memcmp(_check_raster, _check_bitmap[index], CHECK_SIZE * CHECK_SIZE) != 0)
+		return "bitmap mismatch";
+
+	/* hit test with random points */
+	for (point = 0; point < 16; point ++)
+	{
+		x = bench_random() % CHECK_SIZE - CHECK_OFFSET;
+		y = bench_random() % CHECK_SIZE - CHECK_OFFSET;
+
+		if (rtgui_region_contains_point(&_check_region[index], x, y, &box) == RT_EOK)
+		{
+			if (!CHECK_PIXEL(_check_bitmap[index], x, y)) return "contains_point false positive";
+			if (rtgui_rect_contains_point(&box, x, y) != RT_EOK) return "contains_point box";
+		}
+		else if (CHECK_PIXEL(_check_bitmap[index], x, y)) return "contains_point false negative";
+	}
+
+	/* containment of a random rect */
+	check_random_rect(&rect);
+	in = out = 0;
+	for (y = rect.y1; y < rect.y2; y ++)
+	{
+		for (x = rect.x1; x < rect.x2; x ++)
+		{
+			if (CHECK_PIXEL(_check_bitmap[index], x, y)) in ++;
+			else out ++;
+		}
+	}
+	switch (rtgui_region_contains_rectangle(&_check_region[index], &rect))
+	{
+	case RTGUI_REGION_IN:
+		if (out != 0) return "contains_rectangle IN";
+		break;
+	case RTGUI_REGION_OUT:
+		if (in != 0) return "contains_rectangle OUT";
+		break;
+	default:
+		if (in == 0 || out == 0) return "contains_rectangle PART";
+		break;
+	}
+
+	return RT_NULL;
+}
+
+static void check_dump(int index)
+{
+	rtgui_rect_t *rects;
+	int count, i;
+
+	rects = rtgui_region_rects(&_check_region[index]);
+	count = rtgui_region_num_rects(&_check_region[index]);
+
+	rt_kprintf("region[%d]: %d rects\n", index, count);
+	for (i = 0; i < count; i ++)
+		rt_kprintf("  (%d, %d) - (%d, %d)\n", rects[i].x1, rects[i].y1, rects[i].x2, rects[i].y2);
+}
+
+/* run one random sequence, return RT_EOK if all of the steps are passed */
+static rt_err_t check_sequence(rt_uint32_t seed)
+{
+	int step, op, a, b, c, i, dx, dy;
+	rtgui_rect_t rect, *extents;
+	const char* error;
+
+	_random_seed = seed * 2654435761u + 1;
+	for (i = 0; i < CHECK_REGIONS; i ++)
+	{
+		rtgui_region_init(&_check_region[i]);
+		rt_memset(_check_bitmap[i], 0, CHECK_SIZE * CHECK_SIZE);
+	}
+
+	error = RT_NULL;
+	for (step = 0; step < REGION_CHECK_STEPS; step ++)
+	{
+		op = bench_random() % CHECK_OP_MAX;
+		a = bench_random() % CHECK_REGIONS;
+		b = bench_random() % CHECK_REGIONS;
+		c = bench_random() % CHECK_REGIONS;
+		check_random_rect(&rect);
+		check_bitmap_rect(_check_tmp, &rect);
+
+		switch (op)
+		{
+		case CHECK_UNION:
+			rtgui_region_union(&_check_region[c], &_check_region[a], &_check_region[b]);
+			for (i = 0; i < CHECK_SIZE * CHECK_SIZE; i ++)
+				_check_tmp[i] = _check_bitmap[a][i] | _check_bitmap[b][i];
+			break;
+		case CHECK_SUBTRACT:
+			rtgui_region_subtract(&_check_region[c], &_check_region[a], &_check_region[b]);
+			for (i = 0; i < CHECK_SIZE * CHECK_SIZE; i ++)
+				_check_tmp[i] = _check_bitmap[a][i] && !_check_bitmap[b][i];
+			break;
+		case CHECK_INTERSECT:
+			rtgui_region_intersect(&_check_region[c], &_check_region[a], &_check_region[b]);
+			for (i = 0; i < CHECK_SIZE * CHECK_SIZE; i ++)
+				_check_tmp[i] = _check_bitmap[a][i] & _check_bitmap[b][i];
+			break;
+		case CHECK_UNION_RECT:
+			rtgui_region_union_rect(&_check_region[c], &_check_region[a], &rect);
+			for (i = 0; i < CHECK_SIZE * CHECK_SIZE; i ++)
+				_check_tmp[i] = _check_bitmap[a][i] | _check_tmp[i];
+			break;
+		case CHECK_SUBTRACT_RECT:
+			rtgui_region_subtract_rect(&_check_region[c], &_check_region[a], &rect);
+			for (i = 0; i < CHECK_SIZE * CHECK_SIZE; i ++)
+				_check_tmp[i] = _check_bitmap[a][i] && !_check_tmp[i];
+			break;
+		case CHECK_INTERSECT_RECT:
+			rtgui_region_intersect_rect(&_check_region[c], &_check_region[a], &rect);
+			for (i = 0; i < CHECK_SIZE * CHECK_SIZE; i ++)
+				_check_tmp[i] = _check_bitmap[a][i] & _check_tmp[i];
+			break;
+		case CHECK_INVERSE:
+			rtgui_region_inverse(&_check_region[c], &_check_region[a], &rect);
+			for (i = 0; i < CHECK_SIZE * CHECK_SIZE; i ++)
+				_check_tmp[i] = !_check_bitmap[a][i] && _check_tmp[i];
+			break;
+		case CHECK_TRANSLATE:
+			/* keep the region in the range of bitmap */
+			c = a;
+			extents = rtgui_region_extents(&_check_region[a]);
+			dx = (int)(bench_random() % 33) - 16;
+			dy = (int)(bench_random() % 33) - 16;
+			if (extents->x1 + dx < -CHECK_OFFSET || extents->x2 + dx > CHECK_SIZE - CHECK_OFFSET) dx = 0;
+			if (extents->y1 + dy < -CHECK_OFFSET || extents->y2 + dy > CHECK_SIZE - CHECK_OFFSET) dy = 0;
+
+			rtgui_region_translate(&_check_region[a], dx, dy);
+			rt_memset(_check_tmp, 0, CHECK_SIZE * CHECK_SIZE);
+			for (i = 0; i < CHECK_SIZE * CHECK_SIZE; i ++)
+			{
+				int x = i % CHECK_SIZE + dx, y = i / CHECK_SIZE + dy;
+
+				if (_check_bitmap[a][i] && x >= 0 && x < CHECK_SIZE && y >= 0 && y < CHECK_SIZE)
+					_check_tmp[y * CHECK_SIZE + x] = 1;
+			}
+			break;
+		case CHECK_COPY:
+			rtgui_region_copy(&_check_region[c], &_check_region[a]);
+			rt_memcpy(_check_tmp, _check_bitmap[a], CHECK_SIZE * CHECK_SIZE);
+			break;
+		case CHECK_RESET:
+			rtgui_region_reset(&_check_region[c], &rect);
+			break;
+		case CHECK_EMPTY:
+			rtgui_region_empty(&_check_region[c]);
+			rt_memset(_check_tmp, 0, CHECK_SIZE * CHECK_SIZE);
+			break;
+		}
+		rt_memcpy(_check_bitmap[c], _check_tmp, CHECK_SIZE * CHECK_SIZE);
+
+		error = check_region(c);
+		if (error != RT_NULL)
+		{
+			rt_kprintf("region check failed: seed %u, step %d, %s(%d, %d) -> %d: %s\n",
+				seed, step, _check_op_name[op], a, b, c, error);
+			rt_kprintf("rect: (%d, %d) - (%d, %d)\n", rect.x1, rect.y1, rect.x2, rect.y2);
+			check_dump(c);
+			break;
+		}
+	}
+
+	for (i = 0; i < CHECK_REGIONS; i ++)
+		rtgui_region_fini(&_check_region[i]);
+
+	return error == RT_NULL? RT_EOK : -RT_ERROR;
+}
+
+static void check_run(void)
+{
+	rt_uint32_t seed, failed;
+
+	failed = 0;
+	for (seed = 0; seed < REGION_CHECK_SEEDS; seed ++)
+	{
+		if (check_sequence(seed) != RT_EOK) failed ++;
+	}
+
+	rt_kprintf("region check: %d sequences, %d steps, %d failed\n",
+		REGION_CHECK_SEEDS, REGION_CHECK_SEEDS * REGION_CHECK_STEPS, failed);
+}
+
+static void region_bench_entry(void* parameter)
+{
+	_bench_thread = rt_thread_self();
+#ifdef RTGUI_USING_HOOK
+	rtgui_malloc_sethook(bench_malloc_hook);
+	rtgui_free_sethook(bench_free_hook);
+#endif
+
+	bench_scene_init();
+	bench_run();
+	bench_scene_fini();
+
+	check_run();
+
+#ifdef RTGUI_USING_HOOK
+	rtgui_malloc_sethook(RT_NULL);
+	rtgui_free_sethook(RT_NULL);
+#endif
+	rt_kprintf("region_bench done\n");
+}
+
+int rt_application_init()
+{
+	rt_thread_t tid;
+
+	tid = rt_thread_create("rgn_bench", region_bench_entry, RT_NULL, 4096, 25, 10);
+	if (tid != RT_NULL)
+		rt_thread_startup(tid);
+
+	return 0;
+}
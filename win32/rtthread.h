@@ -227,6 +227,9 @@ rt_err_t rt_mb_control(rt_mailbox_t mb, rt_uint8_t cmd, void* arg);
 #define RT_TIMER_FLAG_ONE_SHOT		0x0	/* one shot timer. */
 #define RT_TIMER_FLAG_PERIODIC		0x2	/* periodic timer. */
 
+#define RT_TIMER_CTRL_SET_TIME		0x0	/* set timer. */
+#define RT_TIMER_CTRL_GET_TIME		0x1	/* get timer. */
+
 struct rt_timer
 {
 	char name[RT_NAME_MAX];	/* the name of thread.	*/
@@ -453,6 +456,8 @@ void* rt_realloc(void *ptr, rt_size_t size);
 void rt_free (void *ptr);
 void rt_assert(const char* str, int line);
 
+rt_tick_t rt_tick_get(void);
+
 #define RT_TICK_PER_SECOND  100
 
 #endif
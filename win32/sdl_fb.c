@@ -56,8 +56,7 @@ static rt_err_t  sdlfb_control(rt_device_t dev, rt_uint8_t cmd, void *args)
 		struct rt_device_rect_info *rect;
 		rect = (struct rt_device_rect_info*)args;
 
-		/* SDL_UpdateRect(_device.screen, rect->x, rect->y, rect->x + rect->w, rect->y + rect->h); */
-		SDL_UpdateRect(_device.screen, 0, 0, device->width, device->height);
+		SDL_UpdateRect(_device.screen, rect->x, rect->y, rect->width, rect->height);
 		}
 		break;
 	case RTGRAPHIC_CTRL_SET_MODE:
@@ -50,6 +50,7 @@ void rt_timer_init(rt_timer_t timer,
 	ht = (struct _host_timer*) rt_malloc(sizeof(struct _host_timer));
 	timer->host_timer = ht;
 
+	ht->id = RT_NULL;
 	ht->interval = time;
 }
 
@@ -116,5 +117,29 @@ rt_err_t rt_timer_stop(rt_timer_t timer)
 
 rt_err_t rt_timer_control(rt_timer_t timer, rt_uint8_t cmd, void* arg)
 {
-	return -RT_ERROR;
+	struct _host_timer* ht;
+
+	ht = (struct _host_timer*)timer->host_timer;
+	switch (cmd)
+	{
+	case RT_TIMER_CTRL_SET_TIME:
+		/* the new time takes effect on the next rt_timer_start */
+		ht->interval = *(rt_tick_t*)arg;
+		break;
+
+	case RT_TIMER_CTRL_GET_TIME:
+		*(rt_tick_t*)arg = ht->interval;
+		break;
+
+	default:
+		return -RT_ERROR;
+	}
+
+	return RT_EOK;
+}
+
+rt_tick_t rt_tick_get(void)
+{
+	/* 1 os tick = 10 milliseconds, the same as the timer interval */
+	return SDL_GetTicks() / 10;
 }